@@ -0,0 +1,375 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2011-2025 Blender Foundation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Reproducible CPU render benchmark for the Cycles standalone executable.
+
+Procedurally generates a set of XML scenes stressing different parts of Cycles (dense geometry
+instancing, many lights, volumes, hair, large textures), renders each of them and writes the
+statistics reported by `cycles --stats` to a single JSON file. Besides the `peak_memory` reported
+by Cycles, which only counts allocations of its guarded allocator, the peak resident memory of the
+process is stored as `peak_rss` where the platform supports measuring it.
+
+The scenes only depend on the arguments of this script, so results of different builds can be
+compared directly, for example:
+
+    cycles_benchmark.py --cycles ./bin/cycles --output /tmp/benchmark
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import random
+import statistics
+import subprocess
+import sys
+import time
+
+
+# Geometry helpers.
+
+def icosphere(subdivisions):
+    """Return vertices and triangles of a unit icosphere."""
+    t = (1.0 + math.sqrt(5.0)) / 2.0
+    verts = [
+        (-1, t, 0), (1, t, 0), (-1, -t, 0), (1, -t, 0),
+        (0, -1, t), (0, 1, t), (0, -1, -t), (0, 1, -t),
+        (t, 0, -1), (t, 0, 1), (-t, 0, -1), (-t, 0, 1),
+    ]
+    verts = [normalize(v) for v in verts]
+    tris = [
+        (0, 11, 5), (0, 5, 1), (0, 1, 7), (0, 7, 10), (0, 10, 11),
+        (1, 5, 9), (5, 11, 4), (11, 10, 2), (10, 7, 6), (7, 1, 8),
+        (3, 9, 4), (3, 4, 2), (3, 2, 6), (3, 6, 8), (3, 8, 9),
+        (4, 9, 5), (2, 4, 11), (6, 2, 10), (8, 6, 7), (9, 8, 1),
+    ]
+
+    for _ in range(subdivisions):
+        midpoints = {}
+
+        def midpoint(a, b):
+            key = (min(a, b), max(a, b))
+            if key not in midpoints:
+                va = verts[a]
+                vb = verts[b]
+                verts.append(normalize(((va[0] + vb[0]) / 2, (va[1] + vb[1]) / 2, (va[2] + vb[2]) / 2)))
+                midpoints[key] = len(verts) - 1
+            return midpoints[key]
+
+        new_tris = []
+        for a, b, c in tris:
+            ab = midpoint(a, b)
+            bc = midpoint(b, c)
+            ca = midpoint(c, a)
+            new_tris += [(a, ab, ca), (b, bc, ab), (c, ca, bc), (ab, bc, ca)]
+        tris = new_tris
+
+    return verts, tris
+
+
+def normalize(v):
+    length = math.sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2])
+    return (v[0] / length, v[1] / length, v[2] / length)
+
+
+def format_floats(values):
+    return " ".join("{:.5g}".format(value) for value in values)
+
+
+def mesh_xml(verts, faces, name=None):
+    P = format_floats([c for v in verts for c in v])
+    nverts = " ".join(str(len(f)) for f in faces)
+    indices = " ".join(str(i) for f in faces for i in f)
+    name_attr = ' name="{}"'.format(name) if name else ''
+    return '<mesh{} P="{}" nverts="{}" verts="{}" />\n'.format(name_attr, P, nverts, indices)
+
+
+def box_xml(size):
+    s = size
+    verts = [(-s, -s, -s), (s, -s, -s), (s, s, -s), (-s, s, -s),
+             (-s, -s, s), (s, -s, s), (s, s, s), (-s, s, s)]
+    faces = [(0, 3, 2, 1), (4, 5, 6, 7), (0, 1, 5, 4), (2, 3, 7, 6), (1, 2, 6, 5), (0, 4, 7, 3)]
+    return mesh_xml(verts, faces)
+
+
+def plane_xml(size, height):
+    verts = [(-size, height, -size), (size, height, -size), (size, height, size), (-size, height, size)]
+    return mesh_xml(verts, [(0, 1, 2, 3)])
+
+
+# Scene generation.
+
+def scene_header(args):
+    return (
+        '<cycles>\n'
+        '<camera width="{width}" height="{height}" />\n'
+        '<transform rotate="20 1 0 0">\n'
+        '  <transform translate="0 0 -12">\n'
+        '    <camera camera_type="perspective" fov="0.7" />\n'
+        '  </transform>\n'
+        '</transform>\n'
+        '<integrator max_bounce="8" />\n'
+        '<background>\n'
+        '  <background_shader name="bg" strength="0.5" color="0.6 0.7 0.9" />\n'
+        '  <connect from="bg background" to="output surface" />\n'
+        '</background>\n'
+        '<shader name="diffuse">\n'
+        '  <diffuse_bsdf name="bsdf" color="0.6 0.6 0.6" />\n'
+        '  <connect from="bsdf bsdf" to="output surface" />\n'
+        '</shader>\n'
+        '<state shader="diffuse">\n'
+        '  {floor}'
+        '</state>\n'
+    ).format(width=args.width, height=args.height, floor=plane_xml(20.0, -3.0))
+
+
+def scene_footer():
+    return '</cycles>\n'
+
+
+def generate_instancing(directory, rng):
+    """Many instances of a single small mesh, stressing BVH build and traversal."""
+    verts, tris = icosphere(3)
+
+    xml = '<shader name="plastic">\n'
+    xml += '  <principled_bsdf name="bsdf" base_color="0.8 0.3 0.2" roughness="0.3" />\n'
+    xml += '  <connect from="bsdf bsdf" to="output surface" />\n'
+    xml += '</shader>\n'
+    xml += '<state shader="plastic">\n'
+    for i in range(4000):
+        x = rng.uniform(-10.0, 10.0)
+        y = rng.uniform(-3.0, 3.0)
+        z = rng.uniform(-4.0, 12.0)
+        scale = rng.uniform(0.05, 0.25)
+        xml += '<transform translate="{} {} {}" scale="{s} {s} {s}">'.format(
+            format_floats([x]), format_floats([y]), format_floats([z]), s=format_floats([scale]))
+        # The first sphere defines the mesh, all others are objects instancing it.
+        if i == 0:
+            xml += mesh_xml(verts, tris, name="sphere")
+        else:
+            xml += '<instance geometry="sphere" />'
+        xml += '</transform>\n'
+    xml += '</state>\n'
+    return xml
+
+
+def generate_many_lights(directory, rng):
+    """Thousands of small point lights, stressing the light tree."""
+    verts, tris = icosphere(4)
+    xml = '<state shader="diffuse">\n'
+    xml += mesh_xml(verts, tris)
+    xml += '</state>\n'
+    xml += '<shader name="light">\n'
+    xml += '  <emission name="emission" color="1 1 1" strength="1" />\n'
+    xml += '  <connect from="emission emission" to="output surface" />\n'
+    xml += '</shader>\n'
+    xml += '<state shader="light">\n'
+    for _ in range(5000):
+        x = rng.uniform(-12.0, 12.0)
+        y = rng.uniform(-2.9, 4.0)
+        z = rng.uniform(-4.0, 16.0)
+        strength = [rng.uniform(0.0, 2.0) for _ in range(3)]
+        xml += '<transform translate="{}"><light light_type="point" strength="{}" size="0.02" /></transform>\n'.format(
+            format_floats([x, y, z]), format_floats(strength))
+    xml += '</state>\n'
+    return xml
+
+
+def generate_volume(directory, rng):
+    """Heterogeneous scattering volume."""
+    xml = '<shader name="smoke">\n'
+    xml += '  <noise_texture name="noise" scale="2.0" detail="6.0" />\n'
+    xml += '  <principled_volume name="volume" color="0.8 0.8 0.8" />\n'
+    xml += '  <connect from="noise fac" to="volume density" />\n'
+    xml += '  <connect from="volume volume" to="output volume" />\n'
+    xml += '</shader>\n'
+    xml += '<state shader="smoke">\n'
+    xml += box_xml(3.0)
+    xml += '</state>\n'
+    xml += '<transform translate="4 6 -4"><light light_type="point" strength="2000 2000 2000" size="0.5" /></transform>\n'
+    return xml
+
+
+def generate_hair(directory, rng):
+    """Dense curves on a plane, stressing curve intersection."""
+    xml = '<shader name="hair">\n'
+    xml += '  <principled_hair_bsdf name="bsdf" color="0.5 0.3 0.1" />\n'
+    xml += '  <connect from="bsdf bsdf" to="output surface" />\n'
+    xml += '</shader>\n'
+    xml += '<state shader="hair">\n'
+    num_curves = 100000
+    num_keys = 5
+    P = []
+    radius = []
+    for _ in range(num_curves):
+        x = rng.uniform(-6.0, 6.0)
+        z = rng.uniform(-4.0, 8.0)
+        bend = rng.uniform(-0.3, 0.3)
+        for k in range(num_keys):
+            t = k / (num_keys - 1)
+            P += [x + bend * t * t, -3.0 + 1.5 * t, z]
+            radius.append(0.01 * (1.0 - 0.8 * t))
+    xml += '<hair P="{}" radius="{}" nverts="{}" />\n'.format(
+        format_floats(P), format_floats(radius), " ".join([str(num_keys)] * num_curves))
+    xml += '</state>\n'
+    return xml
+
+
+def write_ppm(filepath, size, rng):
+    """Write a binary PPM image with a random pattern that does not compress well."""
+    row = bytes(rng.getrandbits(8) for _ in range(size * 3))
+    with open(filepath, "wb") as f:
+        f.write("P6\n{} {}\n255\n".format(size, size).encode())
+        for y in range(size):
+            shift = (y * 7) % (size * 3)
+            f.write(row[shift:] + row[:shift])
+
+
+def generate_textures(directory, rng):
+    """Large image textures, stressing texture loading and memory bandwidth."""
+    verts, tris = icosphere(4)
+    xml = ''
+    for i in range(8):
+        filename = "texture_{}.ppm".format(i)
+        write_ppm(os.path.join(directory, filename), 2048, rng)
+        xml += '<shader name="textured_{}">\n'.format(i)
+        xml += '  <texture_coordinate name="coord" />\n'
+        xml += '  <image_texture name="image" filename="{}" />\n'.format(filename)
+        xml += '  <diffuse_bsdf name="bsdf" />\n'
+        xml += '  <connect from="coord generated" to="image vector" />\n'
+        xml += '  <connect from="image color" to="bsdf color" />\n'
+        xml += '  <connect from="bsdf bsdf" to="output surface" />\n'
+        xml += '</shader>\n'
+        xml += '<state shader="textured_{}"><transform translate="{} 0 {}" scale="1.5 1.5 1.5">'.format(
+            i, format_floats([-7.5 + (i % 4) * 5.0]), format_floats([(i // 4) * 5.0]))
+        xml += mesh_xml(verts, tris)
+        xml += '</transform></state>\n'
+    return xml
+
+
+SCENES = {
+    "instancing": generate_instancing,
+    "many_lights": generate_many_lights,
+    "volume": generate_volume,
+    "hair": generate_hair,
+    "textures": generate_textures,
+}
+
+
+def generate_scene(name, directory, args):
+    filepath = os.path.join(directory, name + ".xml")
+    # Seed per scene, so scenes don't change when others are added or removed.
+    rng = random.Random("{}-{}".format(args.seed, name))
+    content = SCENES[name](directory, rng)
+    with open(filepath, "w") as f:
+        f.write(scene_header(args) + content + scene_footer())
+    return filepath
+
+
+# Running.
+
+def run_cycles(args, filepath, stats_filepath):
+    command = [
+        args.cycles,
+        "--background",
+        "--quiet",
+        "--device", "CPU",
+        "--samples", str(args.samples),
+        "--width", str(args.width),
+        "--height", str(args.height),
+        "--stats", stats_filepath,
+    ]
+    if args.threads:
+        command += ["--threads", str(args.threads)]
+    command.append(filepath)
+
+    start_time = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL)
+    peak_rss = None
+    if hasattr(os, "wait4"):
+        _, status, rusage = os.wait4(process.pid, 0)
+        returncode = os.waitstatus_to_exitcode(status)
+        # Kilobytes on Linux, bytes on macOS.
+        peak_rss = rusage.ru_maxrss if sys.platform == "darwin" else rusage.ru_maxrss * 1024
+    else:
+        returncode = process.wait()
+    wall_time = time.perf_counter() - start_time
+
+    if returncode != 0:
+        raise SystemExit("Cycles failed rendering {} with exit code {}".format(filepath, returncode))
+
+    with open(stats_filepath) as f:
+        stats = json.load(f)
+    stats["wall_time"] = wall_time
+    if peak_rss is not None:
+        stats["peak_rss"] = peak_rss
+    return stats
+
+
+def median_stats(runs):
+    """Combine repeated runs, taking the median of every numeric value."""
+    result = dict(runs[0])
+    for key, value in runs[0].items():
+        if isinstance(value, (int, float)):
+            result[key] = statistics.median(run[key] for run in runs)
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cycles standalone CPU benchmark")
+    parser.add_argument("--cycles", required=True, help="Path to the Cycles standalone executable")
+    parser.add_argument("--output", required=True, help="Directory for generated scenes and results")
+    parser.add_argument("--scenes", nargs="*", default=list(SCENES.keys()), choices=list(SCENES.keys()))
+    parser.add_argument("--samples", type=int, default=16)
+    parser.add_argument("--width", type=int, default=640)
+    parser.add_argument("--height", type=int, default=360)
+    parser.add_argument("--threads", type=int, default=0, help="Render threads, 0 for automatic")
+    parser.add_argument("--repeat", type=int, default=3, help="Runs per scene, the median is reported")
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    scenes_dir = os.path.join(args.output, "scenes")
+    os.makedirs(scenes_dir, exist_ok=True)
+
+    results = {
+        "platform": platform.platform(),
+        "processor": platform.processor(),
+        "samples": args.samples,
+        "width": args.width,
+        "height": args.height,
+        "repeat": args.repeat,
+        "seed": args.seed,
+        "scenes": {},
+    }
+
+    for name in args.scenes:
+        print("Generating {}...".format(name), flush=True)
+        filepath = generate_scene(name, scenes_dir, args)
+
+        runs = []
+        for i in range(args.repeat):
+            print("Rendering {} ({}/{})...".format(name, i + 1, args.repeat), flush=True)
+            stats_filepath = os.path.join(args.output, "{}_{}.json".format(name, i))
+            runs.append(run_cycles(args, filepath, stats_filepath))
+        results["scenes"][name] = median_stats(runs)
+
+    results_filepath = os.path.join(args.output, "results.json")
+    with open(results_filepath, "w") as f:
+        json.dump(results, f, indent=2)
+
+    print()
+    print("{:<14}{:>12}{:>12}{:>12}{:>14}".format("Scene", "Samples/s", "BVH (s)", "Sync (s)", "Peak (MB)"))
+    for name, stats in results["scenes"].items():
+        peak = stats.get("peak_rss", stats["peak_memory"]) / (1024.0 * 1024.0)
+        print("{:<14}{:>12.3f}{:>12.3f}{:>12.3f}{:>14.1f}".format(
+            name, stats["samples_per_second"], stats["bvh_build_time"], stats["scene_sync_time"], peak))
+    print()
+    print("Results written to {}".format(results_filepath))
+
+
+if __name__ == "__main__":
+    main()
@@ -8,16 +8,18 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
 #include "util/args.h"
+#include "util/guarded_allocator.h"
 #include "util/log.h"
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/string.h"
+#include "util/time.h"
 #ifdef WITH_CYCLES_STANDALONE_GUI
-#  include "util/time.h"
 #  include "util/transform.h"
 #endif
 #include "util/unique_ptr.h"
@@ -48,6 +50,8 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string stats_filepath;
+  double scene_load_time;
 } options;
 
 static void session_print(const string &str)
@@ -153,7 +157,13 @@ static void session_init()
 #endif
 
   /* load scene */
+  const double scene_load_start = time_dt();
   scene_init();
+  options.scene_load_time = time_dt() - scene_load_start;
+
+  if (!options.stats_filepath.empty()) {
+    options.scene->enable_update_stats();
+  }
 
   /* add pass for output. */
   Pass *pass = options.scene->create_node<Pass>();
@@ -164,8 +174,78 @@ static void session_init()
   options.session->start();
 }
 
+static string json_escape(const string &str)
+{
+  string result;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+/* Write statistics of the finished render as JSON, for benchmarking. */
+static void session_write_stats()
+{
+  Session &session = *options.session;
+
+  double total_time;
+  double render_time;
+  session.progress.get_time(total_time, render_time);
+
+  const int samples = session.progress.get_current_sample();
+  const double pixels = double(options.width) * double(options.height);
+
+  /* Scene synchronization includes everything done to prepare the render on the device, of
+   * which building the BVH is usually the most expensive part. */
+  double sync_time = 0.0;
+  double bvh_time = 0.0;
+  if (options.scene->update_stats) {
+    sync_time = options.scene->update_stats->scene.times.total_time;
+    for (const NamedTimeEntry &entry : options.scene->update_stats->geometry.times.entries) {
+      if (string_startswith(entry.name, "device_update (build")) {
+        bvh_time += entry.time;
+      }
+    }
+  }
+
+  string json = "{\n";
+  json += string_printf("  \"file\": \"%s\",\n", json_escape(options.filepath).c_str());
+  json += string_printf("  \"device\": \"%s\",\n",
+                        json_escape(session.params.device.description).c_str());
+  json += string_printf("  \"threads\": %d,\n", session.params.threads);
+  json += string_printf("  \"width\": %d,\n", options.width);
+  json += string_printf("  \"height\": %d,\n", options.height);
+  json += string_printf("  \"samples\": %d,\n", samples);
+  json += string_printf("  \"scene_load_time\": %f,\n", options.scene_load_time);
+  json += string_printf("  \"scene_sync_time\": %f,\n", sync_time);
+  json += string_printf("  \"bvh_build_time\": %f,\n", bvh_time);
+  json += string_printf("  \"render_time\": %f,\n", render_time);
+  json += string_printf("  \"total_time\": %f,\n", total_time);
+  json += string_printf("  \"samples_per_second\": %f,\n",
+                        (render_time > 0.0) ? samples / render_time : 0.0);
+  json += string_printf("  \"megapixel_samples_per_second\": %f,\n",
+                        (render_time > 0.0) ? samples * pixels * 1e-6 / render_time : 0.0);
+  /* Only counts allocations through the guarded allocator, which covers the scene and device
+   * data of Cycles but not the memory used by libraries. The benchmark script measures the peak
+   * resident memory of the process in addition. */
+  json += string_printf("  \"peak_memory\": %zu,\n", util_guarded_get_mem_peak());
+  json += string_printf("  \"peak_device_memory\": %zu\n", session.stats.mem_peak);
+  json += "}\n";
+
+  if (!path_write_text(options.stats_filepath, json)) {
+    fprintf(stderr, "Failed to write statistics to %s\n", options.stats_filepath.c_str());
+  }
+}
+
 static void session_exit()
 {
+  if (options.session && !options.stats_filepath.empty()) {
+    session_write_stats();
+  }
+
   if (options.session) {
     options.session.reset();
   }
@@ -441,6 +521,9 @@ static void options_parse(const int argc, const char **argv)
   });
   ap.arg("--list-devices", &list).help("List information about all available devices");
   ap.arg("--profile", &profile).help("Enable profile logging");
+  ap.arg("--stats %s:FILE")
+      .help("Write render time, scene sync time and peak memory as JSON to a file")
+      .action([&](auto argv) { parse_string(argv, &options.stats_filepath); });
   ap.arg("--log-level %s:LEVEL")
       .help("Log verbosity: fatal, error, warning, info, stats, debug")
       .action([&](auto argv) { parse_string(argv, &log_level); });
@@ -11,6 +11,8 @@
 #include "scene/background.h"
 #include "scene/camera.h"
 #include "scene/film.h"
+#include "scene/geometry_cache.h"
+#include "scene/hair.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
 #include "scene/mesh.h"
@@ -400,6 +402,12 @@ static void xml_read_mesh(const XMLReadState &state, const xml_node node)
   used_shaders.push_back_slow(state.shader);
   mesh->set_used_shaders(used_shaders);
 
+  /* Named meshes can be instanced by other objects. */
+  string name;
+  if (xml_read_string(&name, node, "name")) {
+    mesh->name = ustring(name);
+  }
+
   /* read state */
   const int shader = 0;
   const bool smooth = state.smooth;
@@ -600,6 +608,78 @@ static void xml_read_mesh(const XMLReadState &state, const xml_node node)
   }
 }
 
+/* Hair */
+
+static void xml_read_hair(const XMLReadState &state, const xml_node node)
+{
+  Scene *scene = state.scene;
+
+  /* Curve keys with one radius per key, and the number of keys per curve. */
+  vector<float3> P;
+  vector<float> radius;
+  vector<int> nverts;
+
+  xml_read_float3_array(P, node, "P");
+  xml_read_float_array(radius, node, "radius");
+  xml_read_int_array(nverts, node, "nverts");
+
+  size_t num_keys = 0;
+  for (const int num : nverts) {
+    if (num < 2) {
+      LOG_ERROR << "Hair curves need at least 2 keys";
+      return;
+    }
+    num_keys += num;
+  }
+  if (num_keys != P.size() || (!radius.empty() && radius.size() != P.size())) {
+    LOG_ERROR << "Hair key count does not match positions";
+    return;
+  }
+
+  Hair *hair = scene->create_node<Hair>();
+
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(state.shader);
+  hair->set_used_shaders(used_shaders);
+
+  Object *object = scene->create_node<Object>();
+  object->set_geometry(hair);
+  object->set_tfm(state.tfm);
+
+  hair->reserve_curves(nverts.size(), num_keys);
+
+  size_t key = 0;
+  for (const int num : nverts) {
+    hair->add_curve(key, 0);
+    for (int i = 0; i < num; i++, key++) {
+      hair->add_curve_key(P[key], radius.empty() ? 0.01f : radius[key]);
+    }
+  }
+}
+
+/* Instance */
+
+static void xml_read_instance(const XMLReadState &state, const xml_node node)
+{
+  string geometry_name;
+  if (!xml_read_string(&geometry_name, node, "geometry")) {
+    LOG_ERROR << "Instance without geometry";
+    return;
+  }
+
+  for (Geometry *geometry : state.scene->geometry) {
+    if (geometry->name == geometry_name) {
+      /* Add another object sharing the geometry, without copying it. */
+      Object *object = state.scene->create_node<Object>();
+      object->set_geometry(geometry);
+      object->set_tfm(state.tfm);
+      return;
+    }
+  }
+
+  LOG_ERROR << "Unknown geometry \"" << geometry_name << "\"";
+}
+
 /* Light */
 
 static void xml_read_light(XMLReadState &state, const xml_node node)
@@ -622,6 +702,25 @@ static void xml_read_light(XMLReadState &state, const xml_node node)
   xml_read_node(state, light, node);
 }
 
+/* Geometry Cache */
+
+static void xml_read_geometry_cache(XMLReadState &state, const xml_node node)
+{
+  GeometryCacheProcedural *procedural = state.scene->create_node<GeometryCacheProcedural>();
+  procedural->set_tfm(state.tfm);
+
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(state.shader);
+  procedural->set_used_shaders(used_shaders);
+
+  xml_read_node(state, procedural, node);
+
+  const string directory = procedural->get_directory().string();
+  if (path_is_relative(directory)) {
+    procedural->set_directory(ustring(path_join(state.base, directory)));
+  }
+}
+
 /* Transform */
 
 static void xml_read_transform(const xml_node node, Transform &tfm)
@@ -751,6 +850,15 @@ static void xml_read_scene(XMLReadState &state, const xml_node scene_node)
     else if (string_iequals(node.name(), "light")) {
       xml_read_light(state, node);
     }
+    else if (string_iequals(node.name(), "instance")) {
+      xml_read_instance(state, node);
+    }
+    else if (string_iequals(node.name(), "hair")) {
+      xml_read_hair(state, node);
+    }
+    else if (string_iequals(node.name(), "geometry_cache")) {
+      xml_read_geometry_cache(state, node);
+    }
     else if (string_iequals(node.name(), "transform")) {
       XMLReadState substate = state;
 
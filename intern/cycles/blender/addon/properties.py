@@ -1060,6 +1060,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=8,
         max=8192,
     )
+    use_out_of_core_buffers: BoolProperty(
+        name="Out-of-Core Buffers",
+        description="Denoise and finish the tiles cached on disk one at a time, instead of loading the full image into a Cycles render buffer. "
+        "Blender still stores the full image in the render result, so this only avoids the additional full-frame buffer of Cycles",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
@@ -13,7 +13,11 @@
 #include "blender/sync.h"
 #include "blender/util.h"
 
+#include "util/log.h"
+#include "util/map.h"
+#include "util/md5.h"
 #include "util/task.h"
+#include "util/time.h"
 
 #include "BKE_material.hh"
 #include "DNA_material_types.h"
@@ -286,4 +290,141 @@ void BlenderSync::sync_geometry_motion(BObjectInfo &b_ob_info,
   }
 }
 
+static bool mesh_can_be_deduplicated(const Mesh *mesh)
+{
+  /* Adaptive subdivision is diced per object, so the meshes can not be shared. */
+  return mesh->get_subdivision_type() == Mesh::SUBDIVISION_NONE && mesh->num_triangles() != 0;
+}
+
+static string mesh_content_hash(Mesh *mesh)
+{
+  MD5Hash md5;
+  mesh->hash(md5);
+
+  for (const Attribute &attr : mesh->attributes.attributes) {
+    md5.append(attr.name.string());
+    md5.append(reinterpret_cast<const uint8_t *>(&attr.std), sizeof(attr.std));
+    md5.append(reinterpret_cast<const uint8_t *>(&attr.element), sizeof(attr.element));
+    md5.append(attr.type.c_str());
+    md5.append(reinterpret_cast<const uint8_t *>(attr.buffer.data()), attr.buffer.size());
+  }
+
+  return md5.get_hex();
+}
+
+static bool mesh_content_equals(const Mesh *a, const Mesh *b)
+{
+  if (!a->equals(*b)) {
+    return false;
+  }
+
+  const list<Attribute> &attributes_a = a->attributes.attributes;
+  const list<Attribute> &attributes_b = b->attributes.attributes;
+  if (attributes_a.size() != attributes_b.size()) {
+    return false;
+  }
+
+  for (auto it_a = attributes_a.begin(), it_b = attributes_b.begin(); it_a != attributes_a.end();
+       ++it_a, ++it_b)
+  {
+    if (it_a->name != it_b->name || it_a->std != it_b->std || it_a->element != it_b->element ||
+        it_a->type != it_b->type || it_a->buffer.size() != it_b->buffer.size() ||
+        memcmp(it_a->buffer.data(), it_b->buffer.data(), it_a->buffer.size()) != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static size_t mesh_size_in_bytes(const Mesh *mesh)
+{
+  size_t size = mesh->get_total_size_in_bytes();
+  for (const Attribute &attr : mesh->attributes.attributes) {
+    size += attr.buffer.size();
+  }
+  return size;
+}
+
+void BlenderSync::deduplicate_geometry()
+{
+  /* Evaluated copies of the same mesh, for example realized instances or objects with identical
+   * modifier stacks, are synced to different meshes since their Blender data pointers differ.
+   * Find meshes with identical content and make all objects use the first one of them. */
+  vector<Mesh *> meshes;
+  for (const auto &it : geometry_map.key_to_scene_data()) {
+    Geometry *geom = it.second;
+    if (geom->is_mesh() && mesh_can_be_deduplicated(static_cast<Mesh *>(geom))) {
+      meshes.push_back(static_cast<Mesh *>(geom));
+    }
+  }
+
+  if (meshes.size() < 2) {
+    return;
+  }
+
+  const scoped_timer timer;
+
+  vector<string> hashes(meshes.size());
+  parallel_for(size_t(0), meshes.size(), [&](const size_t i) {
+    hashes[i] = mesh_content_hash(meshes[i]);
+  });
+
+  /* Full comparison guards against hash collisions. */
+  unordered_map<string, vector<Mesh *>> unique_meshes;
+  unordered_map<Geometry *, Geometry *> duplicates;
+  for (size_t i = 0; i < meshes.size(); i++) {
+    vector<Mesh *> &candidates = unique_meshes[hashes[i]];
+
+    Mesh *original = nullptr;
+    for (Mesh *candidate : candidates) {
+      if (mesh_content_equals(meshes[i], candidate)) {
+        original = candidate;
+        break;
+      }
+    }
+
+    if (original) {
+      duplicates[meshes[i]] = original;
+    }
+    else {
+      candidates.push_back(meshes[i]);
+    }
+  }
+
+  if (duplicates.empty()) {
+    return;
+  }
+
+  for (Object *object : scene->objects) {
+    auto it = duplicates.find(object->get_geometry());
+    if (it != duplicates.end()) {
+      object->set_geometry(it->second);
+    }
+  }
+
+  /* Free the data of the duplicates. They stay in the geometry map, tagged for a full sync on the
+   * next update, in case the mesh they were merged into changes or is removed. */
+  size_t saved_size = 0;
+  for (const auto &it : geometry_map.key_to_scene_data()) {
+    auto duplicate = duplicates.find(it.second);
+    if (duplicate == duplicates.end()) {
+      continue;
+    }
+
+    Mesh *mesh = static_cast<Mesh *>(duplicate->first);
+    saved_size += mesh_size_in_bytes(mesh);
+
+    mesh->clear(true);
+    mesh->tag_update(scene, true);
+
+    geometry_map.set_recalc(it.first.id);
+  }
+
+  LOG_INFO << "Deduplicated " << duplicates.size() << " of " << meshes.size() << " meshes in "
+           << timer.get_time() << " seconds, saving " << string_human_readable_size(saved_size)
+           << " of geometry data.";
+}
+
 CCL_NAMESPACE_END
@@ -330,6 +330,11 @@ void BlenderSync::sync_data(blender::RenderData &b_render,
   }
   sync_motion(b_render, b_depsgraph, b_screen, b_v3d, b_rv3d, width, height, python_thread_state);
 
+  /* Only for final renders: in the viewport the duplicates would be re-synced on every update. */
+  if (background && !b_bake_target && !progress.get_cancel()) {
+    deduplicate_geometry();
+  }
+
   geometry_synced.clear();
 
   /* Shader sync done at the end, since object sync uses it.
@@ -1067,9 +1072,11 @@ SessionParams BlenderSync::get_session_params(blender::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = true;
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_out_of_core_buffers = get_boolean(cscene, "use_out_of_core_buffers");
   }
   else {
     params.use_auto_tile = false;
+    params.use_out_of_core_buffers = false;
   }
 
   return params;
@@ -215,6 +215,10 @@ class BlenderSync {
                             bool use_particle_hair,
                             TaskPool *task_pool);
 
+  /* Make objects with meshes of identical content share a single mesh, so that the data is
+   * stored and its BVH is built only once. */
+  void deduplicate_geometry();
+
   /* Light */
   void sync_light(BObjectInfo &b_ob_info, Light *light);
   void sync_background_light(blender::bScreen *b_screen, blender::View3D *b_v3d);
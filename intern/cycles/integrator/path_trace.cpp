@@ -1047,19 +1047,19 @@ bool PathTrace::copy_render_tile_from_device()
   return success;
 }
 
-static string get_layer_view_name(const RenderBuffers &buffers)
+static string get_layer_view_name(const BufferParams &params)
 {
   string result;
 
-  if (!buffers.params.layer.empty()) {
-    result += string(buffers.params.layer);
+  if (!params.layer.empty()) {
+    result += string(params.layer);
   }
 
-  if (!buffers.params.view.empty()) {
+  if (!params.view.empty()) {
     if (!result.empty()) {
       result += ", ";
     }
-    result += string(buffers.params.view);
+    result += string(params.view);
   }
 
   return result;
@@ -1086,7 +1086,7 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  const string layer_view_name = get_layer_view_name(full_frame_buffers.params);
 
   render_state_.has_denoised_result = false;
 
@@ -1121,6 +1121,83 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+void PathTrace::process_full_buffer_from_disk_tiled(string_view filename, const int2 tile_size)
+{
+  LOG_DEBUG << "Processing full frame buffer file " << filename << " in tiles of " << tile_size;
+
+  /* Number of pixels read around every tile, giving the denoiser context across tile borders. */
+  const int overlap = 64;
+
+  progress_set_status("Reading full buffer from disk");
+
+  BufferParams full_buffer_params;
+  DenoiseParams denoise_params;
+  if (!tile_manager_.open_full_buffer_from_disk(filename, &full_buffer_params, &denoise_params)) {
+    const string error_message = "Error reading tiles from file";
+    if (progress_) {
+      progress_->set_error(error_message);
+      progress_->set_cancel(error_message);
+    }
+    else {
+      LOG_ERROR << error_message;
+    }
+    return;
+  }
+
+  const string layer_view_name = get_layer_view_name(full_buffer_params);
+
+  const bool use_denoise = denoise_params.use && denoiser_;
+  if (use_denoise) {
+    denoise_params.use_gpu = render_scheduler_.is_denoiser_gpu_used();
+    set_denoiser_params(denoise_params);
+  }
+
+  const int num_tiles = tile_manager_.get_num_full_buffer_tiles(tile_size);
+
+  RenderBuffers tile_buffers(cpu_device_.get());
+
+  for (int tile_index = 0; tile_index < num_tiles; ++tile_index) {
+    if (progress_ && progress_->get_cancel()) {
+      break;
+    }
+
+    const Tile tile = tile_manager_.get_full_buffer_tile(tile_size, overlap, tile_index);
+
+    progress_set_status(layer_view_name,
+                        string_printf("Finishing tile %d/%d", tile_index + 1, num_tiles));
+
+    if (!tile_manager_.read_full_buffer_tile_from_disk(tile, &tile_buffers)) {
+      const string error_message = "Error reading tiles from file";
+      if (progress_) {
+        progress_->set_error(error_message);
+        progress_->set_cancel(error_message);
+      }
+      else {
+        LOG_ERROR << error_message;
+      }
+      break;
+    }
+
+    render_state_.has_denoised_result = false;
+
+    if (use_denoise) {
+      denoiser_->denoise_buffer(tile_buffers.params, &tile_buffers, 0, false);
+      render_state_.has_denoised_result = true;
+    }
+
+    full_frame_state_.render_buffers = &tile_buffers;
+    full_frame_state_.render_tile_offset = make_int2(tile.x + tile.window_x,
+                                                     tile.y + tile.window_y);
+
+    tile_buffer_write();
+
+    full_frame_state_.render_buffers = nullptr;
+    full_frame_state_.render_tile_offset = make_int2(0, 0);
+  }
+
+  tile_manager_.close_full_buffer_from_disk();
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -1191,7 +1268,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.render_tile_offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
@@ -140,6 +140,14 @@ class PathTrace {
    * via the write callback. */
   void process_full_buffer_from_disk(string_view filename);
 
+  /* Same as above, but the full-frame buffer is never loaded into memory as a whole: it is read,
+   * denoised and written to the software one tile of the given size at a time. Tiles are read with
+   * an overlap with their neighbors, so that the denoiser has enough context at the tile borders.
+   *
+   * The render buffers of this call are proportional to the tile size rather than the image size.
+   * The output driver may still hold the full frame, like the render result in Blender does. */
+  void process_full_buffer_from_disk_tiled(string_view filename, const int2 tile_size);
+
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
@@ -356,6 +364,9 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+
+    /* Offset of the render buffers window within the full frame. */
+    int2 render_tile_offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
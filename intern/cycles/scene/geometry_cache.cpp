@@ -0,0 +1,942 @@
+/* SPDX-FileCopyrightText: 2011-2025 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "scene/geometry_cache.h"
+#include "scene/camera.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/pointcloud.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+
+#include "util/hash.h"
+#include "util/log.h"
+#include "util/map.h"
+#include "util/path.h"
+#include "util/progress.h"
+#include "util/string.h"
+#include "util/unique_ptr.h"
+#include "util/vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <json.hpp>
+
+CCL_NAMESPACE_BEGIN
+
+/* Version of the bake format written by Blender that can be read. */
+static constexpr int bake_file_version = 3;
+
+/* Limit the nesting of instances, to protect against malformed files. */
+static constexpr int max_instance_depth = 32;
+
+/* Meta Files
+ *
+ * Meta files are parsed with nlohmann::json. The ordered variant keeps items in the order they
+ * were written by Blender. Lookups return null or a default value for missing keys and values of
+ * unexpected types instead of throwing. */
+
+using JsonValue = nlohmann::ordered_json;
+using JsonType = JsonValue::value_t;
+
+static const JsonValue *json_find(const JsonValue &value, const char *key, const JsonType type)
+{
+  if (!value.is_object()) {
+    return nullptr;
+  }
+  const auto it = value.find(key);
+  return (it != value.end() && it->type() == type) ? &*it : nullptr;
+}
+
+/* Integers that don't fit into 64 bit and numbers with a fraction are treated as missing. */
+static int64_t json_find_int(const JsonValue &value, const char *key, const int64_t default_value)
+{
+  if (!value.is_object()) {
+    return default_value;
+  }
+  const auto it = value.find(key);
+  if (it == value.end()) {
+    return default_value;
+  }
+  if (it->is_number_unsigned()) {
+    const uint64_t number = it->get<uint64_t>();
+    return (number <= uint64_t(std::numeric_limits<int64_t>::max())) ? int64_t(number) :
+                                                                       default_value;
+  }
+  if (it->is_number_integer()) {
+    return it->get<int64_t>();
+  }
+  return default_value;
+}
+
+static bool json_find_str_equals(const JsonValue &value, const char *key, const char *str)
+{
+  const JsonValue *string_value = json_find(value, key, JsonType::string);
+  return string_value && string_value->get_ref<const string &>() == str;
+}
+
+/* Blobs
+ *
+ * Reads byte ranges from the files in the `blobs` folder of the bake. Files stay open while the
+ * frame is loaded since many attributes are usually stored in the same file. */
+
+class BakeBlobReader {
+ public:
+  explicit BakeBlobReader(string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
+
+  ~BakeBlobReader()
+  {
+    for (const auto &it : files_) {
+      if (it.second) {
+        fclose(it.second);
+      }
+    }
+  }
+
+  /* Read a slice as written by Blender: a dictionary with the blob name, the start offset and
+   * the size in bytes. Fails if the size does not match the expected size. */
+  bool read(const JsonValue &io_slice, const size_t size, void *r_data)
+  {
+    const JsonValue *io_name = json_find(io_slice, "name", JsonType::string);
+    const int64_t start = json_find_int(io_slice, "start", -1);
+    const int64_t slice_size = json_find_int(io_slice, "size", -1);
+    if (!io_name || start < 0 || slice_size != int64_t(size)) {
+      return false;
+    }
+    if (size == 0) {
+      return true;
+    }
+
+    /* Guard against names escaping the blobs folder. */
+    const string &name = io_name->get_ref<const string &>();
+    if (name.find("..") != string::npos) {
+      return false;
+    }
+
+    FILE *&file = files_[name];
+    if (file == nullptr) {
+      file = path_fopen(path_join(blobs_dir_, name), "rb");
+      if (file == nullptr) {
+        return false;
+      }
+    }
+
+#ifdef _WIN32
+    if (_fseeki64(file, start, SEEK_SET) != 0) {
+#else
+    if (fseeko(file, off_t(start), SEEK_SET) != 0) {
+#endif
+      return false;
+    }
+    return fread(r_data, 1, size, file) == size;
+  }
+
+ private:
+  string blobs_dir_;
+  map<string, FILE *> files_;
+};
+
+/* Bake Frames */
+
+/* Meta-data of an item or component at one point in time. Times between two baked frames are
+ * represented by the data of both frames and an interpolation factor. */
+struct BakeSample {
+  const JsonValue *a = nullptr;
+  const JsonValue *b = nullptr;
+  float factor = 0.0f;
+
+  BakeSample lookup(const char *key, const JsonType type) const
+  {
+    BakeSample sample;
+    sample.a = (a) ? json_find(*a, key, type) : nullptr;
+    sample.b = (b) ? json_find(*b, key, type) : nullptr;
+    sample.factor = factor;
+    return sample;
+  }
+};
+
+/* Meta files of the bake, parsed on demand. */
+class BakeMetaFiles {
+ public:
+  explicit BakeMetaFiles(string meta_dir) : meta_dir_(std::move(meta_dir)) {}
+
+  /* Items of the given baked frame, or null when the frame was not baked. */
+  const JsonValue *items(const int frame)
+  {
+    auto it = frames_.find(frame);
+    if (it == frames_.end()) {
+      it = frames_.emplace(frame, load(frame)).first;
+    }
+    return (it->second) ? json_find(*it->second, "items", JsonType::object) : nullptr;
+  }
+
+  BakeSample sample(const float time)
+  {
+    const float frame_floor = floorf(time);
+    BakeSample sample;
+    sample.a = items(int(frame_floor));
+    sample.factor = time - frame_floor;
+    if (sample.factor > 0.0f) {
+      sample.b = items(int(frame_floor) + 1);
+      if (sample.a == nullptr) {
+        std::swap(sample.a, sample.b);
+      }
+    }
+    return sample;
+  }
+
+ private:
+  unique_ptr<JsonValue> load(const int frame) const
+  {
+    /* Match the file naming of `frame_to_file_name` in Blender. */
+    string file_name = string_printf("%011.5f", double(frame));
+    string_replace(file_name, ".", "_");
+    const string filepath = path_join(meta_dir_, file_name + ".json");
+
+    string text;
+    if (!path_read_text(filepath, text)) {
+      return nullptr;
+    }
+
+    unique_ptr<JsonValue> root = make_unique<JsonValue>(JsonValue::parse(text, nullptr, false));
+    if (root->is_discarded() || json_find_int(*root, "version", -1) != bake_file_version) {
+      LOG_WARNING << "Failed to read geometry cache meta file " << filepath;
+      return nullptr;
+    }
+    return root;
+  }
+
+  string meta_dir_;
+  map<int, unique_ptr<JsonValue>> frames_;
+};
+
+/* Culling
+ *
+ * Camera frustum culling of the baked components, following the camera culling of Blender
+ * objects. Components are tested with the bounds of their positions before anything else is
+ * read, so geometry only used outside of the view is never loaded. Motion blur and the radius of
+ * points are not taken into account, the margin is expected to cover them. */
+
+class GeometryCacheCulling {
+ public:
+  GeometryCacheCulling(const ProjectionTransform &worldtondc, const float margin)
+      : worldtondc_(worldtondc), margin_(margin)
+  {
+  }
+
+  bool test(const BoundBox &bounds, const Transform &tfm) const
+  {
+    float3 ndc_min = make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    float3 ndc_max = make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    bool all_behind = true;
+    for (int i = 0; i < 8; i++) {
+      const float3 corner = make_float3((i & 1) ? bounds.min.x : bounds.max.x,
+                                        (i & 2) ? bounds.min.y : bounds.max.y,
+                                        (i & 4) ? bounds.min.z : bounds.max.z);
+      const float4 b = make_float4(transform_point(&tfm, corner), 1.0f);
+      const float4 c = make_float4(dot(worldtondc_.x, b),
+                                   dot(worldtondc_.y, b),
+                                   dot(worldtondc_.z, b),
+                                   dot(worldtondc_.w, b));
+      float3 p = make_float3(c / c.w);
+      if (c.z < 0.0f) {
+        p.x = 1.0f - p.x;
+        p.y = 1.0f - p.y;
+      }
+      if (c.z >= -margin_) {
+        all_behind = false;
+      }
+      ndc_min = min(ndc_min, p);
+      ndc_max = max(ndc_max, p);
+    }
+    if (all_behind) {
+      return true;
+    }
+    return (ndc_min.x >= 1.0f + margin_ || ndc_min.y >= 1.0f + margin_ ||
+            ndc_max.x <= -margin_ || ndc_max.y <= -margin_);
+  }
+
+ private:
+  ProjectionTransform worldtondc_;
+  float margin_;
+};
+
+/* Loader
+ *
+ * Creates Cycles nodes from the baked geometry of one frame and its motion steps. Geometries are
+ * shared by all objects instancing the same baked component. */
+
+class GeometryCacheLoader {
+ public:
+  GeometryCacheLoader(Scene *scene,
+                      NodeOwner *owner,
+                      BakeBlobReader &blob_reader,
+                      const array<Node *> &used_shaders,
+                      const uint visibility,
+                      const GeometryCacheCulling *culling,
+                      set<Geometry *> &geometries,
+                      set<Object *> &objects)
+      : scene_(scene),
+        owner_(owner),
+        blob_reader_(blob_reader),
+        used_shaders_(used_shaders),
+        visibility_(visibility),
+        culling_(culling),
+        geometries_(geometries),
+        objects_(objects)
+  {
+  }
+
+  /* Load a geometry set, with one sample and transform per motion step. */
+  void load_geometry(const vector<BakeSample> &samples,
+                     const vector<Transform> &tfms,
+                     const int depth = 0)
+  {
+    const size_t center = samples.size() / 2;
+    if (samples[center].a == nullptr) {
+      return;
+    }
+
+    const vector<BakeSample> mesh_samples = lookup(samples, "mesh");
+    if (mesh_samples[center].a && is_visible(mesh_samples[center], "num_vertices", tfms)) {
+      if (Geometry *geom = geometry_for_component(mesh_samples, &GeometryCacheLoader::load_mesh))
+      {
+        add_object(geom, tfms);
+      }
+    }
+
+    const vector<BakeSample> pointcloud_samples = lookup(samples, "pointcloud");
+    if (pointcloud_samples[center].a &&
+        is_visible(pointcloud_samples[center], "num_points", tfms))
+    {
+      if (Geometry *geom = geometry_for_component(pointcloud_samples,
+                                                  &GeometryCacheLoader::load_pointcloud))
+      {
+        add_object(geom, tfms);
+      }
+    }
+
+    const vector<BakeSample> instances_samples = lookup(samples, "instances");
+    if (instances_samples[center].a && depth < max_instance_depth) {
+      load_instances(instances_samples, tfms, depth);
+    }
+  }
+
+ private:
+  using LoadComponentFn = Geometry *(GeometryCacheLoader::*)(const vector<BakeSample> &samples);
+
+  static vector<BakeSample> lookup(const vector<BakeSample> &samples, const char *key)
+  {
+    vector<BakeSample> result(samples.size());
+    for (size_t step = 0; step < samples.size(); step++) {
+      result[step] = samples[step].lookup(key, JsonType::object);
+    }
+    return result;
+  }
+
+  /* Instance references are stored once in the meta file, so the component dictionary is a
+   * stable key to share geometry between all instances of it. */
+  Geometry *geometry_for_component(const vector<BakeSample> &samples, LoadComponentFn load_fn)
+  {
+    const JsonValue *key = samples[samples.size() / 2].a;
+    auto it = geometry_map_.find(key);
+    if (it == geometry_map_.end()) {
+      it = geometry_map_.emplace(key, (this->*load_fn)(samples)).first;
+    }
+    return it->second;
+  }
+
+  /* Positions of the center sample of a component, which are read first to test the visibility
+   * of the component. Ownership is given to the caller. */
+  bool take_center_positions(const BakeSample &sample,
+                             const char *size_key,
+                             array<float3> &r_positions)
+  {
+    auto it = center_positions_.find(sample.a);
+    if (it == center_positions_.end()) {
+      return read_positions(sample, size_key, r_positions);
+    }
+    r_positions.steal_data(it->second);
+    center_positions_.erase(it);
+    return true;
+  }
+
+  bool is_visible(const BakeSample &sample, const char *size_key, const vector<Transform> &tfms)
+  {
+    if (culling_ == nullptr) {
+      return true;
+    }
+
+    auto it = bounds_.find(sample.a);
+    if (it == bounds_.end()) {
+      BoundBox bounds = BoundBox::empty;
+      array<float3> &positions = center_positions_[sample.a];
+      if (read_positions(sample, size_key, positions)) {
+        for (const float3 &position : positions) {
+          bounds.grow_safe(position);
+        }
+      }
+      else {
+        center_positions_.erase(sample.a);
+      }
+      it = bounds_.emplace(sample.a, bounds).first;
+    }
+
+    /* Components without valid positions fail to load later on. */
+    return !it->second.valid() || !culling_->test(it->second, tfms[tfms.size() / 2]);
+  }
+
+  template<typename T> T *create_geometry()
+  {
+    T *geom = scene_->create_node<T>();
+    geom->set_owner(owner_);
+
+    array<Node *> used_shaders = used_shaders_;
+    if (used_shaders.empty()) {
+      used_shaders.push_back_slow(scene_->default_surface);
+    }
+    geom->set_used_shaders(used_shaders);
+
+    geometries_.insert(geom);
+    return geom;
+  }
+
+  void add_object(Geometry *geom, const vector<Transform> &tfms)
+  {
+    Object *object = scene_->create_node<Object>();
+    object->set_owner(owner_);
+    object->set_geometry(geom);
+    object->set_tfm(tfms[tfms.size() / 2]);
+    object->set_visibility(visibility_);
+    object->set_random_id(hash_uint(uint(objects_.size())));
+
+    for (const Transform &tfm : tfms) {
+      if (tfm != object->get_tfm()) {
+        array<Transform> motion;
+        motion = tfms;
+        object->set_motion(motion);
+        break;
+      }
+    }
+
+    objects_.insert(object);
+  }
+
+  const JsonValue *find_attribute(const JsonValue &io_component,
+                                  const char *name,
+                                  const char *domain,
+                                  const char *type) const
+  {
+    const JsonValue *io_attributes = json_find(io_component, "attributes", JsonType::array);
+    if (io_attributes == nullptr) {
+      return nullptr;
+    }
+    for (const JsonValue &io_attribute : *io_attributes) {
+      if (json_find_str_equals(io_attribute, "name", name)) {
+        if (json_find_str_equals(io_attribute, "domain", domain) &&
+            json_find_str_equals(io_attribute, "type", type))
+        {
+          return &io_attribute;
+        }
+        return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  /* Read an attribute with the given element size, expanding single value storage. */
+  bool read_attribute(const JsonValue &io_attribute,
+                      const size_t element_size,
+                      const size_t num,
+                      void *r_data)
+  {
+    const JsonValue *io_data = json_find(io_attribute, "data", JsonType::object);
+    if (io_data == nullptr) {
+      return false;
+    }
+    if (json_find_str_equals(io_attribute, "storage_type", "SINGLE")) {
+      if (!blob_reader_.read(*io_data, element_size, r_data)) {
+        return false;
+      }
+      for (size_t i = 1; i < num; i++) {
+        memcpy(static_cast<char *>(r_data) + i * element_size, r_data, element_size);
+      }
+      return true;
+    }
+    return blob_reader_.read(*io_data, element_size * num, r_data);
+  }
+
+  template<typename T>
+  bool read_attribute(const JsonValue &io_component,
+                      const char *name,
+                      const char *domain,
+                      const char *type,
+                      vector<T> &r_data)
+  {
+    const JsonValue *io_attribute = find_attribute(io_component, name, domain, type);
+    return io_attribute && read_attribute(*io_attribute, sizeof(T), r_data.size(), r_data.data());
+  }
+
+  /* Read positions of a sample, interpolating between frames when the sizes match. */
+  bool read_positions(const BakeSample &sample, const char *size_key, array<float3> &r_positions)
+  {
+    const int64_t num = json_find_int(*sample.a, size_key, 0);
+    if (num < 0) {
+      return false;
+    }
+    vector<packed_float3> positions(num);
+    if (!read_attribute(*sample.a, "position", "POINT", "FLOAT_VECTOR", positions)) {
+      return false;
+    }
+
+    r_positions.resize(num);
+    for (int64_t i = 0; i < num; i++) {
+      r_positions[i] = positions[i];
+    }
+
+    if (sample.b && sample.factor > 0.0f && json_find_int(*sample.b, size_key, 0) == num) {
+      if (read_attribute(*sample.b, "position", "POINT", "FLOAT_VECTOR", positions)) {
+        for (int64_t i = 0; i < num; i++) {
+          r_positions[i] = interp(r_positions[i], float3(positions[i]), sample.factor);
+        }
+      }
+    }
+    return true;
+  }
+
+  /* Positions of all motion steps except the center one, in the order of the motion attribute.
+   * Steps with missing or mismatching data use the center positions. Returns false if there is
+   * no motion at all. */
+  bool read_motion_positions(const vector<BakeSample> &samples,
+                             const char *size_key,
+                             const array<float3> &center_positions,
+                             vector<array<float3>> &r_motion)
+  {
+    const size_t center = samples.size() / 2;
+    const int64_t num = center_positions.size();
+    bool have_motion = false;
+
+    for (size_t step = 0; step < samples.size(); step++) {
+      if (step == center) {
+        continue;
+      }
+      r_motion.emplace_back();
+      array<float3> &positions = r_motion.back();
+      const BakeSample &sample = samples[step];
+      if (sample.a && json_find_int(*sample.a, size_key, 0) == num &&
+          read_positions(sample, size_key, positions))
+      {
+        have_motion |= positions != center_positions;
+      }
+      else {
+        positions = center_positions;
+      }
+    }
+
+    return have_motion;
+  }
+
+  Geometry *load_mesh(const vector<BakeSample> &samples)
+  {
+    const BakeSample &sample = samples[samples.size() / 2];
+    const JsonValue &io_mesh = *sample.a;
+    const int64_t verts_num = json_find_int(io_mesh, "num_vertices", 0);
+    const int64_t faces_num = json_find_int(io_mesh, "num_polygons", 0);
+    const int64_t corners_num = json_find_int(io_mesh, "num_corners", 0);
+    if (verts_num <= 0 || faces_num <= 0 || corners_num <= 0) {
+      return nullptr;
+    }
+
+    /* Topology. */
+    vector<int> face_offsets(faces_num + 1);
+    const JsonValue *io_face_offsets = json_find(io_mesh, "poly_offsets", JsonType::object);
+    if (!io_face_offsets ||
+        !blob_reader_.read(
+            *io_face_offsets, sizeof(int) * face_offsets.size(), face_offsets.data()))
+    {
+      return nullptr;
+    }
+    vector<int> corner_verts(corners_num);
+    if (!read_attribute(io_mesh, ".corner_vert", "CORNER", "INT", corner_verts)) {
+      return nullptr;
+    }
+
+    size_t num_triangles = 0;
+    for (int64_t i = 0; i < faces_num; i++) {
+      const int start = face_offsets[i];
+      const int end = face_offsets[i + 1];
+      if (start < 0 || end < start || end > corners_num) {
+        return nullptr;
+      }
+      num_triangles += max(end - start - 2, 0);
+    }
+    for (const int vert : corner_verts) {
+      if (vert < 0 || vert >= verts_num) {
+        return nullptr;
+      }
+    }
+
+    /* Optional shading attributes, missing ones use Blender's defaults. */
+    vector<int> material_index(faces_num, 0);
+    if (!read_attribute(io_mesh, "material_index", "FACE", "INT", material_index)) {
+      std::fill(material_index.begin(), material_index.end(), 0);
+    }
+    vector<uint8_t> sharp_face(faces_num, 0);
+    if (!read_attribute(io_mesh, "sharp_face", "FACE", "BOOLEAN", sharp_face)) {
+      std::fill(sharp_face.begin(), sharp_face.end(), 0);
+    }
+
+    array<float3> positions;
+    if (!take_center_positions(sample, "num_vertices", positions)) {
+      return nullptr;
+    }
+
+    Mesh *mesh = create_geometry<Mesh>();
+    const int max_shader = int(mesh->get_used_shaders().size()) - 1;
+
+    mesh->set_verts(positions);
+    mesh->reserve_mesh(verts_num, num_triangles);
+
+    /* Fan triangulation, as for the XML meshes. */
+    for (int64_t i = 0; i < faces_num; i++) {
+      const int start = face_offsets[i];
+      const int size = face_offsets[i + 1] - start;
+      const int shader = clamp(material_index[i], 0, max_shader);
+      const bool smooth = !sharp_face[i];
+      for (int j = 0; j < size - 2; j++) {
+        mesh->add_triangle(corner_verts[start],
+                           corner_verts[start + j + 1],
+                           corner_verts[start + j + 2],
+                           shader,
+                           smooth);
+      }
+    }
+
+    vector<array<float3>> motion;
+    if (samples.size() > 1 &&
+        read_motion_positions(samples, "num_vertices", mesh->get_verts(), motion))
+    {
+      mesh->set_motion_steps(samples.size());
+      mesh->set_use_motion_blur(true);
+      Attribute *attr_mP = mesh->attributes.add(ATTR_STD_MOTION_VERTEX_POSITION);
+      for (size_t step = 0; step < motion.size(); step++) {
+        float3 *mP = attr_mP->data_float3() + step * verts_num;
+        std::copy(motion[step].begin(), motion[step].end(), mP);
+      }
+    }
+
+    return mesh;
+  }
+
+  Geometry *load_pointcloud(const vector<BakeSample> &samples)
+  {
+    const BakeSample &sample = samples[samples.size() / 2];
+    const JsonValue &io_pointcloud = *sample.a;
+    const int64_t points_num = json_find_int(io_pointcloud, "num_points", 0);
+    if (points_num <= 0) {
+      return nullptr;
+    }
+
+    array<float3> positions;
+    if (!take_center_positions(sample, "num_points", positions)) {
+      return nullptr;
+    }
+    /* Default radius of point clouds in Blender. */
+    vector<float> radius(points_num, 0.01f);
+    if (!read_attribute(io_pointcloud, "radius", "POINT", "FLOAT", radius)) {
+      std::fill(radius.begin(), radius.end(), 0.01f);
+    }
+
+    PointCloud *pointcloud = create_geometry<PointCloud>();
+    pointcloud->reserve(points_num);
+    for (int64_t i = 0; i < points_num; i++) {
+      pointcloud->add_point(positions[i], radius[i]);
+    }
+
+    vector<array<float3>> motion;
+    if (samples.size() > 1 && read_motion_positions(samples, "num_points", positions, motion)) {
+      pointcloud->set_motion_steps(samples.size());
+      pointcloud->set_use_motion_blur(true);
+      Attribute *attr_mP = pointcloud->attributes.add(ATTR_STD_MOTION_VERTEX_POSITION);
+      for (size_t step = 0; step < motion.size(); step++) {
+        float4 *mP = attr_mP->data_float4() + step * points_num;
+        for (int64_t i = 0; i < points_num; i++) {
+          mP[i] = make_float4(motion[step][i], radius[i]);
+        }
+      }
+    }
+
+    return pointcloud;
+  }
+
+  /* Read instance transforms and reference indices of one baked frame. */
+  bool read_instances(const JsonValue &io_instances,
+                      vector<Transform> &r_transforms,
+                      vector<int> &r_reference_indices)
+  {
+    const int64_t num = json_find_int(io_instances, "num_instances", 0);
+    if (num < 0) {
+      return false;
+    }
+    r_reference_indices.resize(num);
+    if (!read_attribute(io_instances, ".reference_index", "INSTANCE", "INT", r_reference_indices))
+    {
+      /* Format from before reference indices were stored as an attribute. */
+      const JsonValue *io_handles = json_find(io_instances, "handles", JsonType::object);
+      if (!io_handles ||
+          !blob_reader_.read(*io_handles, sizeof(int) * num, r_reference_indices.data()))
+      {
+        return false;
+      }
+    }
+
+    /* Column major 4x4 matrices. */
+    vector<float> matrices(num * 16);
+    const JsonValue *io_transform = find_attribute(
+        io_instances, "instance_transform", "INSTANCE", "FLOAT4X4");
+    if (!io_transform || !read_attribute(*io_transform, sizeof(float) * 16, num, matrices.data()))
+    {
+      /* Format from before transforms were stored as an attribute. */
+      const JsonValue *io_transforms = json_find(io_instances, "transforms", JsonType::object);
+      if (!io_transforms ||
+          !blob_reader_.read(*io_transforms, sizeof(float) * matrices.size(), matrices.data()))
+      {
+        return false;
+      }
+    }
+
+    r_transforms.resize(num);
+    for (int64_t i = 0; i < num; i++) {
+      const float *m = &matrices[i * 16];
+      r_transforms[i] = make_transform(
+          m[0], m[4], m[8], m[12], m[1], m[5], m[9], m[13], m[2], m[6], m[10], m[14]);
+    }
+    return true;
+  }
+
+  /* Transforms of a sample, interpolated between frames when the instance counts match. */
+  bool read_instances(const BakeSample &sample,
+                      vector<Transform> &r_transforms,
+                      vector<int> &r_reference_indices)
+  {
+    if (!read_instances(*sample.a, r_transforms, r_reference_indices)) {
+      return false;
+    }
+    if (sample.b == nullptr || sample.factor == 0.0f) {
+      return true;
+    }
+
+    vector<Transform> transforms_b;
+    vector<int> reference_indices_b;
+    if (!read_instances(*sample.b, transforms_b, reference_indices_b) ||
+        transforms_b.size() != r_transforms.size())
+    {
+      return true;
+    }
+    for (size_t i = 0; i < r_transforms.size(); i++) {
+      const Transform tfms[2] = {r_transforms[i], transforms_b[i]};
+      DecomposedTransform decomp[2];
+      transform_motion_decompose(decomp, tfms, 2);
+      transform_motion_array_interpolate(&r_transforms[i], decomp, 2, sample.factor);
+    }
+    return true;
+  }
+
+  void load_instances(const vector<BakeSample> &samples,
+                      const vector<Transform> &tfms,
+                      const int depth)
+  {
+    const size_t center = samples.size() / 2;
+    const JsonValue *io_references = json_find(*samples[center].a, "references", JsonType::array);
+    if (io_references == nullptr) {
+      return;
+    }
+
+    vector<vector<Transform>> step_transforms(samples.size());
+    vector<int> reference_indices;
+    if (!read_instances(samples[center], step_transforms[center], reference_indices)) {
+      return;
+    }
+    const size_t num = reference_indices.size();
+
+    /* Per step references, steps with a different amount of instances don't move. */
+    vector<const JsonValue *> step_references(samples.size(), io_references);
+    for (size_t step = 0; step < samples.size(); step++) {
+      if (step == center) {
+        continue;
+      }
+      vector<int> step_reference_indices;
+      const BakeSample &sample = samples[step];
+      const JsonValue *io_step_references =
+          sample.a ? json_find(*sample.a, "references", JsonType::array) : nullptr;
+      if (io_step_references && io_step_references->size() == io_references->size() &&
+          read_instances(sample, step_transforms[step], step_reference_indices) &&
+          step_reference_indices == reference_indices)
+      {
+        step_references[step] = io_step_references;
+      }
+      else {
+        step_transforms[step] = step_transforms[center];
+      }
+    }
+
+    vector<BakeSample> reference_samples(samples.size());
+    vector<Transform> instance_tfms(samples.size());
+    for (size_t i = 0; i < num; i++) {
+      const int reference = reference_indices[i];
+      if (reference < 0 || reference >= int(io_references->size())) {
+        continue;
+      }
+      for (size_t step = 0; step < samples.size(); step++) {
+        reference_samples[step].a = &(*step_references[step])[reference];
+        reference_samples[step].b = nullptr;
+        instance_tfms[step] = tfms[step] * step_transforms[step][i];
+      }
+      load_geometry(reference_samples, instance_tfms, depth + 1);
+    }
+  }
+
+  Scene *scene_;
+  NodeOwner *owner_;
+  BakeBlobReader &blob_reader_;
+  const array<Node *> &used_shaders_;
+  uint visibility_;
+  const GeometryCacheCulling *culling_;
+  set<Geometry *> &geometries_;
+  set<Object *> &objects_;
+  map<const JsonValue *, Geometry *> geometry_map_;
+  map<const JsonValue *, BoundBox> bounds_;
+  map<const JsonValue *, array<float3>> center_positions_;
+};
+
+/* Geometry Cache Procedural */
+
+NODE_DEFINE(GeometryCacheProcedural)
+{
+  NodeType *type = NodeType::add(
+      "geometry_cache", create, NodeType::NONE, Procedural::get_node_base_type());
+
+  SOCKET_STRING(directory, "Directory", ustring());
+  SOCKET_FLOAT(frame, "Frame", 1.0f);
+  SOCKET_BOOLEAN(use_motion_blur, "Use Motion Blur", false);
+  SOCKET_FLOAT(shutter, "Shutter", 0.5f);
+  SOCKET_TRANSFORM(tfm, "Transform", transform_identity());
+  SOCKET_UINT(visibility, "Visibility", ~0);
+  SOCKET_BOOLEAN(use_camera_cull, "Use Camera Cull", false);
+  SOCKET_FLOAT(camera_cull_margin, "Camera Cull Margin", 0.1f);
+  SOCKET_NODE_ARRAY(used_shaders, "Shaders", Shader::get_node_type());
+
+  return type;
+}
+
+GeometryCacheProcedural::GeometryCacheProcedural() : Procedural(get_node_type()) {}
+
+GeometryCacheProcedural::~GeometryCacheProcedural()
+{
+  if (scene_) {
+    clear_generated_nodes();
+  }
+}
+
+void GeometryCacheProcedural::clear_generated_nodes()
+{
+  /* Objects hold references to the geometries, so they are deleted first. */
+  if (!objects_.empty()) {
+    scene_->delete_nodes(objects_, this);
+    objects_.clear();
+  }
+  if (!geometries_.empty()) {
+    scene_->delete_nodes(geometries_, this);
+    geometries_.clear();
+  }
+}
+
+void GeometryCacheProcedural::generate(Scene *scene, Progress &progress)
+{
+  /* Culling is only supported for cameras that project to a single image plane. */
+  Camera *camera = scene->camera;
+  const bool use_culling = use_camera_cull &&
+                           (camera->get_camera_type() == CAMERA_PERSPECTIVE ||
+                            camera->get_camera_type() == CAMERA_ORTHOGRAPHIC);
+  bool camera_changed = false;
+  if (use_culling) {
+    /* Need to have the projection of the current camera. */
+    camera->update(scene);
+    camera_changed = memcmp(&camera->worldtondc,
+                            &culling_worldtondc_,
+                            sizeof(culling_worldtondc_)) != 0;
+  }
+
+  if (!is_modified() && !camera_changed) {
+    return;
+  }
+
+  scene_ = scene;
+  clear_generated_nodes();
+
+  /* Nothing to stream for invisible caches. */
+  if (directory.empty() || visibility == 0) {
+    clear_modified();
+    return;
+  }
+
+  BakeMetaFiles meta_files(path_join(directory.string(), "meta"));
+  BakeBlobReader blob_reader(path_join(directory.string(), "blobs"));
+
+  /* Sample times, centered around the current frame. */
+  const int motion_steps = (use_motion_blur && shutter > 0.0f) ? 3 : 1;
+  vector<BakeSample> item_samples(motion_steps);
+  for (int step = 0; step < motion_steps; step++) {
+    const float relative_time = (motion_steps > 1) ? float(step) / (motion_steps - 1) - 0.5f :
+                                                     0.0f;
+    item_samples[step] = meta_files.sample(frame + relative_time * shutter);
+  }
+
+  const BakeSample &center_sample = item_samples[motion_steps / 2];
+  if (center_sample.a == nullptr) {
+    LOG_WARNING << "No baked geometry for frame " << frame << " in " << directory.string();
+    clear_modified();
+    return;
+  }
+
+  unique_ptr<GeometryCacheCulling> culling;
+  if (use_culling) {
+    culling = make_unique<GeometryCacheCulling>(camera->worldtondc, camera_cull_margin);
+    culling_worldtondc_ = camera->worldtondc;
+  }
+
+  GeometryCacheLoader loader(
+      scene, this, blob_reader, used_shaders, visibility, culling.get(), geometries_, objects_);
+  const vector<Transform> tfms(motion_steps, tfm);
+
+  for (const auto &item : center_sample.a->items()) {
+    const string &key = item.key();
+    if (progress.get_cancel()) {
+      return;
+    }
+
+    if (!item.value().is_object() || !json_find_str_equals(item.value(), "type", "GEOMETRY")) {
+      continue;
+    }
+
+    vector<BakeSample> geometry_samples(motion_steps);
+    for (int step = 0; step < motion_steps; step++) {
+      geometry_samples[step] = item_samples[step]
+                                   .lookup(key.c_str(), JsonType::object)
+                                   .lookup("data", JsonType::object);
+    }
+    loader.load_geometry(geometry_samples, tfms);
+  }
+
+  LOG_INFO << "Geometry cache " << directory.string() << " frame " << frame << ": "
+           << geometries_.size() << " geometries, " << objects_.size() << " objects";
+
+  clear_modified();
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,72 @@
+/* SPDX-FileCopyrightText: 2011-2025 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include "scene/procedural.h"
+
+#include "util/array.h"
+#include "util/projection.h"
+#include "util/set.h"
+#include "util/transform.h"
+
+CCL_NAMESPACE_BEGIN
+
+class Geometry;
+class Object;
+
+/* Procedural streaming geometry from a Geometry Nodes bake directory at render time.
+ *
+ * The bake is expected to use the layout written by Blender: a `meta` folder with one JSON file
+ * per baked frame describing the baked items, and a `blobs` folder with the binary data that the
+ * meta files reference by byte range. Only the data needed for rendering (positions, topology,
+ * material indices, smooth flags and radii) is read, and only for the frames needed by the
+ * current frame and its motion steps, optionally skipping components outside of the camera view.
+ * Sub-frames are interpolated from the neighboring baked frames when their topology matches.
+ *
+ * Instances are not realized: every instance reference becomes a single Geometry shared by one
+ * Object per instance, so scattered bakes cost as much memory as their unique geometry. */
+class GeometryCacheProcedural : public Procedural {
+ public:
+  NODE_DECLARE
+
+  /* Root directory of the bake, containing the `meta` and `blobs` folders. */
+  NODE_SOCKET_API(ustring, directory)
+
+  /* Scene frame to load, may be a sub-frame. */
+  NODE_SOCKET_API(float, frame)
+
+  /* Load the previous and next motion step from the bake. The shutter is in frames and centered
+   * around the current frame. */
+  NODE_SOCKET_API(bool, use_motion_blur)
+  NODE_SOCKET_API(float, shutter)
+
+  /* Applied to all generated objects. */
+  NODE_SOCKET_API(Transform, tfm)
+  NODE_SOCKET_API(uint, visibility)
+
+  /* Skip components outside of the camera view, see the camera culling of Blender objects. */
+  NODE_SOCKET_API(bool, use_camera_cull)
+  NODE_SOCKET_API(float, camera_cull_margin)
+
+  /* Shaders indexed by the baked material index. */
+  NODE_SOCKET_API_ARRAY(array<Node *>, used_shaders)
+
+  GeometryCacheProcedural();
+  ~GeometryCacheProcedural() override;
+
+  void generate(Scene *scene, Progress &progress) override;
+
+ private:
+  /* Remove all geometries and objects generated for the previous frame. */
+  void clear_generated_nodes();
+
+  Scene *scene_ = nullptr;
+  /* Camera projection used for culling the current nodes, to regenerate when it changes. */
+  ProjectionTransform culling_worldtondc_ = {};
+  set<Geometry *> geometries_;
+  set<Object *> objects_;
+};
+
+CCL_NAMESPACE_END
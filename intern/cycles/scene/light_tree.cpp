@@ -273,12 +273,21 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, const int prim_id)
 
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, const int object_id)
 {
+  /* Gather emissive triangles first, so that their emitters can be constructed in parallel. */
+  vector<int> prim_ids;
   const size_t mesh_num_triangles = mesh->num_triangles();
   for (size_t i = 0; i < mesh_num_triangles; i++) {
     if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+      prim_ids.push_back(i);
     }
   }
+
+  const size_t offset = emitters_.size();
+  emitters_.resize(offset + prim_ids.size());
+
+  parallel_for(size_t(0), prim_ids.size(), [&](const size_t i) {
+    emitters_[offset + i] = LightTreeEmitter(scene, prim_ids[i], object_id);
+  });
 }
 
 LightTree::LightTree(Scene *scene,
@@ -537,22 +546,53 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
   middle = (start + end) / 2;
 
+  const int num_chunks = divide_up(num_emitters, int(EMITTERS_PER_BINNING_CHUNK));
+
+  /* Run the function for every chunk of emitters, in parallel when there is more than one.
+   * The results of the chunks are merged in order by the caller, so that the tree does not depend
+   * on the number of threads. */
+  auto for_each_chunk = [&](auto &&func) {
+    if (num_chunks == 1) {
+      func(0, start, end);
+      return;
+    }
+    parallel_for(0, num_chunks, [&](const int chunk) {
+      const int chunk_start = start + chunk * EMITTERS_PER_BINNING_CHUNK;
+      const int chunk_end = min(end, chunk_start + int(EMITTERS_PER_BINNING_CHUNK));
+      func(chunk, chunk_start, chunk_end);
+    });
+  };
+
+  /* Per-chunk storage is only needed for parallel binning, small nodes write to the result
+   * directly to avoid allocations. */
+  vector<BoundBox> chunk_centroid_bbox(num_chunks > 1 ? num_chunks : 0, BoundBox::empty);
+
   BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
+  for_each_chunk([&](const int chunk, const int chunk_start, const int chunk_end) {
+    BoundBox &local_bbox = (num_chunks == 1) ? centroid_bbox : chunk_centroid_bbox[chunk];
+    for (int i = chunk_start; i < chunk_end; i++) {
+      local_bbox.grow((emitters + i)->centroid);
+    }
+  });
+  for (const BoundBox &bbox : chunk_centroid_bbox) {
+    centroid_bbox.grow(bbox);
   }
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
 
   /* Check each dimension to find the minimum splitting cost. */
+  using Buckets = std::array<LightTreeBucket, LightTreeBucket::num_buckets>;
+  vector<Buckets> chunk_buckets(num_chunks > 1 ? num_chunks : 0);
+
   float total_cost = 0.0f;
   float min_cost = FLT_MAX;
   for (int dim = 0; dim < 3; dim++) {
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
+    Buckets buckets;
     float inv_extent;
 
-    if (centroid_bbox.size()[dim] == 0.0f) {
+    const bool is_degenerate = centroid_bbox.size()[dim] == 0.0f;
+    if (is_degenerate) {
       /* If the centroid bounding box is 0 along a given dimension and the node measure is
        * already computed, skip it. */
       if (dim != 0) {
@@ -561,23 +601,37 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
       /* Degenerate case, everything in the same bucket. */
       inv_extent = FLT_MAX;
-      for (int i = start; i < end; i++) {
-        buckets[0].add(emitters[i]);
-      }
     }
     else {
-      /* Fill in buckets with emitters. */
       inv_extent = 1 / (centroid_bbox.size()[dim]);
-      for (int i = start; i < end; i++) {
+    }
+
+    /* Fill in buckets with emitters. */
+    for_each_chunk([&](const int chunk, const int chunk_start, const int chunk_end) {
+      Buckets &local_buckets = (num_chunks == 1) ? buckets : chunk_buckets[chunk];
+      local_buckets = Buckets();
+
+      for (int i = chunk_start; i < chunk_end; i++) {
         const LightTreeEmitter *emitter = emitters + i;
 
+        if (is_degenerate) {
+          local_buckets[0].add(*emitter);
+          continue;
+        }
+
         /* Place emitter into the appropriate bucket, where the centroid box is split into equal
          * partitions. */
         int bucket_idx = LightTreeBucket::num_buckets *
                          (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
         bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
 
-        buckets[bucket_idx].add(*emitter);
+        local_buckets[bucket_idx].add(*emitter);
+      }
+    });
+
+    for (const Buckets &local_buckets : chunk_buckets) {
+      for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+        buckets[i] = buckets[i] + local_buckets[i];
       }
     }
 
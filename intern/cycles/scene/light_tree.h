@@ -196,6 +196,8 @@ struct LightTreeEmitter {
 
   LightTreeMeasure measure;
 
+  /* Placeholder, used to allocate storage for emitters which are constructed in parallel. */
+  LightTreeEmitter() = default;
   LightTreeEmitter(Object *object, const int object_id); /* Mesh emitter. */
   LightTreeEmitter(Scene *scene,
                    const int prim_id,
@@ -439,6 +441,8 @@ class LightTree {
   TaskPool task_pool;
   /* Do not spawn a thread if less than this amount of emitters are to be processed. */
   enum { MIN_EMITTERS_PER_THREAD = 4096 };
+  /* Emitters of large nodes are binned in parallel, in chunks of this size. */
+  enum { EMITTERS_PER_BINNING_CHUNK = 4096 };
 
   void recursive_build(Child child,
                        LightTreeNode *inner,
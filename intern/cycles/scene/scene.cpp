@@ -14,6 +14,7 @@
 #include "scene/curves.h"
 #include "scene/devicescene.h"
 #include "scene/film.h"
+#include "scene/geometry_cache.h"
 #include "scene/hair.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
@@ -937,6 +938,16 @@ template<> Film *Scene::create_node<Film>()
   return node_ptr;
 }
 
+template<> GeometryCacheProcedural *Scene::create_node<GeometryCacheProcedural>()
+{
+  unique_ptr<GeometryCacheProcedural> node = make_unique<GeometryCacheProcedural>();
+  GeometryCacheProcedural *node_ptr = node.get();
+  node->set_owner(this);
+  procedurals.push_back(std::move(node));
+  procedural_manager->tag_update();
+  return node_ptr;
+}
+
 template<> void Scene::delete_node(Light *node)
 {
   assert(node->get_owner() == this);
@@ -31,6 +31,7 @@ class Light;
 class LightManager;
 class LookupTables;
 class Geometry;
+class GeometryCacheProcedural;
 class GeometryManager;
 class Object;
 class ObjectManager;
@@ -275,6 +276,7 @@ template<> Camera *Scene::create_node<Camera>();
 template<> Background *Scene::create_node<Background>();
 template<> Film *Scene::create_node<Film>();
 template<> Integrator *Scene::create_node<Integrator>();
+template<> GeometryCacheProcedural *Scene::create_node<GeometryCacheProcedural>();
 
 template<> void Scene::delete_node(Light *node);
 template<> void Scene::delete_node(Mesh *node);
@@ -776,6 +776,12 @@ void Session::collect_statistics(RenderStats *render_stats)
 
 void Session::process_full_buffer_from_disk(string_view filename)
 {
+  if (params.use_out_of_core_buffers) {
+    const int tile_size = tile_manager_.compute_render_tile_size(params.tile_size);
+    path_trace_->process_full_buffer_from_disk_tiled(filename, make_int2(tile_size, tile_size));
+    return;
+  }
+
   path_trace_->process_full_buffer_from_disk(filename);
 }
 
@@ -60,6 +60,10 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Process the full-frame buffer cached on disk one tile at a time when finishing the render,
+   * instead of reading it into memory as a whole. */
+  bool use_out_of_core_buffers;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -84,6 +88,7 @@ class SessionParams {
 
     use_auto_tile = true;
     tile_size = 2048;
+    use_out_of_core_buffers = false;
 
     use_resolution_divider = true;
 
@@ -661,4 +661,187 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   return true;
 }
 
+bool TileManager::open_full_buffer_from_disk(const string_view filename,
+                                             BufferParams *buffer_params,
+                                             DenoiseParams *denoise_params)
+{
+  close_full_buffer_from_disk();
+
+  unique_ptr<ImageInput> in(ImageInput::open(filename));
+  if (!in) {
+    LOG_ERROR << "Error opening tile file " << filename;
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+
+  BufferParams full_buffer_params;
+  if (!buffer_params_from_image_spec_atttributes(&full_buffer_params, image_spec)) {
+    return false;
+  }
+
+  if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+    return false;
+  }
+
+  if (image_spec.nchannels != full_buffer_params.pass_stride) {
+    LOG_ERROR << "Mismatched number of channels in the tile file " << filename;
+    return false;
+  }
+
+  *buffer_params = full_buffer_params;
+
+  read_state_.buffer_params = std::move(full_buffer_params);
+  read_state_.tile_in = std::move(in);
+
+  LOG_DEBUG << "Opened tile file " << filename << " for tiled read.";
+
+  return true;
+}
+
+void TileManager::close_full_buffer_from_disk()
+{
+  if (!read_state_.tile_in) {
+    return;
+  }
+
+  if (!read_state_.tile_in->close()) {
+    LOG_ERROR << "Error closing tile file " << read_state_.tile_in->geterror();
+  }
+
+  read_state_.tile_in = nullptr;
+  read_state_.buffer_params = BufferParams();
+}
+
+int TileManager::get_num_full_buffer_tiles(const int2 tile_size) const
+{
+  const BufferParams &params = read_state_.buffer_params;
+
+  return divide_up(params.width, tile_size.x) * divide_up(params.height, tile_size.y);
+}
+
+Tile TileManager::get_full_buffer_tile(const int2 tile_size,
+                                       const int overlap,
+                                       const int index) const
+{
+  const BufferParams &params = read_state_.buffer_params;
+
+  const int num_tiles_x = divide_up(params.width, tile_size.x);
+
+  const int tile_index_y = index / num_tiles_x;
+  const int tile_index_x = index - tile_index_y * num_tiles_x;
+
+  const int tile_window_x = tile_index_x * tile_size.x;
+  const int tile_window_y = tile_index_y * tile_size.y;
+
+  Tile tile;
+
+  tile.x = max(0, tile_window_x - overlap);
+  tile.y = max(0, tile_window_y - overlap);
+
+  tile.window_x = tile_window_x - tile.x;
+  tile.window_y = tile_window_y - tile.y;
+  tile.window_width = min(tile_size.x, params.width - tile_window_x);
+  tile.window_height = min(tile_size.y, params.height - tile_window_y);
+
+  tile.width = min(params.width - tile.x, tile.window_x + tile.window_width + overlap);
+  tile.height = min(params.height - tile.y, tile.window_y + tile.window_height + overlap);
+
+  return tile;
+}
+
+bool TileManager::read_full_buffer_tile_from_disk(const Tile &tile, RenderBuffers *buffers)
+{
+  ImageInput *in = read_state_.tile_in.get();
+  if (!in) {
+    LOG_ERROR << "Tile file is not open for read.";
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+  const BufferParams &full_params = read_state_.buffer_params;
+
+  BufferParams tile_params = full_params;
+  tile_params.width = tile.width;
+  tile_params.height = tile.height;
+  tile_params.window_x = tile.window_x;
+  tile_params.window_y = tile.window_y;
+  tile_params.window_width = tile.window_width;
+  tile_params.window_height = tile.window_height;
+  tile_params.full_x = full_params.full_x + tile.x;
+  tile_params.full_y = full_params.full_y + tile.y;
+  tile_params.update_offset_stride();
+
+  buffers->reset(tile_params);
+
+  /* Tiles of the file can only be read as a whole, so read the smallest region aligned to the
+   * image tiles which covers the requested tile, and copy the requested part of it. The file
+   * tiles are small compared to the render tiles, so this does not affect memory usage much. */
+  const int image_tile_width = image_spec.tile_width ? image_spec.tile_width : image_spec.width;
+  const int image_tile_height = image_spec.tile_height ? image_spec.tile_height :
+                                                         image_spec.height;
+
+  const int read_x = image_spec.x + tile.x - tile.x % image_tile_width;
+  const int read_y = image_spec.y + tile.y - tile.y % image_tile_height;
+  const int read_x_end = min(image_spec.x + image_spec.width,
+                             image_spec.x + int(align_up(tile.x + tile.width, image_tile_width)));
+  const int read_y_end = min(
+      image_spec.y + image_spec.height,
+      image_spec.y + int(align_up(tile.y + tile.height, image_tile_height)));
+  const int read_width = read_x_end - read_x;
+  const int read_height = read_y_end - read_y;
+
+  const int64_t pass_stride = full_params.pass_stride;
+
+  vector<float> pixel_storage(pass_stride * read_width * read_height);
+
+  bool success;
+  if (image_spec.tile_width) {
+    success = in->read_tiles(0,
+                             0,
+                             read_x,
+                             read_x_end,
+                             read_y,
+                             read_y_end,
+                             0,
+                             1,
+                             0,
+                             image_spec.nchannels,
+                             TypeDesc::FLOAT,
+                             pixel_storage.data());
+  }
+  else {
+    success = in->read_scanlines(0,
+                                 0,
+                                 read_y,
+                                 read_y_end,
+                                 0,
+                                 0,
+                                 image_spec.nchannels,
+                                 TypeDesc::FLOAT,
+                                 pixel_storage.data());
+  }
+
+  if (!success) {
+    LOG_ERROR << "Error reading pixels from the tile file " << in->geterror();
+    return false;
+  }
+
+  const int64_t read_row_stride = pass_stride * read_width;
+  const int64_t tile_row_stride = pass_stride * tile.width;
+
+  const float *src = pixel_storage.data() +
+                     (image_spec.y + tile.y - read_y) * read_row_stride +
+                     (image_spec.x + tile.x - read_x) * pass_stride;
+  float *dst = buffers->buffer.data();
+
+  for (int i = 0; i < tile.height; ++i) {
+    memcpy(dst, src, sizeof(float) * tile_row_stride);
+    src += read_row_stride;
+    dst += tile_row_stride;
+  }
+
+  return true;
+}
+
 CCL_NAMESPACE_END
@@ -107,6 +107,33 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Out-of-core access to the full frame render buffer stored in the tiles file on disk.
+   *
+   * The file is opened once and stays open until `close_full_buffer_from_disk()`, so that
+   * tiles can be read one at a time. This keeps the render buffers proportional to the tile size
+   * rather than the image size, so no full-frame render buffer is needed to denoise and output
+   * very large images with many passes.
+   *
+   * Returns true on success. */
+  bool open_full_buffer_from_disk(string_view filename,
+                                  BufferParams *buffer_params,
+                                  DenoiseParams *denoise_params);
+  void close_full_buffer_from_disk();
+
+  /* Get configuration of a tile of the full buffer which is currently open for read.
+   * The tile window covers the given tile index of the grid with tiles of the given size, and
+   * the tile itself is extended by the given number of overlap pixels on every side (clamped to
+   * the image bounds). */
+  int get_num_full_buffer_tiles(const int2 tile_size) const;
+  Tile get_full_buffer_tile(const int2 tile_size, const int overlap, const int index) const;
+
+  /* Read render buffer of the given tile of the full buffer which is currently open for read.
+   * The buffer parameters of the result are configured so that the tile window is the visible
+   * part of the buffer.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_tile_from_disk(const Tile &tile, RenderBuffers *buffers);
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -176,6 +203,14 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* State of tile-wise reading of the full buffer from a file on disk. */
+  struct {
+    /* Parameters of the full frame buffer stored in the file. */
+    BufferParams buffer_params;
+
+    unique_ptr<ImageInput> tile_in;
+  } read_state_;
 };
 
 CCL_NAMESPACE_END
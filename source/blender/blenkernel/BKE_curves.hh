@@ -430,6 +430,19 @@ class CurvesGeometry : public blender::CurvesGeometry {
   /** Return the slice of #evaluated_length_cache that corresponds to this curve index. */
   IndexRange lengths_range_for_curve(int curve_index, bool cyclic) const;
 
+  /**
+   * Compute the evaluated data for the curves in the mask, writing into the full size spans.
+   * Used to fill the caches from scratch and to update them for a subset of changed curves.
+   */
+  void calculate_evaluated_positions(const IndexMask &curve_mask,
+                                     MutableSpan<float3> evaluated_positions) const;
+  void calculate_evaluated_tangents(const IndexMask &curve_mask,
+                                    MutableSpan<float3> tangents) const;
+  void calculate_evaluated_normals(const IndexMask &curve_mask,
+                                   MutableSpan<float3> evaluated_normals) const;
+  void calculate_evaluated_lengths(const IndexMask &curve_mask,
+                                   MutableSpan<float> evaluated_lengths) const;
+
   /* --------------------------------------------------------------------
    * Operations.
    */
@@ -445,6 +458,12 @@ class CurvesGeometry : public blender::CurvesGeometry {
 
   /** Call after deforming the position attribute. */
   void tag_positions_changed();
+  /**
+   * Call after deforming the positions of only some curves. Evaluated data that is already
+   * cached is recomputed for the changed curves only, instead of being rebuilt on the next access.
+   * The topology and the curve types must not have changed.
+   */
+  void tag_positions_changed(const IndexMask &changed_curves);
   /**
    * Call after any operation that changes the topology
    * (number of points, evaluated points, or the total count).
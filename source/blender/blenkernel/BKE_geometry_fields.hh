@@ -44,6 +44,8 @@ class MeshFieldContext : public fn::FieldContext {
   {
     return domain_;
   }
+
+  bool result_cache_state(fn::FieldResultCacheState &r_state) const override;
 };
 
 class CurvesFieldContext : public fn::FieldContext {
@@ -214,6 +216,8 @@ class GeometryFieldContext : public fn::FieldContext {
   const Instances *instances() const;
   const CurvesGeometry *curves_or_strokes() const;
   const Curves *curves_id() const;
+
+  bool result_cache_state(fn::FieldResultCacheState &r_state) const override;
 };
 
 class GeometryFieldInput : public fn::FieldInput {
@@ -78,6 +78,10 @@ struct ImageRuntime {
 
   int lastused = 0;
 
+  /* Frame of the image sequence that was last loaded from disk, to detect the playback direction
+   * and prefetch the frames that follow. */
+  int last_loaded_frame = IMAGE_GPU_FRAME_NONE;
+
   /** Register containing partial updates. */
   PartialUpdateRegister *partial_update_register = nullptr;
   /** Partial update user for gpu::Textures stored inside the Image. */
@@ -10,6 +10,7 @@
 
 #include "BLI_array.hh"
 #include "BLI_enum_flags.hh"
+#include "BLI_index_mask_fwd.hh"
 #include "BLI_math_matrix_types.hh"
 
 namespace blender {
@@ -116,7 +117,11 @@ void multiresModifier_sync_levels_ex(Object *ob_dst,
                                      const MultiresModifierData *mmd_src,
                                      MultiresModifierData *mmd_dst);
 
-void multires_stitch_grids(Object *);
+/**
+ * Average the grid boundaries and corners shared by the given faces with their neighbors, so that
+ * the grids of these faces match up again after they were changed independently.
+ */
+void multires_stitch_grids(Object *ob, const IndexMask &face_mask);
 
 void multiresModifier_scale_disp(Depsgraph *depsgraph, Scene *scene, Object *ob);
 void multiresModifier_prepare_join(Depsgraph *depsgraph, Scene *scene, Object *ob, Object *to_ob);
@@ -158,7 +163,14 @@ bool multiresModifier_reshapeFromDeformModifier(Depsgraph *depsgraph,
                                                 Object *ob,
                                                 MultiresModifierData *mmd,
                                                 ModifierData *deform_md);
-bool multiresModifier_reshapeFromCCG(int tot_level, Mesh *coarse_mesh, SubdivCCG *subdiv_ccg);
+/**
+ * \param use_half_precision_orig: Keep the temporary copy of the original displacement in half
+ * precision while reshaping, see #eMultiresModifierFlag_UseHalfPrecisionReshape.
+ */
+bool multiresModifier_reshapeFromCCG(int tot_level,
+                                     Mesh *coarse_mesh,
+                                     SubdivCCG *subdiv_ccg,
+                                     bool use_half_precision_orig = false);
 
 /* Subdivide multi-res displacement once. */
 
@@ -417,6 +417,12 @@ struct bNodeType {
 
   /** True when the node cannot be muted. */
   bool no_muting = false;
+  /**
+   * True when the outputs of the node depend on more than its inputs and referenced data-blocks,
+   * e.g. on whether it is evaluated in the viewport, or when the node has side effects. Results
+   * of node trees containing such nodes are never reused for other evaluations.
+   */
+  bool depends_on_evaluation_context = false;
   /** Some nodes should ignore the inferred visibility for improved UX. */
   bool ignore_inferred_input_socket_visibility = false;
   /** True when the node still works but it's usage is discouraged. */
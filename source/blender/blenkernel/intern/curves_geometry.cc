@@ -823,6 +823,82 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
   });
 }
 
+void CurvesGeometry::calculate_evaluated_positions(const IndexMask &curve_mask,
+                                                   MutableSpan<float3> evaluated_positions) const
+{
+  const CurvesGeometryRuntime &runtime = *this->runtime;
+  const OffsetIndices<int> points_by_curve = this->points_by_curve();
+  const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
+  const Span<float3> positions = this->positions();
+
+  auto evaluate_catmull = [&](const IndexMask &selection) {
+    const VArray<bool> cyclic = this->cyclic();
+    const VArray<int> resolution = this->resolution();
+    selection.foreach_index(
+        [&](const int curve_index) {
+          const IndexRange points = points_by_curve[curve_index];
+          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+          curves::catmull_rom::interpolate_to_evaluated(
+              positions.slice(points),
+              cyclic[curve_index],
+              resolution[curve_index],
+              evaluated_positions.slice(evaluated_points));
+        },
+        exec_mode::grain_size(128));
+  };
+  auto evaluate_poly = [&](const IndexMask &selection) {
+    array_utils::copy_group_to_group(
+        points_by_curve, evaluated_points_by_curve, selection, positions, evaluated_positions);
+  };
+  auto evaluate_bezier = [&](const IndexMask &selection) {
+    const std::optional<Span<float3>> handle_positions_left = this->handle_positions_left();
+    const std::optional<Span<float3>> handle_positions_right = this->handle_positions_right();
+    if (!handle_positions_left || !handle_positions_right) {
+      curves::fill_points(evaluated_points_by_curve, selection, float3(0), evaluated_positions);
+      return;
+    }
+    const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
+    selection.foreach_index(
+        [&](const int curve_index) {
+          const IndexRange points = points_by_curve[curve_index];
+          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+          const IndexRange offsets = curves::per_curve_point_offsets_range(points, curve_index);
+          curves::bezier::calculate_evaluated_positions(
+              positions.slice(points),
+              handle_positions_left->slice(points),
+              handle_positions_right->slice(points),
+              all_bezier_offsets.slice(offsets),
+              evaluated_positions.slice(evaluated_points));
+        },
+        exec_mode::grain_size(128));
+  };
+  auto evaluate_nurbs = [&](const IndexMask &selection) {
+    this->ensure_nurbs_basis_cache();
+    const VArray<int8_t> nurbs_orders = this->nurbs_orders();
+    const std::optional<Span<float>> nurbs_weights = this->nurbs_weights();
+    const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+    selection.foreach_index(
+        [&](const int curve_index) {
+          const IndexRange points = points_by_curve[curve_index];
+          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+          curves::nurbs::interpolate_to_evaluated(nurbs_basis_cache[curve_index],
+                                                  nurbs_orders[curve_index],
+                                                  nurbs_weights ? nurbs_weights->slice(points) :
+                                                                  Span<float>(),
+                                                  positions.slice(points),
+                                                  evaluated_positions.slice(evaluated_points));
+        },
+        exec_mode::grain_size(128));
+  };
+  curves::foreach_curve_by_type(this->curve_types(),
+                                this->curve_type_counts(),
+                                curve_mask,
+                                evaluate_catmull,
+                                evaluate_poly,
+                                evaluate_bezier,
+                                evaluate_nurbs);
+}
+
 Span<float3> CurvesGeometry::evaluated_positions() const
 {
   const CurvesGeometryRuntime &runtime = *this->runtime;
@@ -834,138 +910,71 @@ Span<float3> CurvesGeometry::evaluated_positions() const
   this->ensure_nurbs_basis_cache();
   runtime.evaluated_position_cache.ensure([&](Vector<float3> &r_data) {
     r_data.resize(this->evaluated_points_num());
-    MutableSpan<float3> evaluated_positions = r_data;
-
-    const OffsetIndices<int> points_by_curve = this->points_by_curve();
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const Span<float3> positions = this->positions();
-
-    auto evaluate_catmull = [&](const IndexMask &selection) {
-      const VArray<bool> cyclic = this->cyclic();
-      const VArray<int> resolution = this->resolution();
-      selection.foreach_index(
-          [&](const int curve_index) {
-            const IndexRange points = points_by_curve[curve_index];
-            const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-            curves::catmull_rom::interpolate_to_evaluated(
-                positions.slice(points),
-                cyclic[curve_index],
-                resolution[curve_index],
-                evaluated_positions.slice(evaluated_points));
-          },
-          exec_mode::grain_size(128));
-    };
-    auto evaluate_poly = [&](const IndexMask &selection) {
-      array_utils::copy_group_to_group(
-          points_by_curve, evaluated_points_by_curve, selection, positions, evaluated_positions);
-    };
-    auto evaluate_bezier = [&](const IndexMask &selection) {
-      const std::optional<Span<float3>> handle_positions_left = this->handle_positions_left();
-      const std::optional<Span<float3>> handle_positions_right = this->handle_positions_right();
-      if (!handle_positions_left || !handle_positions_right) {
-        curves::fill_points(evaluated_points_by_curve, selection, float3(0), evaluated_positions);
-        return;
-      }
-      const Span<int> all_bezier_offsets =
-          runtime.evaluated_offsets_cache.data().all_bezier_offsets;
-      selection.foreach_index(
-          [&](const int curve_index) {
-            const IndexRange points = points_by_curve[curve_index];
-            const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-            const IndexRange offsets = curves::per_curve_point_offsets_range(points, curve_index);
-            curves::bezier::calculate_evaluated_positions(
-                positions.slice(points),
-                handle_positions_left->slice(points),
-                handle_positions_right->slice(points),
-                all_bezier_offsets.slice(offsets),
-                evaluated_positions.slice(evaluated_points));
-          },
-          exec_mode::grain_size(128));
-    };
-    auto evaluate_nurbs = [&](const IndexMask &selection) {
-      this->ensure_nurbs_basis_cache();
-      const VArray<int8_t> nurbs_orders = this->nurbs_orders();
-      const std::optional<Span<float>> nurbs_weights = this->nurbs_weights();
-      const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
-      selection.foreach_index(
-          [&](const int curve_index) {
-            const IndexRange points = points_by_curve[curve_index];
-            const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-            curves::nurbs::interpolate_to_evaluated(nurbs_basis_cache[curve_index],
-                                                    nurbs_orders[curve_index],
-                                                    nurbs_weights ? nurbs_weights->slice(points) :
-                                                                    Span<float>(),
-                                                    positions.slice(points),
-                                                    evaluated_positions.slice(evaluated_points));
-          },
-          exec_mode::grain_size(128));
-    };
-    curves::foreach_curve_by_type(this->curve_types(),
-                                  this->curve_type_counts(),
-                                  this->curves_range(),
-                                  evaluate_catmull,
-                                  evaluate_poly,
-                                  evaluate_bezier,
-                                  evaluate_nurbs);
+    this->calculate_evaluated_positions(this->curves_range(), r_data);
   });
   return runtime.evaluated_position_cache.data();
 }
 
-Span<float3> CurvesGeometry::evaluated_tangents() const
+void CurvesGeometry::calculate_evaluated_tangents(const IndexMask &curve_mask,
+                                                  MutableSpan<float3> tangents) const
 {
-  const CurvesGeometryRuntime &runtime = *this->runtime;
-  runtime.evaluated_tangent_cache.ensure([&](Vector<float3> &r_data) {
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const Span<float3> evaluated_positions = this->evaluated_positions();
-    const VArray<bool> cyclic = this->cyclic();
-
-    r_data.resize(this->evaluated_points_num());
-    MutableSpan<float3> tangents = r_data;
+  const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
+  const Span<float3> evaluated_positions = this->evaluated_positions();
+  const VArray<bool> cyclic = this->cyclic();
 
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      for (const int curve_index : curves_range) {
+  curve_mask.foreach_index(
+      [&](const int curve_index) {
         const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
         curves::poly::calculate_tangents(evaluated_positions.slice(evaluated_points),
                                          cyclic[curve_index],
                                          tangents.slice(evaluated_points));
-      }
-    });
+      },
+      exec_mode::grain_size(128));
 
-    /* Correct the first and last tangents of non-cyclic Bezier curves so that they align with
-     * the inner handles. This is a separate loop to avoid the cost when Bezier type curves are
-     * not used. */
-    IndexMaskMemory memory;
-    const IndexMask bezier_mask = this->indices_for_curve_type(CURVE_TYPE_BEZIER, memory);
-    if (!bezier_mask.is_empty()) {
-      const OffsetIndices<int> points_by_curve = this->points_by_curve();
-      const Span<float3> positions = this->positions();
-      const Span<float3> handles_left = *this->handle_positions_left();
-      const Span<float3> handles_right = *this->handle_positions_right();
-
-      bezier_mask.foreach_index(
-          [&](const int curve_index) {
-            if (cyclic[curve_index]) {
-              return;
-            }
-            const IndexRange points = points_by_curve[curve_index];
-            const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+  /* Correct the first and last tangents of non-cyclic Bezier curves so that they align with
+   * the inner handles. This is a separate loop to avoid the cost when Bezier type curves are
+   * not used. */
+  IndexMaskMemory memory;
+  const IndexMask bezier_mask = this->indices_for_curve_type(
+      CURVE_TYPE_BEZIER, curve_mask, memory);
+  if (!bezier_mask.is_empty()) {
+    const OffsetIndices<int> points_by_curve = this->points_by_curve();
+    const Span<float3> positions = this->positions();
+    const Span<float3> handles_left = *this->handle_positions_left();
+    const Span<float3> handles_right = *this->handle_positions_right();
 
-            const float epsilon = 1e-6f;
-            if (!math::almost_equal_relative(
-                    handles_right[points.first()], positions[points.first()], epsilon))
-            {
-              tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
-                                                                   positions[points.first()]);
-            }
-            if (!math::almost_equal_relative(
-                    handles_left[points.last()], positions[points.last()], epsilon))
-            {
-              tangents[evaluated_points.last()] = math::normalize(positions[points.last()] -
-                                                                  handles_left[points.last()]);
-            }
-          },
-          exec_mode::grain_size(1024));
-    }
+    bezier_mask.foreach_index(
+        [&](const int curve_index) {
+          if (cyclic[curve_index]) {
+            return;
+          }
+          const IndexRange points = points_by_curve[curve_index];
+          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+
+          const float epsilon = 1e-6f;
+          if (!math::almost_equal_relative(
+                  handles_right[points.first()], positions[points.first()], epsilon))
+          {
+            tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
+                                                                 positions[points.first()]);
+          }
+          if (!math::almost_equal_relative(
+                  handles_left[points.last()], positions[points.last()], epsilon))
+          {
+            tangents[evaluated_points.last()] = math::normalize(positions[points.last()] -
+                                                                handles_left[points.last()]);
+          }
+        },
+        exec_mode::grain_size(1024));
+  }
+}
+
+Span<float3> CurvesGeometry::evaluated_tangents() const
+{
+  const CurvesGeometryRuntime &runtime = *this->runtime;
+  runtime.evaluated_tangent_cache.ensure([&](Vector<float3> &r_data) {
+    r_data.resize(this->evaluated_points_num());
+    this->calculate_evaluated_tangents(this->curves_range(), r_data);
   });
   return runtime.evaluated_tangent_cache.data();
 }
@@ -1033,97 +1042,104 @@ static void evaluate_generic_data_for_curve(const EvalData &eval_data,
   }
 }
 
-Span<float3> CurvesGeometry::evaluated_normals() const
+void CurvesGeometry::calculate_evaluated_normals(const IndexMask &curve_mask,
+                                                 MutableSpan<float3> evaluated_normals) const
 {
   const CurvesGeometryRuntime &runtime = *this->runtime;
-  this->ensure_nurbs_basis_cache();
-  runtime.evaluated_normal_cache.ensure([&](Vector<float3> &r_data) {
-    const OffsetIndices<int> points_by_curve = this->points_by_curve();
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const VArray<int8_t> types = this->curve_types();
-    const VArray<bool> cyclic = this->cyclic();
-    const VArray<int8_t> normal_mode = this->normal_mode();
-    const Span<float3> evaluated_tangents = this->evaluated_tangents();
-    const AttributeAccessor attributes = this->attributes();
-    const EvalData eval_data{
-        points_by_curve,
-        types,
-        cyclic,
-        this->resolution(),
-        runtime.evaluated_offsets_cache.data().all_bezier_offsets,
-        runtime.nurbs_basis_cache.data(),
-        this->nurbs_orders(),
-        this->nurbs_weights(),
-    };
-    const VArray<float> tilt = this->tilt();
-    VArraySpan<float> tilt_span;
-    const bool use_tilt = !(tilt.is_single() && tilt.get_internal_single() == 0.0f);
-    if (use_tilt) {
-      tilt_span = tilt;
-    }
-    VArraySpan<float3> custom_normal_span;
-    if (const VArray<float3> custom_normal = *attributes.lookup<float3>("custom_normal",
-                                                                        AttrDomain::Point))
-    {
-      custom_normal_span = custom_normal;
-    }
-
-    r_data.resize(this->evaluated_points_num());
-    MutableSpan<float3> evaluated_normals = r_data;
+  const OffsetIndices<int> points_by_curve = this->points_by_curve();
+  const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
+  const VArray<int8_t> types = this->curve_types();
+  const VArray<bool> cyclic = this->cyclic();
+  const VArray<int8_t> normal_mode = this->normal_mode();
+  const Span<float3> evaluated_tangents = this->evaluated_tangents();
+  const AttributeAccessor attributes = this->attributes();
+  const EvalData eval_data{
+      points_by_curve,
+      types,
+      cyclic,
+      this->resolution(),
+      runtime.evaluated_offsets_cache.data().all_bezier_offsets,
+      runtime.nurbs_basis_cache.data(),
+      this->nurbs_orders(),
+      this->nurbs_weights(),
+  };
+  const VArray<float> tilt = this->tilt();
+  VArraySpan<float> tilt_span;
+  const bool use_tilt = !(tilt.is_single() && tilt.get_internal_single() == 0.0f);
+  if (use_tilt) {
+    tilt_span = tilt;
+  }
+  VArraySpan<float3> custom_normal_span;
+  if (const VArray<float3> custom_normal = *attributes.lookup<float3>("custom_normal",
+                                                                      AttrDomain::Point))
+  {
+    custom_normal_span = custom_normal;
+  }
 
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      /* Reuse a buffer for the evaluated tilts. */
-      Vector<float> evaluated_tilts;
+  curve_mask.foreach_segment(
+      [&](const IndexMaskSegment segment) {
+        /* Reuse a buffer for the evaluated tilts. */
+        Vector<float> evaluated_tilts;
 
-      for (const int curve_index : curves_range) {
-        const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-        switch (NormalMode(normal_mode[curve_index])) {
-          case NORMAL_MODE_Z_UP:
-            curves::poly::calculate_normals_z_up(evaluated_tangents.slice(evaluated_points),
-                                                 evaluated_normals.slice(evaluated_points));
-            break;
-          case NORMAL_MODE_MINIMUM_TWIST:
-            curves::poly::calculate_normals_minimum(evaluated_tangents.slice(evaluated_points),
-                                                    cyclic[curve_index],
-                                                    evaluated_normals.slice(evaluated_points));
-            break;
-          case NORMAL_MODE_FREE:
-            if (custom_normal_span.is_empty()) {
+        for (const int curve_index : segment) {
+          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+          switch (NormalMode(normal_mode[curve_index])) {
+            case NORMAL_MODE_Z_UP:
               curves::poly::calculate_normals_z_up(evaluated_tangents.slice(evaluated_points),
                                                    evaluated_normals.slice(evaluated_points));
+              break;
+            case NORMAL_MODE_MINIMUM_TWIST:
+              curves::poly::calculate_normals_minimum(evaluated_tangents.slice(evaluated_points),
+                                                      cyclic[curve_index],
+                                                      evaluated_normals.slice(evaluated_points));
+              break;
+            case NORMAL_MODE_FREE:
+              if (custom_normal_span.is_empty()) {
+                curves::poly::calculate_normals_z_up(evaluated_tangents.slice(evaluated_points),
+                                                     evaluated_normals.slice(evaluated_points));
+              }
+              else {
+                const Span<float3> src = custom_normal_span.slice(points_by_curve[curve_index]);
+                MutableSpan<float3> dst = evaluated_normals.slice(
+                    evaluated_points_by_curve[curve_index]);
+                evaluate_generic_data_for_curve(eval_data, curve_index, src, dst);
+                normalize_span(dst);
+              }
+              break;
+          }
+
+          /* If the "tilt" attribute exists, rotate the normals around the tangents by the
+           * evaluated angles. We can avoid copying the tilts to evaluate them for poly curves. */
+          if (use_tilt) {
+            const IndexRange points = points_by_curve[curve_index];
+            if (types[curve_index] == CURVE_TYPE_POLY) {
+              rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
+                                            evaluated_tangents.slice(evaluated_points),
+                                            tilt_span.slice(points));
             }
             else {
-              const Span<float3> src = custom_normal_span.slice(points_by_curve[curve_index]);
-              MutableSpan<float3> dst = evaluated_normals.slice(
-                  evaluated_points_by_curve[curve_index]);
-              evaluate_generic_data_for_curve(eval_data, curve_index, src, dst);
-              normalize_span(dst);
+              evaluated_tilts.reinitialize(evaluated_points.size());
+              evaluate_generic_data_for_curve(eval_data,
+                                              curve_index,
+                                              tilt_span.slice(points),
+                                              evaluated_tilts.as_mutable_span());
+              rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
+                                            evaluated_tangents.slice(evaluated_points),
+                                            evaluated_tilts.as_span());
             }
-            break;
-        }
-
-        /* If the "tilt" attribute exists, rotate the normals around the tangents by the
-         * evaluated angles. We can avoid copying the tilts to evaluate them for poly curves. */
-        if (use_tilt) {
-          const IndexRange points = points_by_curve[curve_index];
-          if (types[curve_index] == CURVE_TYPE_POLY) {
-            rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
-                                          evaluated_tangents.slice(evaluated_points),
-                                          tilt_span.slice(points));
-          }
-          else {
-            evaluated_tilts.reinitialize(evaluated_points.size());
-            evaluate_generic_data_for_curve(eval_data,
-                                            curve_index,
-                                            tilt_span.slice(points),
-                                            evaluated_tilts.as_mutable_span());
-            rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
-                                          evaluated_tangents.slice(evaluated_points),
-                                          evaluated_tilts.as_span());
           }
         }
-      }
-    });
+      },
+      exec_mode::grain_size(128));
+}
+
+Span<float3> CurvesGeometry::evaluated_normals() const
+{
+  const CurvesGeometryRuntime &runtime = *this->runtime;
+  this->ensure_nurbs_basis_cache();
+  runtime.evaluated_normal_cache.ensure([&](Vector<float3> &r_data) {
+    r_data.resize(this->evaluated_points_num());
+    this->calculate_evaluated_normals(this->curves_range(), r_data);
   });
   return this->runtime->evaluated_normal_cache.data();
 }
@@ -1174,30 +1190,34 @@ void CurvesGeometry::interpolate_to_evaluated(const GSpan src, GMutableSpan dst)
   });
 }
 
-void CurvesGeometry::ensure_evaluated_lengths() const
+void CurvesGeometry::calculate_evaluated_lengths(const IndexMask &curve_mask,
+                                                 MutableSpan<float> evaluated_lengths) const
 {
-  const CurvesGeometryRuntime &runtime = *this->runtime;
-  runtime.evaluated_length_cache.ensure([&](Vector<float> &r_data) {
-    /* Use an extra length value for the final cyclic segment for a consistent size
-     * (see comment on #evaluated_length_cache). */
-    const int total_num = this->evaluated_points_num() + this->curves_num();
-    r_data.resize(total_num);
-    MutableSpan<float> evaluated_lengths = r_data;
-
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const Span<float3> evaluated_positions = this->evaluated_positions();
-    const VArray<bool> curves_cyclic = this->cyclic();
+  const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
+  const Span<float3> evaluated_positions = this->evaluated_positions();
+  const VArray<bool> curves_cyclic = this->cyclic();
 
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      for (const int curve_index : curves_range) {
+  curve_mask.foreach_index(
+      [&](const int curve_index) {
         const bool cyclic = curves_cyclic[curve_index];
         const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
         const IndexRange lengths_range = this->lengths_range_for_curve(curve_index, cyclic);
         length_parameterize::accumulate_lengths(evaluated_positions.slice(evaluated_points),
                                                 cyclic,
                                                 evaluated_lengths.slice(lengths_range));
-      }
-    });
+      },
+      exec_mode::grain_size(128));
+}
+
+void CurvesGeometry::ensure_evaluated_lengths() const
+{
+  const CurvesGeometryRuntime &runtime = *this->runtime;
+  runtime.evaluated_length_cache.ensure([&](Vector<float> &r_data) {
+    /* Use an extra length value for the final cyclic segment for a consistent size
+     * (see comment on #evaluated_length_cache). */
+    const int total_num = this->evaluated_points_num() + this->curves_num();
+    r_data.resize(total_num);
+    this->calculate_evaluated_lengths(this->curves_range(), r_data);
   });
 }
 
@@ -1246,6 +1266,58 @@ void CurvesGeometry::tag_positions_changed()
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->bounds_with_radius_cache.tag_dirty();
 }
+
+void CurvesGeometry::tag_positions_changed(const IndexMask &changed_curves)
+{
+  if (changed_curves.is_empty()) {
+    return;
+  }
+  /* Updating the caches partially only pays off when few curves changed. */
+  if (changed_curves.size() > this->curves_num() / 2) {
+    this->tag_positions_changed();
+    return;
+  }
+  CurvesGeometryRuntime &runtime = *this->runtime;
+  runtime.bounds_cache.tag_dirty();
+  runtime.bounds_with_radius_cache.tag_dirty();
+
+  if (this->is_single_type(CURVE_TYPE_POLY)) {
+    /* The evaluated positions are the positions attribute itself, there is nothing to update. */
+  }
+  else if (runtime.evaluated_position_cache.is_cached()) {
+    this->ensure_nurbs_basis_cache();
+    runtime.evaluated_position_cache.update([&](Vector<float3> &r_data) {
+      this->calculate_evaluated_positions(changed_curves, r_data);
+    });
+  }
+  else {
+    this->tag_positions_changed();
+    return;
+  }
+
+  /* Only update caches that are still valid, the others are rebuilt on the next access anyway.
+   * The normals depend on the tangents, so they can only be updated if the tangents are. */
+  const bool tangents_cached = runtime.evaluated_tangent_cache.is_cached();
+  if (tangents_cached) {
+    runtime.evaluated_tangent_cache.update([&](Vector<float3> &r_data) {
+      this->calculate_evaluated_tangents(changed_curves, r_data);
+    });
+  }
+  if (tangents_cached && runtime.evaluated_normal_cache.is_cached()) {
+    runtime.evaluated_normal_cache.update([&](Vector<float3> &r_data) {
+      this->calculate_evaluated_normals(changed_curves, r_data);
+    });
+  }
+  else {
+    runtime.evaluated_normal_cache.tag_dirty();
+  }
+  if (runtime.evaluated_length_cache.is_cached()) {
+    runtime.evaluated_length_cache.update([&](Vector<float> &r_data) {
+      this->calculate_evaluated_lengths(changed_curves, r_data);
+    });
+  }
+}
+
 void CurvesGeometry::tag_topology_changed()
 {
   this->runtime->custom_knot_offsets_cache.tag_dirty();
@@ -693,6 +693,92 @@ TEST(curves_geometry, BasisCacheNonUniformDeg2)
   EXPECT_NEAR_SPAN<float>(expectation, cache.weights, EPSILON_FLT32);
 }
 
+/* Curves of different types, lengths and cyclic states, so that the evaluated points of the
+ * curves have different sizes and offsets. */
+static CurvesGeometry create_mixed_curves()
+{
+  const int curves_num = 12;
+  Array<int> offsets(curves_num + 1);
+  offsets[0] = 0;
+  for (const int i : IndexRange(curves_num)) {
+    offsets[i + 1] = offsets[i] + 4 + i % 3;
+  }
+
+  CurvesGeometry curves(offsets.last(), curves_num);
+  curves.offsets_for_write().copy_from(offsets);
+  MutableSpan<int8_t> types = curves.curve_types_for_write();
+  const CurveType type_cycle[3] = {CURVE_TYPE_CATMULL_ROM, CURVE_TYPE_NURBS, CURVE_TYPE_POLY};
+  for (const int i : curves.curves_range()) {
+    types[i] = type_cycle[i % 3];
+    curves.cyclic_for_write()[i] = i % 4 == 0;
+  }
+  curves.update_curve_types();
+  curves.resolution_for_write().fill(6);
+
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int i : curves.points_range()) {
+    positions[i] = {float(i) * 0.5f, std::sin(float(i)), std::cos(float(i) * 0.7f)};
+  }
+  return curves;
+}
+
+static void deform_curves(CurvesGeometry &curves, const IndexMask &curve_mask)
+{
+  const OffsetIndices points_by_curve = curves.points_by_curve();
+  MutableSpan<float3> positions = curves.positions_for_write();
+  curve_mask.foreach_index([&](const int curve) {
+    for (const int point : points_by_curve[curve]) {
+      positions[point] += float3(0.1f * point, -0.2f, 0.3f * std::sin(float(point)));
+    }
+  });
+}
+
+TEST(curves_geometry, PartialPositionUpdate)
+{
+  CurvesGeometry curves = create_mixed_curves();
+  /* Compute all evaluated data, so that the partial update recomputes it for the changed curves
+   * only. */
+  curves.evaluated_normals();
+  curves.ensure_evaluated_lengths();
+
+  IndexMaskMemory memory;
+  const IndexMask changed_curves = IndexMask::from_indices<int>({1, 2, 6, 10}, memory);
+  deform_curves(curves, changed_curves);
+  curves.tag_positions_changed(changed_curves);
+
+  /* The same curves evaluated from scratch. */
+  CurvesGeometry expected = create_mixed_curves();
+  deform_curves(expected, changed_curves);
+
+  const Span<float3> positions = curves.evaluated_positions();
+  const Span<float3> expected_positions = expected.evaluated_positions();
+  ASSERT_EQ(positions.size(), expected_positions.size());
+  for (const int i : positions.index_range()) {
+    EXPECT_V3_NEAR(positions[i], expected_positions[i], EPSILON_FLT32);
+  }
+
+  const Span<float3> tangents = curves.evaluated_tangents();
+  const Span<float3> expected_tangents = expected.evaluated_tangents();
+  for (const int i : tangents.index_range()) {
+    EXPECT_V3_NEAR(tangents[i], expected_tangents[i], EPSILON_FLT32);
+  }
+
+  const Span<float3> normals = curves.evaluated_normals();
+  const Span<float3> expected_normals = expected.evaluated_normals();
+  for (const int i : normals.index_range()) {
+    EXPECT_V3_NEAR(normals[i], expected_normals[i], EPSILON_FLT32);
+  }
+
+  curves.ensure_evaluated_lengths();
+  expected.ensure_evaluated_lengths();
+  const VArray<bool> cyclic = curves.cyclic();
+  for (const int curve : curves.curves_range()) {
+    EXPECT_NEAR_SPAN<float>(expected.evaluated_lengths_for_curve(curve, cyclic[curve]),
+                            curves.evaluated_lengths_for_curve(curve, cyclic[curve]),
+                            1e-5f);
+  }
+}
+
 /** \} */
 
 TEST(knot_vector, KnotVectorUniform)
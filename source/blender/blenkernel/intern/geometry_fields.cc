@@ -3,20 +3,26 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_array_utils.hh"
+#include "BLI_listbase.h"
 
 #include "BKE_attribute.hh"
+#include "BKE_attribute_storage.hh"
 #include "BKE_curves.hh"
 #include "BKE_geometry_fields.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_grease_pencil.hh"
 #include "BKE_instances.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
 
 #include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
 #include "DNA_pointcloud_types.h"
 
 #include "BLT_translation.hh"
 
+#include "FN_field_result_cache.hh"
+
 #include <fmt/format.h>
 
 namespace blender {
@@ -29,6 +35,59 @@ MeshFieldContext::MeshFieldContext(const Mesh &mesh, const AttrDomain domain)
   BLI_assert(mesh.attributes().domain_supported(domain_));
 }
 
+/**
+ * Fields may read any attribute and the topology of the mesh, so the state includes all of its
+ * data arrays. Derived data like normals is computed from those arrays. Attributes are looked up
+ * by name, so their names, domains and types are part of the state as well, otherwise a renamed
+ * attribute could be mistaken for the one that previously had its name.
+ */
+static bool mesh_field_result_cache_state(const Mesh &mesh,
+                                          const AttrDomain domain,
+                                          fn::FieldResultCacheState &r_state)
+{
+  if (mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+    return false;
+  }
+  r_state.add_value(int64_t(domain));
+  r_state.add_value(mesh.verts_num);
+  r_state.add_value(mesh.edges_num);
+  r_state.add_value(mesh.faces_num);
+  r_state.add_value(mesh.corners_num);
+  if (mesh.face_offset_indices) {
+    r_state.add_data(mesh.runtime->face_offsets_sharing_info);
+  }
+  for (const CustomData *data :
+       {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+  {
+    for (const CustomDataLayer &layer : Span(data->layers, data->totlayer)) {
+      if (layer.data) {
+        r_state.add_name(layer.name);
+        r_state.add_value(layer.type);
+        r_state.add_data(layer.sharing_info);
+      }
+    }
+  }
+  const AttributeStorage &storage = mesh.attribute_storage.wrap();
+  for (const int i : IndexRange(storage.count())) {
+    const Attribute &attribute = storage.at_index(i);
+    r_state.add_name(attribute.name());
+    r_state.add_value(int64_t(attribute.domain()));
+    r_state.add_value(int64_t(attribute.data_type()));
+    std::visit([&](const auto &data) { r_state.add_data(data.sharing_info.get()); },
+               attribute.data());
+  }
+  /* Vertex group names map to the weights in the deform vertices. */
+  for (const bDeformGroup &group : mesh.vertex_group_names) {
+    r_state.add_name(group.name);
+  }
+  return r_state.is_valid();
+}
+
+bool MeshFieldContext::result_cache_state(fn::FieldResultCacheState &r_state) const
+{
+  return mesh_field_result_cache_state(mesh_, domain_, r_state);
+}
+
 CurvesFieldContext::CurvesFieldContext(const CurvesGeometry &curves, const AttrDomain domain)
     : curves_(curves), domain_(domain)
 {
@@ -200,6 +259,14 @@ std::optional<AttributeAccessor> GeometryFieldContext::attributes() const
   return {};
 }
 
+bool GeometryFieldContext::result_cache_state(fn::FieldResultCacheState &r_state) const
+{
+  if (const Mesh *mesh = this->mesh()) {
+    return mesh_field_result_cache_state(*mesh, domain_, r_state);
+  }
+  return false;
+}
+
 const Mesh *GeometryFieldContext::mesh() const
 {
   return this->type() == GeometryComponent::Type::Mesh ? static_cast<const Mesh *>(geometry_) :
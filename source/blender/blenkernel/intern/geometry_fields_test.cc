@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BKE_attribute.hh"
+#include "BKE_geometry_fields.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+
+#include "FN_field_result_cache.hh"
+#include "FN_multi_function_builder.hh"
+
+namespace blender::bke::tests {
+
+class MeshFieldResultCacheTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+};
+
+TEST_F(MeshFieldResultCacheTest, RenamedAttribute)
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 0, 0, 0);
+  MutableAttributeAccessor attributes = mesh->attributes_for_write();
+  attributes.add<float>(
+      "a", AttrDomain::Point, AttributeInitVArray(VArray<float>::from_single(1.0f, 4)));
+  attributes.add<float>(
+      "b", AttrDomain::Point, AttributeInitVArray(VArray<float>::from_single(2.0f, 4)));
+
+  /* Results are only cached for shared data, which can't be changed in place. */
+  Mesh *mesh_eval = BKE_mesh_copy_for_eval(*mesh);
+
+  int calls_num = 0;
+  auto add_fn = mf::build::SI1_SO<float, float>("add one", [&](const float a) {
+    calls_num++;
+    return a + 1.0f;
+  });
+  const fn::Field<float> field{
+      fn::FieldOperation::from(add_fn, {AttributeFieldInput::from<float>("a")}), 0};
+
+  const auto evaluate = [&]() {
+    const MeshFieldContext context{*mesh_eval, AttrDomain::Point};
+    fn::FieldEvaluator evaluator{context, mesh_eval->verts_num};
+    evaluator.add(field);
+    evaluator.evaluate();
+    return evaluator.get_evaluated<float>(0)[0];
+  };
+
+  EXPECT_EQ(evaluate(), 2.0f);
+  EXPECT_EQ(evaluate(), 2.0f);
+  EXPECT_EQ(calls_num, 4);
+
+  /* The arrays are unchanged, but the field now reads the data that was called "b" before. */
+  MutableAttributeAccessor attributes_eval = mesh_eval->attributes_for_write();
+  attributes_eval.rename("a", "c");
+  attributes_eval.rename("b", "a");
+  EXPECT_EQ(evaluate(), 3.0f);
+  EXPECT_EQ(calls_num, 8);
+
+  BKE_id_free(nullptr, mesh_eval);
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
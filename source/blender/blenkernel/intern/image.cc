@@ -4177,6 +4177,41 @@ static ImBuf *image_load_movie_file(Image *ima, ImageUser *iuser, int frame)
   return ibuf;
 }
 
+/* Number of upcoming frames of image sequences that are loaded in the background. */
+static constexpr int image_sequence_prefetch_frames = 4;
+
+/**
+ * When frames of an image sequence are loaded one after the other, as happens during playback,
+ * start loading the next frames in the same direction in the background, so they are decoded by
+ * the time they are needed.
+ */
+static void image_sequence_prefetch(Image *ima,
+                                    const ImageUser &iuser,
+                                    const int cfra,
+                                    const int flag)
+{
+  const int last_frame = ima->runtime->last_loaded_frame;
+  ima->runtime->last_loaded_frame = cfra;
+  if (last_frame == IMAGE_GPU_FRAME_NONE || abs(cfra - last_frame) != 1) {
+    return;
+  }
+  const int direction = cfra - last_frame;
+
+  for (int i = 1; i <= image_sequence_prefetch_frames; i++) {
+    const int frame = cfra + i * direction;
+    if (ImBuf *ibuf = image_get_cached_ibuf_for_index_entry(ima, 0, frame, nullptr)) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+
+    ImageUser iuser_frame = iuser;
+    iuser_frame.framenr = frame;
+    char filepath[FILE_MAX];
+    BKE_image_user_file_path(&iuser_frame, ima, filepath);
+    IMB_prefetch_image_from_filepath(filepath, flag, ima->colorspace_settings.name);
+  }
+}
+
 static ImBuf *load_image_single(Image *ima,
                                 ImageUser *iuser,
                                 int cfra,
@@ -4232,6 +4267,10 @@ static ImBuf *load_image_single(Image *ima,
 
     BKE_image_user_file_path(&iuser_t, ima, filepath);
 
+    if (is_sequence && !BKE_image_is_multiview(ima)) {
+      image_sequence_prefetch(ima, iuser_t, cfra, flag);
+    }
+
     /* read ibuf */
     ibuf = IMB_load_image_from_filepath(filepath, flag, ima->colorspace_settings.name);
   }
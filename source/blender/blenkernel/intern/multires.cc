@@ -318,8 +318,10 @@ void multires_flush_sculpt_updates(Object *object)
     return;
   }
 
-  multiresModifier_reshapeFromCCG(
-      sculpt_session->multires_modifier->totlvl, mesh, sculpt_session->subdiv_ccg);
+  multiresModifier_reshapeFromCCG(sculpt_session->multires_modifier->totlvl,
+                                  mesh,
+                                  sculpt_session->subdiv_ccg,
+                                  mmd->flags & eMultiresModifierFlag_UseHalfPrecisionReshape);
 
   subdiv_ccg->dirty.coords = false;
   subdiv_ccg->dirty.hidden = false;
@@ -546,7 +548,7 @@ void multiresModifier_del_levels(MultiresModifierData *mmd,
   multires_set_tot_level(ob, mmd, lvl);
 }
 
-void multires_stitch_grids(Object *ob)
+void multires_stitch_grids(Object *ob, const IndexMask &face_mask)
 {
   if (ob == nullptr) {
     return;
@@ -561,7 +563,7 @@ void multires_stitch_grids(Object *ob)
   }
   BLI_assert(bke::object::pbvh_get(*ob) &&
              bke::object::pbvh_get(*ob)->type() == bke::pbvh::Type::Grids);
-  BKE_subdiv_ccg_average_stitch_faces(*subdiv_ccg, IndexMask(subdiv_ccg->faces.size()));
+  BKE_subdiv_ccg_average_stitch_faces(*subdiv_ccg, face_mask);
 }
 
 void old_mdisps_bilinear(float out[3], float (*disps)[3], const int st, float u, float v)
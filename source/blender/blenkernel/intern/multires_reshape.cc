@@ -110,7 +110,10 @@ bool multiresModifier_reshapeFromDeformModifier(Depsgraph *depsgraph,
 /** \name Reshape from grids
  * \{ */
 
-bool multiresModifier_reshapeFromCCG(const int tot_level, Mesh *coarse_mesh, SubdivCCG *subdiv_ccg)
+bool multiresModifier_reshapeFromCCG(const int tot_level,
+                                     Mesh *coarse_mesh,
+                                     SubdivCCG *subdiv_ccg,
+                                     const bool use_half_precision_orig)
 {
   MultiresReshapeContext reshape_context;
   if (!multires_reshape_context_create_from_ccg(
@@ -118,6 +121,7 @@ bool multiresModifier_reshapeFromCCG(const int tot_level, Mesh *coarse_mesh, Sub
   {
     return false;
   }
+  reshape_context.use_half_precision_orig = use_half_precision_orig;
 
   multires_ensure_external_read(coarse_mesh, reshape_context.top.level);
 
@@ -71,10 +71,20 @@ struct MultiresReshapeContext {
     int grid_size;
   } top;
 
+  /* Store the copy of the original displacement in half precision, see
+   * #eMultiresModifierFlag_UseHalfPrecisionReshape. */
+  bool use_half_precision_orig;
+
   struct {
     /* Copy of original displacement and painting masks. */
     MDisps *mdisps;
     GridPaintMask *grid_paint_masks;
+
+    /* Original displacement in half precision, used instead of the data of #mdisps when
+     * #use_half_precision_orig is enabled. The displacement is in the tangent space of the limit
+     * surface, so it stays small and only needs few bits of precision. Indexed by grid index,
+     * with three values per grid element. Empty for grids which have no displacement. */
+    Array<Array<uint16_t>> half_displacement;
   } orig;
 
   /* Number of grids which are required for base_mesh. */
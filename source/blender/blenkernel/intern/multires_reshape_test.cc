@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_subdiv.hh"
+
+#include "DNA_meshdata_types.h"
+
+#include "multires_reshape.hh"
+
+namespace blender::bke::tests {
+
+/* Level of the displacement grid of the first face, the second grid has no displacement. */
+static constexpr int test_grid_level = 4;
+
+static float3 test_displacement(const int element)
+{
+  /* Magnitudes as they appear in the tangent space of sculpted meshes, from fine detail to large
+   * deformations, with both signs. */
+  const float scale = std::pow(10.0f, float(element % 5) - 2.0f);
+  return float3(0.3f + element, -1.7f * element, 0.01f * (element % 5) - 0.02f) * scale;
+}
+
+static MDisps *create_test_mdisps()
+{
+  MDisps *mdisps = MEM_new_array_zeroed<MDisps>(2, __func__);
+  const int grid_size = subdiv::grid_size_from_level(test_grid_level);
+  mdisps[0].level = test_grid_level;
+  mdisps[0].totdisp = grid_size * grid_size;
+  mdisps[0].disps = MEM_new_array_zeroed<float[3]>(mdisps[0].totdisp, __func__);
+  for (const int element : IndexRange(mdisps[0].totdisp)) {
+    copy_v3_v3(mdisps[0].disps[element], test_displacement(element));
+  }
+  mdisps[1].level = test_grid_level;
+  return mdisps;
+}
+
+static void free_test_mdisps(MDisps *mdisps)
+{
+  MEM_SAFE_DELETE(mdisps[0].disps);
+  MEM_delete(mdisps);
+}
+
+/**
+ * Store the original grids, overwrite the source displacement like reshaping does, and check
+ * that the stored displacement is read back within the given relative error.
+ */
+static void test_original_grids_round_trip(const bool use_half_precision_orig,
+                                           const float max_relative_error)
+{
+  MDisps *mdisps = create_test_mdisps();
+
+  MultiresReshapeContext reshape_context = {};
+  reshape_context.num_grids = 2;
+  reshape_context.mdisps = mdisps;
+  reshape_context.use_half_precision_orig = use_half_precision_orig;
+  multires_reshape_store_original_grids(&reshape_context);
+  EXPECT_EQ(reshape_context.orig.half_displacement.is_empty(), !use_half_precision_orig);
+
+  for (const int element : IndexRange(mdisps[0].totdisp)) {
+    copy_v3_fl(mdisps[0].disps[element], 1000.0f);
+  }
+
+  const int grid_size = subdiv::grid_size_from_level(test_grid_level);
+  for (const int y : IndexRange(grid_size)) {
+    for (const int x : IndexRange(grid_size)) {
+      const GridCoord grid_coord = {
+          0, float(x) / float(grid_size - 1), float(y) / float(grid_size - 1)};
+      const ReshapeConstGridElement grid_element =
+          multires_reshape_orig_grid_element_for_grid_coord(&reshape_context, &grid_coord);
+      const float3 expected = test_displacement(y * grid_size + x);
+      for (const int axis : IndexRange(3)) {
+        EXPECT_NEAR(grid_element.displacement[axis],
+                    expected[axis],
+                    math::abs(expected[axis]) * max_relative_error);
+      }
+    }
+  }
+
+  /* Grids without displacement read as zero displacement. */
+  const GridCoord empty_grid_coord = {1, 0.5f, 0.5f};
+  const ReshapeConstGridElement empty_grid_element =
+      multires_reshape_orig_grid_element_for_grid_coord(&reshape_context, &empty_grid_coord);
+  EXPECT_EQ(empty_grid_element.displacement, float3(0.0f));
+
+  multires_reshape_free_original_grids(&reshape_context);
+  EXPECT_TRUE(reshape_context.orig.half_displacement.is_empty());
+  free_test_mdisps(mdisps);
+}
+
+TEST(multires_reshape, OriginalGridsFullPrecision)
+{
+  test_original_grids_round_trip(false, 0.0f);
+}
+
+TEST(multires_reshape, OriginalGridsHalfPrecision)
+{
+  /* Half floats have 11 significant bits. All test values are in the range of normal half
+   * floats, so rounding gives a relative error of at most 2^-11. */
+  test_original_grids_round_trip(true, 1.0f / 2048.0f);
+}
+
+}  // namespace blender::bke::tests
@@ -16,10 +16,12 @@
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_math_half.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -120,6 +122,11 @@ static void context_init_common(MultiresReshapeContext *reshape_context)
 
   reshape_context->face_ptex_offset = bke::subdiv::face_ptex_offset_get(reshape_context->subdiv);
 
+  if (reshape_context->mmd != nullptr) {
+    reshape_context->use_half_precision_orig = reshape_context->mmd->flags &
+                                               eMultiresModifierFlag_UseHalfPrecisionReshape;
+  }
+
   context_init_lookup(reshape_context);
   context_init_grid_pointers(reshape_context);
 }
@@ -339,6 +346,7 @@ void multires_reshape_free_original_grids(MultiresReshapeContext *reshape_contex
 
   MEM_SAFE_DELETE(orig_mdisps);
   MEM_SAFE_DELETE(orig_grid_paint_masks);
+  reshape_context->orig.half_displacement = {};
 
   reshape_context->orig.mdisps = nullptr;
   reshape_context->orig.grid_paint_masks = nullptr;
@@ -502,12 +510,22 @@ ReshapeConstGridElement multires_reshape_orig_grid_element_for_grid_coord(
   const MDisps *mdisps = reshape_context->orig.mdisps;
   if (mdisps != nullptr) {
     const MDisps *displacement_grid = &mdisps[grid_coord->grid_index];
-    if (displacement_grid->disps != nullptr) {
+    const Span<Array<uint16_t>> half_displacement = reshape_context->orig.half_displacement;
+    const Span<uint16_t> half_grid = half_displacement.is_empty() ?
+                                         Span<uint16_t>() :
+                                         half_displacement[grid_coord->grid_index].as_span();
+    if (displacement_grid->disps != nullptr || !half_grid.is_empty()) {
       const int grid_size = bke::subdiv::grid_size_from_level(displacement_grid->level);
       const int grid_x = lround(grid_coord->u * (grid_size - 1));
       const int grid_y = lround(grid_coord->v * (grid_size - 1));
       const int grid_element_index = grid_y * grid_size + grid_x;
-      grid_element.displacement = displacement_grid->disps[grid_element_index];
+      if (half_grid.is_empty()) {
+        grid_element.displacement = displacement_grid->disps[grid_element_index];
+      }
+      else {
+        math::half_to_float_array(
+            &half_grid[grid_element_index * 3], &grid_element.displacement.x, 3);
+      }
     }
   }
 
@@ -638,6 +656,28 @@ void multires_reshape_store_original_grids(MultiresReshapeContext *reshape_conte
   }
 
   const int num_grids = reshape_context->num_grids;
+  if (reshape_context->use_half_precision_orig) {
+    /* Only the grid levels are kept in the original #MDisps, the displacement itself is stored in
+     * half precision. This halves the memory of the copy, which otherwise is as big as the
+     * displacement of the whole mesh. The copy only lives while reshaping, the displacement that
+     * is written to the mesh keeps full precision. */
+    Array<Array<uint16_t>> &half_displacement = reshape_context->orig.half_displacement;
+    half_displacement.reinitialize(num_grids);
+    threading::parallel_for(IndexRange(num_grids), 256, [&](const IndexRange range) {
+      for (const int grid_index : range) {
+        MDisps *orig_grid = &orig_mdisps[grid_index];
+        if (orig_grid->disps == nullptr) {
+          continue;
+        }
+        half_displacement[grid_index].reinitialize(orig_grid->totdisp * 3);
+        math::float_to_half_make_finite_array(&orig_grid->disps[0][0],
+                                              half_displacement[grid_index].data(),
+                                              orig_grid->totdisp * 3);
+        orig_grid->disps = nullptr;
+      }
+    });
+  }
+
   for (int grid_index = 0; grid_index < num_grids; grid_index++) {
     MDisps *orig_grid = &orig_mdisps[grid_index];
     /* Ignore possibly invalid/non-allocated original grids. They will be replaced with 0 original
@@ -14,8 +14,10 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 #include "BKE_paint_bvh.hh"
@@ -890,46 +892,87 @@ static void short_edge_queue_edge_add(const EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+/** Return true if the edges of the face are to be considered for the queue. */
+static bool edge_queue_face_in_range(const EdgeQueue *queue, BMFace *f)
 {
-  if (eq_ctx->queue->use_front_face) {
-    if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
-      return;
+  if (queue->use_front_face) {
+    if (dot_v3v3(f->no, *queue->view_normal) < 0.0f) {
+      return false;
     }
   }
 
-  if (eq_ctx->queue->edge_queue_tri_in_range(eq_ctx->queue, f)) {
-    /* Check each edge of the face. */
-    const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    const BMLoop *l_iter = l_first;
-    do {
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->queue->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->queue->limit_len);
+  return queue->edge_queue_tri_in_range(queue, f);
+}
+
+/**
+ * Gather faces of the leaf nodes marked for topology update which are in range of the queue.
+ *
+ * On dense meshes testing the faces against the brush is the most expensive part of the queue
+ * creation, so the nodes are tested in parallel. The faces are returned in node order, so that
+ * the resulting queue does not depend on the number of threads.
+ */
+static Vector<BMFace *> edge_queue_faces_in_range(const EdgeQueue *queue,
+                                                  MutableSpan<BMeshNode> nodes)
+{
+  Vector<int> node_indices;
+  for (const int i : nodes.index_range()) {
+    const BMeshNode &node = nodes[i];
+    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
+        !(node.flag_ & Node::FullyHidden))
+    {
+      node_indices.append(i);
+    }
+  }
+
+  Array<Vector<BMFace *>> node_faces(node_indices.size());
+  threading::parallel_for(node_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : nodes[node_indices[i]].bm_faces_) {
+        if (edge_queue_face_in_range(queue, f)) {
+          node_faces[i].append(f);
+        }
       }
-    } while ((l_iter = l_iter->next) != l_first);
+    }
+  });
+
+  Vector<BMFace *> faces;
+  for (const Vector<BMFace *> &node_faces_in_range : node_faces) {
+    faces.extend(node_faces_in_range);
   }
+  return faces;
 }
 
-static void short_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+static void long_edge_queue_face_edges_add(const EdgeQueueContext *eq_ctx, BMFace *f)
 {
-  if (eq_ctx->queue->use_front_face) {
-    if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
-      return;
+  /* Check each edge of the face. */
+  const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  const BMLoop *l_iter = l_first;
+  do {
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->queue->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->queue->limit_len);
     }
-  }
+  } while ((l_iter = l_iter->next) != l_first);
+}
 
-  if (eq_ctx->queue->edge_queue_tri_in_range(eq_ctx->queue, f)) {
-    /* Check each edge of the face. */
-    const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    const BMLoop *l_iter = l_first;
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
+static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  if (edge_queue_face_in_range(eq_ctx->queue, f)) {
+    long_edge_queue_face_edges_add(eq_ctx, f);
   }
 }
 
+static void short_edge_queue_face_edges_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  /* Check each edge of the face. */
+  const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  const BMLoop *l_iter = l_first;
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
 /**
  * Create a priority queue containing vertex pairs connected by a long
  * edge as defined by Tree.bm_max_edge_len.
@@ -971,15 +1014,8 @@ static void long_edge_queue_create(const EdgeQueueContext *eq_ctx,
     eq_ctx->queue->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  for (BMFace *f : edge_queue_faces_in_range(eq_ctx->queue, nodes)) {
+    long_edge_queue_face_edges_add(eq_ctx, f);
   }
 }
 
@@ -1024,15 +1060,8 @@ static void short_edge_queue_create(const EdgeQueueContext *eq_ctx,
     eq_ctx->queue->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  for (BMFace *f : edge_queue_faces_in_range(eq_ctx->queue, nodes)) {
+    short_edge_queue_face_edges_add(eq_ctx, f);
   }
 }
 
@@ -867,10 +867,14 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG &subdiv_ccg, const IndexMask
         subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, subdiv_ccg.faces[face_index]);
       },
       exec_mode::grain_size(512));
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+  if (face_mask.size() == subdiv_ccg.faces.size()) {
+    subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
+    subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+  }
+  else {
+    /* Only average elements which are adjacent to modified faces. */
+    subdiv_ccg_average_faces_boundaries_and_corners(subdiv_ccg, key, face_mask);
+  }
 #else
   UNUSED_VARS(subdiv_ccg, face_mask);
 #endif
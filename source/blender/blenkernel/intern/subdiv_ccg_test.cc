@@ -4,9 +4,19 @@
 
 #include "testing/testing.h"
 
+#include "BLI_index_mask.hh"
+
 #include "BKE_ccg.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+#include "BKE_subdiv.hh"
 #include "BKE_subdiv_ccg.hh"
 
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+
 namespace blender::bke::tests {
 TEST(subdiv_ccg_coord, to_index)
 {
@@ -59,4 +69,109 @@ TEST(subdiv_ccg_coord, constructor)
   EXPECT_EQ(coord.x, 1);
   EXPECT_EQ(coord.y, 1);
 }
+
+#ifdef WITH_OPENSUBDIV
+
+class SubdivCCGStitchTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+};
+
+/** Flat grid of 3x3 quads, face 4 is the only face without boundary edges. */
+static Mesh *create_quad_grid_mesh()
+{
+  const int verts_x = 4;
+  Mesh *mesh = BKE_mesh_new_nomain(verts_x * verts_x, 0, 9, 9 * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(verts_x)) {
+    for (const int x : IndexRange(verts_x)) {
+      positions[y * verts_x + x] = float3(x, y, 0.0f);
+    }
+  }
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(3)) {
+    for (const int x : IndexRange(3)) {
+      const int face = y * 3 + x;
+      const int vert = y * verts_x + x;
+      face_offsets[face] = face * 4;
+      corner_verts[face * 4 + 0] = vert;
+      corner_verts[face * 4 + 1] = vert + 1;
+      corner_verts[face * 4 + 2] = vert + verts_x + 1;
+      corner_verts[face * 4 + 3] = vert + verts_x;
+    }
+  }
+  mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+static std::unique_ptr<SubdivCCG> create_subdiv_ccg(const Mesh &mesh, const int level)
+{
+  subdiv::Settings settings{};
+  settings.is_simple = false;
+  settings.is_adaptive = false;
+  settings.level = level;
+  settings.use_creases = false;
+  settings.vtx_boundary_interpolation = subdiv::SUBDIV_VTX_BOUNDARY_EDGE_ONLY;
+  settings.fvar_linear_interpolation = subdiv::SUBDIV_FVAR_LINEAR_INTERPOLATION_ALL;
+  subdiv::Subdiv *subdiv = subdiv::new_from_mesh(&settings, &mesh);
+
+  SubdivToCCGSettings ccg_settings{};
+  ccg_settings.resolution = (1 << level) + 1;
+  ccg_settings.need_normal = false;
+  ccg_settings.need_mask = false;
+  return BKE_subdiv_to_ccg(*subdiv, ccg_settings, mesh);
+}
+
+/** Move the grid elements of a face by different amounts, tearing its grids apart. */
+static void tear_face_grids(SubdivCCG &subdiv_ccg, const int face)
+{
+  for (const int grid : subdiv_ccg.faces[face]) {
+    for (const int i : IndexRange(subdiv_ccg.grid_area)) {
+      const int element = grid * subdiv_ccg.grid_area + i;
+      subdiv_ccg.positions[element].z += 0.01f * float((grid + 1) * (i % 7 + 1));
+    }
+  }
+}
+
+TEST_F(SubdivCCGStitchTest, stitch_face_subset_matches_all_faces)
+{
+  Mesh *mesh = create_quad_grid_mesh();
+  std::unique_ptr<SubdivCCG> subdiv_ccg_all = create_subdiv_ccg(*mesh, 3);
+  std::unique_ptr<SubdivCCG> subdiv_ccg_subset = create_subdiv_ccg(*mesh, 3);
+  ASSERT_NE(subdiv_ccg_all, nullptr);
+  ASSERT_NE(subdiv_ccg_subset, nullptr);
+  ASSERT_EQ(subdiv_ccg_all->positions.size(), subdiv_ccg_subset->positions.size());
+
+  const int torn_face = 4;
+  tear_face_grids(*subdiv_ccg_all, torn_face);
+  tear_face_grids(*subdiv_ccg_subset, torn_face);
+
+  BKE_subdiv_ccg_average_stitch_faces(*subdiv_ccg_all, IndexMask(subdiv_ccg_all->faces.size()));
+  BKE_subdiv_ccg_average_stitch_faces(*subdiv_ccg_subset, IndexRange(torn_face, 1));
+
+  const Span<float3> positions_all = subdiv_ccg_all->positions;
+  const Span<float3> positions_subset = subdiv_ccg_subset->positions;
+  for (const int i : positions_all.index_range()) {
+    EXPECT_NEAR(positions_all[i].x, positions_subset[i].x, 1e-6f);
+    EXPECT_NEAR(positions_all[i].y, positions_subset[i].y, 1e-6f);
+    EXPECT_NEAR(positions_all[i].z, positions_subset[i].z, 1e-6f);
+  }
+
+  subdiv_ccg_all.reset();
+  subdiv_ccg_subset.reset();
+  BKE_id_free(nullptr, mesh);
+}
+
+#endif
+
 }  // namespace blender::bke::tests
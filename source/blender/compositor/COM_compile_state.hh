@@ -6,6 +6,7 @@
 
 #include <optional>
 
+#include "BLI_bounds_types.hh"
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_vector_set.hh"
@@ -14,6 +15,7 @@
 #include "COM_domain.hh"
 #include "COM_node_operation.hh"
 #include "COM_pixel_operation.hh"
+#include "COM_region_of_interest.hh"
 
 namespace blender::compositor {
 
@@ -138,10 +140,16 @@ class CompileState {
   /* The domain of the pixel compile unit if it was not a single value. Only initialized when the
    * pixel compile unit is not empty and is not a single value. */
   std::optional<Domain> pixel_compile_unit_domain_;
+  /* The regions of interest of the nodes in the schedule. See COM_region_of_interest.hh for more
+   * information. */
+  RegionsOfInterest regions_of_interest_;
 
  public:
-  /* Construct a compile state from the node group execution schedule being compiled. */
-  CompileState(const Context &context, const VectorSet<const bNode *> &schedule);
+  /* Construct a compile state from the node group execution schedule being compiled and the
+   * regions of interest of its nodes. */
+  CompileState(const Context &context,
+               const VectorSet<const bNode *> &schedule,
+               RegionsOfInterest regions_of_interest);
 
   /* Get a reference to the node execution schedule being compiled. */
   const VectorSet<const bNode *> &get_schedule();
@@ -173,6 +181,10 @@ class CompileState {
    * track the next potential compile unit. */
   void reset_pixel_compile_unit();
 
+  /* Returns the region of interest of the pixel compile unit, which is the union of the regions of
+   * interest of its nodes, or nullopt if any of its nodes needs its outputs entirely. */
+  std::optional<Bounds<int2>> get_pixel_compile_unit_region_of_interest();
+
   /* Determines if the compile unit should be compiled based on a number of criteria give the node
    * currently being processed. See the class description for a description of the method. */
   bool should_compile_pixel_compile_unit(const bNode &node);
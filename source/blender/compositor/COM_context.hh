@@ -45,6 +45,14 @@ class Context {
   /* Returns the domain that the inputs and outputs of the context will be in. */
   virtual Domain get_compositing_domain() const = 0;
 
+  /* Returns the region of the compositing domain whose pixels are actually needed, in pixels
+   * relative to the lower left corner of its display window. Operations evaluated on the CPU only
+   * compute the parts of their results that are needed to compute this region, see
+   * COM_region_of_interest.hh. Defaults to the data window of the compositing domain, which is
+   * what final renders and the GPU only viewport compositor need. The sequencer compositor
+   * modifier overrides it to skip pixels that are cropped away. */
+  virtual Bounds<int2> get_region_of_interest() const;
+
   /* Write the result of the compositor viewer. */
   virtual void write_viewer(Result &viewer_result) = 0;
 
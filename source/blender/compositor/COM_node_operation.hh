@@ -11,6 +11,7 @@
 
 #include "BKE_node.hh"
 
+#include "COM_cached_node_results.hh"
 #include "COM_context.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
@@ -42,7 +43,9 @@ class NodeOperation : public Operation {
   NodeOperation(Context &context, const bNode &node);
 
   /* Calls the evaluate method of the operation, but also measures the execution time and stores it
-   * in the context's profile data. */
+   * in the context's profile data. If the results of the operation are cacheable, they are reused
+   * from the node results cache instead of executing the operation if possible, see the
+   * are_results_cacheable method. */
   void evaluate() override;
 
   /* Compute and set the initial reference counts of all the results of the operation. The
@@ -63,10 +66,26 @@ class NodeOperation : public Operation {
   /* Compute a node preview using the result returned from the get_preview_result method. */
   void compute_preview() override;
 
+  /* Returns true if the results of the operation only depend on the type and custom properties of
+   * the node as well as the values of its inputs, such that they can be cached and reused in later
+   * evaluations with identical inputs, see CachedNodeResultsContainer. This should be overridden
+   * to return true by operations that satisfy that condition and are expensive enough for hashing
+   * their inputs to be worth it. Defaults to false. */
+  virtual bool are_results_cacheable() const;
+
   /* Returns a reference to the node that this operation represents. */
   const bNode &node() const;
 
  private:
+  /* Similar to Operation::evaluate, but shares the data of the results cached for identical inputs
+   * instead of executing the operation if they exist, otherwise, executes the operation and caches
+   * its results. Only supported on the CPU. */
+  void evaluate_cached();
+
+  /* Computes the key that identifies the results of the operation in the node results cache. The
+   * input processors are expected to be evaluated already. */
+  CachedNodeResultsKey compute_cached_results_key();
+
   /* Get the result which will be previewed in the node, this is chosen as the first linked output
    * of the node, if no outputs exist, then the first allocated input will be chosen. Returns
    * nullptr if no result is viewable. */
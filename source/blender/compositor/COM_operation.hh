@@ -97,6 +97,10 @@ class Operation {
    * operations will not get evaluated and thus will not free the results it consumes. */
   void free_results();
 
+  /* Returns the number of pixels in the allocated results of the operation, where single value
+   * results count as a single pixel. This is used for profiling. */
+  int64_t get_results_pixels_count() const;
+
  protected:
   /* Compute the operation domain of this operation. By default, this implements a default logic
    * that infers the operation domain from the inputs, which may be overridden for a different
@@ -134,6 +138,11 @@ class Operation {
   /* Returns a reference to the compositor context. */
   Context &context() const;
 
+  /* Release the results that are mapped to the inputs of the operation. This is called after the
+   * evaluation of the operation to declare that the results are no longer needed by this
+   * operation. */
+  void release_inputs();
+
  private:
   /* Given the identifier of an input of the operation and a processor operation:
    * - Add the given processor to the list of input processors for the input.
@@ -142,11 +151,6 @@ class Operation {
    * - Switch the result mapped to the input to be the output result of the processor.
    * - Evaluate the processor. */
   void add_and_evaluate_input_processor(StringRef identifier, SimpleOperation *processor);
-
-  /* Release the results that are mapped to the inputs of the operation. This is called after the
-   * evaluation of the operation to declare that the results are no longer needed by this
-   * operation. */
-  void release_inputs();
 };
 
 }  // namespace blender::compositor
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include "BKE_node.hh"
 
+#include "BLI_bounds_types.hh"
 #include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector_set.hh"
 
@@ -75,6 +79,9 @@ class PixelOperation : public Operation {
   /* A map that associates each node instance identified by its node instance key to its node
    * preview. This could be nullptr if node previews are not needed. */
   Map<bNodeInstanceKey, bke::bNodePreview> *node_previews_ = nullptr;
+  /* The region of the operation domain that needs to be computed, or nullopt if the entire domain
+   * needs to be computed. See COM_region_of_interest.hh for more information. */
+  std::optional<Bounds<int2>> region_of_interest_;
   /* A map that associates the identifier of each input of the operation with the output socket it
    * is linked to. This is needed to help the compiler establish links between operations. */
   Map<std::string, const bNodeSocket *> inputs_to_linked_outputs_map_;
@@ -153,6 +160,16 @@ class PixelOperation : public Operation {
   /* Getter and setter for node_previews_. */
   void set_node_previews(Map<bNodeInstanceKey, bke::bNodePreview> *node_previews);
   Map<bNodeInstanceKey, bke::bNodePreview> *get_node_previews();
+
+  /* Setter for region_of_interest_. */
+  void set_region_of_interest(const std::optional<Bounds<int2>> &region_of_interest);
+
+ protected:
+  /* Limits the data window of the default operation domain to the region of interest of the
+   * operation, such that only the needed pixels are computed. The domain is returned as is if it
+   * doesn't have the display size and transformation of the compositing domain, since the region
+   * of interest is not meaningful for it then. */
+  Domain compute_domain() override;
 };
 
 }  // namespace blender::compositor
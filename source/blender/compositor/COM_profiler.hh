@@ -4,8 +4,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
 #include "BLI_map.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
 
@@ -13,6 +20,30 @@ namespace blender::compositor {
 
 class Context;
 
+/* -------------------------------------------------------------------------------------------------
+ * Operation Profile
+ *
+ * The statistics of a single evaluation of an operation, see Profiler::begin_operation. The
+ * statistics of an operation include those of the operations it evaluates internally, like the
+ * nodes of a node group. Memory is only tracked for results stored on the CPU, and for GPU
+ * execution, the times only include the submission of the work to the GPU. */
+struct OperationProfile {
+  /* A name that identifies the operation, like the name of its node. */
+  std::string name;
+  /* The number of operations this operation is nested in. */
+  int depth = 0;
+  /* The time the operation started relative to the creation of the profiler, and its wall time. */
+  timeit::Nanoseconds start_time;
+  timeit::Nanoseconds duration;
+  /* The number of pixels in the results of the operation, where single values count as a pixel. */
+  int64_t pixels_count = 0;
+  /* The number and total size of the results that were allocated during the operation. */
+  int64_t allocations_count = 0;
+  int64_t allocated_bytes = 0;
+  /* The highest memory usage of all results during the operation. */
+  int64_t peak_memory = 0;
+};
+
 /* -------------------------------------------------------------------------------------------------
  * Profiler
  *
@@ -20,18 +51,89 @@ class Context;
  * evaluation time of every node. */
 class Profiler {
  private:
+  /* An operation that is currently being evaluated and its state at the beginning. */
+  struct ActiveOperation {
+    int64_t profile_index;
+    timeit::TimePoint start_time;
+    int64_t allocations_count;
+    int64_t allocated_bytes;
+  };
+
+  timeit::TimePoint creation_time_ = timeit::Clock::now();
+  /* Operation profiles are only recorded when requested, since they are only needed to write
+   * traces. */
+  bool record_operations_ = false;
+  /* The profiles of all evaluated operations in the order they started. */
+  Vector<OperationProfile> operation_profiles_;
+  /* The operations that are currently being evaluated, innermost last. */
+  Vector<ActiveOperation> active_operations_;
+
   /* Stores the evaluation time of each node instance keyed by its instance key. Note that
    * pixel-wise nodes like Math nodes will not be measured, that's because they are compiled
    * together with other pixel-wise operations in a single operation, so we can't measure the
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
+  /* The number of times the results of node operations were reused from the node results cache
+   * and the number of times they were not found in the cache and had to be computed. Only node
+   * operations whose results are cacheable are counted, see CachedNodeResultsContainer. */
+  int64_t node_results_cache_hits_ = 0;
+  int64_t node_results_cache_misses_ = 0;
+  /* The highest memory usage of results since the last call to update_peak_memory. Tracked for
+   * each profiler that records operations, so that compositors profiled at the same time don't
+   * reset the peak of each other. */
+  std::atomic<int64_t> result_memory_peak_ = 0;
 
  public:
+  Profiler() = default;
+  /* If record_operations is true, operations are profiled using begin_operation and
+   * end_operation, otherwise those do nothing. */
+  explicit Profiler(bool record_operations);
+
+  ~Profiler();
+
+  /* Returns true if operations are profiled, see the constructor. */
+  bool is_recording_operations() const;
+
   /* Returns a reference to the nodes evaluation times. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> &get_nodes_evaluation_times();
 
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
+
+  /* Returns the number of node results cache hits and misses. */
+  int64_t get_node_results_cache_hits() const;
+  int64_t get_node_results_cache_misses() const;
+
+  /* Count a hit or a miss when looking up the results of a node operation in the node results
+   * cache. */
+  void add_node_results_cache_hit();
+  void add_node_results_cache_miss();
+
+  /* Start profiling the evaluation of an operation with the given name. Must be matched by a call
+   * to end_operation once the operation is evaluated. Operations evaluated in between are recorded
+   * as nested in this operation. */
+  void begin_operation(StringRef name);
+
+  /* Stop profiling the operation that was last started, providing the number of pixels in its
+   * results. */
+  void end_operation(int64_t pixels_count);
+
+  /* Write the operation profiles in the Chrome trace event format, which can be viewed in tools
+   * like Perfetto or the tracing page of Chromium based browsers. */
+  void write_chrome_trace(std::ostream &stream) const;
+
+  /* Same as above but write to a file at the given path, returns false if writing failed. */
+  bool write_chrome_trace(const char *filepath) const;
+
+  /* Track the allocation and freeing of the data of results stored on the CPU. The memory is
+   * tracked globally because results might be freed after the profiler or context that allocated
+   * them was destroyed, for instance when cached. */
+  static void add_result_allocation(int64_t size);
+  static void remove_result_allocation(int64_t size);
+
+ private:
+  /* Add the highest memory usage since the last call to all active operations. */
+  void update_peak_memory();
 };
 
 }  // namespace blender::compositor
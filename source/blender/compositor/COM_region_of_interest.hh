@@ -0,0 +1,57 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_bounds_types.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_vector_set.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_context.hh"
+
+namespace blender::compositor {
+
+/* ------------------------------------------------------------------------------------------------
+ * Region Of Interest
+ *
+ * Operations typically compute their results over their entire operation domain, even if only a
+ * small region of those results ends up being used, for instance, when the context only needs a
+ * region of the compositing domain, see Context::get_region_of_interest. The region of interest of
+ * a node is the region of its outputs that is needed to compute the regions of interest of the
+ * nodes that consume them. So it is computed by propagating the region of interest of the context
+ * backward through the node group, from the output nodes to the input nodes, expanding it by the
+ * radius of the kernels of filter nodes along the way.
+ *
+ * Regions are in pixels relative to the lower left corner of the display window of the compositing
+ * domain, and are only meaningful for results whose domain has the same display size and
+ * transformation as the compositing domain, like render passes. Results of other domains are
+ * always computed entirely. Pixel operations apply the regions by limiting the data window of
+ * their operation domain to the region of interest of their nodes, see
+ * PixelOperation::compute_domain, while other operations simply follow the data window of their
+ * inputs.
+ *
+ * A region is only propagated through nodes whose output pixels are computed from the pixels at
+ * the same location in their inputs or in a known neighborhood around it, and whose operation
+ * domain is guaranteed to be the domain of their inputs. That is, pixel nodes and some filter
+ * nodes, as long as all of their linked inputs are linked to the same output. Any other node needs
+ * its inputs entirely, and so do nodes whose preview is computed.
+ *
+ * Regions of interest are currently only computed for the root node group when evaluating on the
+ * CPU. */
+
+/* A mapping between nodes and their region of interest. Nodes that are not in the map need their
+ * outputs to be computed entirely. */
+using RegionsOfInterest = Map<const bNode *, Bounds<int2>>;
+
+/* Computes the region of interest of the nodes in the given node execution schedule. An empty map
+ * is returned if the node group is not the root node group or if the context uses the GPU. */
+RegionsOfInterest compute_regions_of_interest(const Context &context,
+                                              const VectorSet<const bNode *> &schedule,
+                                              bool is_root_node_group,
+                                              bool are_node_previews_needed);
+
+}  // namespace blender::compositor
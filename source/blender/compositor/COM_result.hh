@@ -360,6 +360,9 @@ class Result {
   /* Returns true if the result is allocated. */
   bool is_allocated() const;
 
+  /* Returns true if the result wraps external data, see the is_external_ member. */
+  bool is_external() const;
+
   /* Returns the reference count of the result. */
   int reference_count() const;
 
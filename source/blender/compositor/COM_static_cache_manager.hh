@@ -7,6 +7,7 @@
 #include "COM_bokeh_kernel.hh"
 #include "COM_cached_image.hh"
 #include "COM_cached_mask.hh"
+#include "COM_cached_node_results.hh"
 #include "COM_cached_shader.hh"
 #include "COM_deriche_gaussian_coefficients.hh"
 #include "COM_distortion_grid.hh"
@@ -62,6 +63,7 @@ class StaticCacheManager {
   VanVlietGaussianCoefficientsContainer van_vliet_gaussian_coefficients;
   FogGlowKernelContainer fog_glow_kernels;
   ImageCoordinatesContainer image_coordinates;
+  CachedNodeResultsContainer cached_node_results;
 
  public:
   /* Reset the cache manager by deleting the cached resources that are no longer needed because
@@ -0,0 +1,95 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_cached_resource.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+class Context;
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Results Key.
+ *
+ * Identifies the results of a node operation by the type of its node, the outputs that were
+ * computed, and a 128-bit hash of the custom properties of the node as well as the type, domain,
+ * and content of all of its inputs. */
+class CachedNodeResultsKey {
+ public:
+  std::string node_idname;
+  Vector<std::string> outputs;
+  uint64_t inputs_hash_low;
+  uint64_t inputs_hash_high;
+
+  /* The inputs are expected to be allocated CPU results ordered by the input sockets of the node
+   * they belong to. */
+  CachedNodeResultsKey(const bNode &node,
+                       Vector<std::string> outputs,
+                       Span<const Result *> inputs);
+
+  uint64_t hash() const;
+};
+
+bool operator==(const CachedNodeResultsKey &a, const CachedNodeResultsKey &b);
+
+/* -------------------------------------------------------------------------------------------------
+ * Cached Node Results.
+ *
+ * A cached resource that stores the results of a node operation by sharing their data, such that
+ * the data stays alive after the evaluation and can be shared with the outputs of an identical
+ * operation in a later evaluation. */
+class CachedNodeResults : public CachedResource {
+ public:
+  /* The cached results identified by the identifiers of their outputs. */
+  Map<std::string, Result> results;
+  /* The total size of the data of the results. */
+  int64_t size_in_bytes = 0;
+
+  ~CachedNodeResults();
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Results Container.
+ *
+ * Unlike other cached resources, cached node results are not computed by the container, they are
+ * added by node operations after executing, see NodeOperation::are_results_cacheable. Since cached
+ * results can be large images, the total size of the cached results is limited by a memory
+ * budget. Cached results are only reused on the CPU, since hashing the content of GPU textures
+ * would require reading them back. */
+class CachedNodeResultsContainer : CachedResourceContainer {
+ private:
+  Map<CachedNodeResultsKey, std::unique_ptr<CachedNodeResults>> map_;
+
+  /* The total size of all cached results in bytes. */
+  int64_t size_in_bytes_ = 0;
+
+ public:
+  void reset() override;
+
+  /* Returns the cached results with the given key if they exist, tagging them as needed to keep
+   * them cached for the next evaluation, otherwise, returns nullptr. */
+  const CachedNodeResults *get(const CachedNodeResultsKey &key);
+
+  /* Cache the given results with the given key by sharing their data. If the memory budget would
+   * be exceeded, cached results that were not needed in the current evaluation so far are freed
+   * first, and if that is not enough, the results are not cached. Results that wrap external data
+   * are never cached, since their data may change or be freed after the evaluation. */
+  void add(Context &context,
+           const CachedNodeResultsKey &key,
+           const Map<std::string, const Result *> &results);
+};
+
+}  // namespace blender::compositor
@@ -0,0 +1,193 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <xxhash.h>
+
+#include "BLI_assert.h"
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_cached_node_results.hh"
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+/* The maximum total size of the cached node results. Images are typically shared with the outputs
+ * of the node operations during evaluation, so this mostly limits the memory that is kept alive
+ * between evaluations. */
+static constexpr int64_t max_size_in_bytes = int64_t(1024) * 1024 * 1024;
+
+/* --------------------------------------------------------------------
+ * Cached Node Results Key.
+ */
+
+template<typename T> static void hash_value(XXH3_state_t *state, const T &value)
+{
+  XXH3_128bits_update(state, &value, sizeof(T));
+}
+
+static void hash_domain(XXH3_state_t *state, const Domain &domain)
+{
+  hash_value(state, domain.data_size);
+  hash_value(state, domain.display_size);
+  hash_value(state, domain.data_offset);
+  hash_value(state, domain.transformation);
+  hash_value(state, domain.realization_options.interpolation);
+  hash_value(state, domain.realization_options.extension_x);
+  hash_value(state, domain.realization_options.extension_y);
+}
+
+static void hash_input(XXH3_state_t *state, const Result &input)
+{
+  BLI_assert(input.is_allocated());
+
+  hash_value(state, input.type());
+  hash_value(state, input.is_single_value());
+
+  if (input.is_single_value()) {
+    if (input.type() == ResultType::String) {
+      const std::string &value = input.get_single_value<std::string>();
+      XXH3_128bits_update(state, value.data(), value.size());
+      return;
+    }
+    XXH3_128bits_update(state, input.single_value().get(), input.get_cpp_type().size);
+    return;
+  }
+
+  hash_domain(state, input.domain());
+  const GSpan data = input.cpu_data();
+  XXH3_128bits_update(state, data.data(), data.size_in_bytes());
+}
+
+CachedNodeResultsKey::CachedNodeResultsKey(const bNode &node,
+                                           Vector<std::string> outputs,
+                                           Span<const Result *> inputs)
+    : node_idname(node.idname), outputs(std::move(outputs))
+{
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_128bits_reset(state);
+
+  hash_value(state, node.custom1);
+  hash_value(state, node.custom2);
+  hash_value(state, node.custom3);
+  hash_value(state, node.custom4);
+  for (const Result *input : inputs) {
+    hash_input(state, *input);
+  }
+
+  const XXH128_hash_t hash = XXH3_128bits_digest(state);
+  XXH3_freeState(state);
+
+  inputs_hash_low = hash.low64;
+  inputs_hash_high = hash.high64;
+}
+
+uint64_t CachedNodeResultsKey::hash() const
+{
+  return get_default_hash(node_idname, inputs_hash_low, inputs_hash_high);
+}
+
+bool operator==(const CachedNodeResultsKey &a, const CachedNodeResultsKey &b)
+{
+  return a.node_idname == b.node_idname && a.outputs == b.outputs &&
+         a.inputs_hash_low == b.inputs_hash_low && a.inputs_hash_high == b.inputs_hash_high;
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Results.
+ */
+
+CachedNodeResults::~CachedNodeResults()
+{
+  for (Result &result : this->results.values()) {
+    result.release();
+  }
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Results Container.
+ */
+
+void CachedNodeResultsContainer::reset()
+{
+  /* First, delete all cached results that are no longer needed. */
+  map_.remove_if([&](auto item) {
+    if (item.value->needed) {
+      return false;
+    }
+    size_in_bytes_ -= item.value->size_in_bytes;
+    return true;
+  });
+
+  /* Second, reset the needed status of the remaining cached results to false to ready them to
+   * track their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+const CachedNodeResults *CachedNodeResultsContainer::get(const CachedNodeResultsKey &key)
+{
+  std::unique_ptr<CachedNodeResults> *cached_results = map_.lookup_ptr(key);
+  if (!cached_results) {
+    return nullptr;
+  }
+
+  (*cached_results)->needed = true;
+  return cached_results->get();
+}
+
+void CachedNodeResultsContainer::add(Context &context,
+                                     const CachedNodeResultsKey &key,
+                                     const Map<std::string, const Result *> &results)
+{
+  int64_t size_in_bytes = 0;
+  for (const Result *result : results.values()) {
+    if (!result->is_allocated() || result->is_external()) {
+      return;
+    }
+    size_in_bytes += result->size_in_bytes();
+  }
+
+  if (size_in_bytes > max_size_in_bytes || map_.contains(key)) {
+    return;
+  }
+
+  /* Free results that were not needed in the current evaluation so far until the new results
+   * fit in the budget. */
+  map_.remove_if([&](auto item) {
+    if (size_in_bytes_ + size_in_bytes <= max_size_in_bytes || item.value->needed) {
+      return false;
+    }
+    size_in_bytes_ -= item.value->size_in_bytes;
+    return true;
+  });
+
+  if (size_in_bytes_ + size_in_bytes > max_size_in_bytes) {
+    return;
+  }
+
+  std::unique_ptr<CachedNodeResults> cached_results = std::make_unique<CachedNodeResults>();
+  for (const auto item : results.items()) {
+    Result cached_result = context.create_result(item.value->type(), item.value->precision());
+    cached_result.share_data(*item.value);
+    cached_results->results.add_new(item.key, cached_result);
+  }
+  cached_results->size_in_bytes = size_in_bytes;
+
+  size_in_bytes_ += size_in_bytes;
+  map_.add_new(key, std::move(cached_results));
+}
+
+}  // namespace blender::compositor
@@ -3,7 +3,11 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <limits>
+#include <optional>
+#include <utility>
 
+#include "BLI_bounds.hh"
+#include "BLI_bounds_types.hh"
 #include "BLI_set.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector_set.hh"
@@ -19,14 +23,17 @@
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
 #include "COM_pixel_operation.hh"
+#include "COM_region_of_interest.hh"
 #include "COM_result.hh"
 #include "COM_shader_operation.hh"
 #include "COM_utilities.hh"
 
 namespace blender::compositor {
 
-CompileState::CompileState(const Context &context, const VectorSet<const bNode *> &schedule)
-    : context_(context), schedule_(schedule)
+CompileState::CompileState(const Context &context,
+                           const VectorSet<const bNode *> &schedule,
+                           RegionsOfInterest regions_of_interest)
+    : context_(context), schedule_(schedule), regions_of_interest_(std::move(regions_of_interest))
 {
 }
 
@@ -94,6 +101,19 @@ void CompileState::reset_pixel_compile_unit()
   pixel_compile_unit_domain_.reset();
 }
 
+std::optional<Bounds<int2>> CompileState::get_pixel_compile_unit_region_of_interest()
+{
+  std::optional<Bounds<int2>> region_of_interest;
+  for (const bNode *node : pixel_compile_unit_) {
+    const Bounds<int2> *node_region_of_interest = regions_of_interest_.lookup_ptr(node);
+    if (!node_region_of_interest) {
+      return std::nullopt;
+    }
+    region_of_interest = bounds::merge(region_of_interest, *node_region_of_interest);
+  }
+  return region_of_interest;
+}
+
 bool CompileState::should_compile_pixel_compile_unit(const bNode &node)
 {
   /* If the pixel compile unit is empty, then it can't be compiled yet. */
@@ -2,6 +2,9 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_bounds_types.hh"
+#include "BLI_math_vector_types.hh"
+
 #include "DNA_node_types.h"
 
 #include "GPU_shader.hh"
@@ -22,6 +25,12 @@ Result Context::get_pass(const Scene * /*scene*/, int /*view_layer*/, const char
   return invalid_pass;
 }
 
+Bounds<int2> Context::get_region_of_interest() const
+{
+  const Domain domain = this->get_compositing_domain();
+  return Bounds<int2>(domain.data_offset, domain.data_offset + domain.data_size);
+}
+
 const RenderData &Context::get_render_data() const
 {
   return this->get_scene().r;
@@ -2,6 +2,9 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <string>
+#include <utility>
+
 #include "BLI_set.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector_set.hh"
@@ -22,6 +25,8 @@
 #include "COM_node_group_operation.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
+#include "COM_profiler.hh"
+#include "COM_region_of_interest.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
@@ -72,7 +77,11 @@ void NodeGroupOperation::execute()
                                                              needed_outputs,
                                                              instance_key_,
                                                              active_node_group_instance_key_);
-  CompileState compile_state(this->context(), schedule);
+  const bool is_root_node_group = instance_key_ == bke::NODE_INSTANCE_KEY_BASE;
+  const bool are_node_previews_needed = instance_key_ == active_node_group_instance_key_;
+  RegionsOfInterest regions_of_interest = compute_regions_of_interest(
+      this->context(), schedule, is_root_node_group, are_node_previews_needed);
+  CompileState compile_state(this->context(), schedule, std::move(regions_of_interest));
 
   for (const bNode *node : schedule) {
     if (this->context().is_canceled()) {
@@ -231,6 +240,8 @@ void NodeGroupOperation::evaluate_pixel_compile_unit(CompileState &compile_state
     operation->set_node_previews(node_previews_);
   }
 
+  operation->set_region_of_interest(compile_state.get_pixel_compile_unit_region_of_interest());
+
   for (const bNode *node : compile_unit) {
     compile_state.map_node_to_pixel_operation(*node, operation);
   }
@@ -241,8 +252,24 @@ void NodeGroupOperation::evaluate_pixel_compile_unit(CompileState &compile_state
 
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
+  /* The nodes of the compile unit are evaluated together, so profile them as a single operation
+   * named after all of its nodes. */
+  Profiler *profiler = this->context().profiler();
+  const bool profile_operation = profiler && profiler->is_recording_operations();
+  if (profile_operation) {
+    std::string name = "Pixel Operation:";
+    for (const bNode *node : compile_state.get_pixel_compile_unit()) {
+      name += std::string(" ") + node->name;
+    }
+    profiler->begin_operation(name);
+  }
+
   operation->evaluate();
 
+  if (profile_operation) {
+    profiler->end_operation(operation->get_results_pixels_count());
+  }
+
   compile_state.reset_pixel_compile_unit();
 }
 
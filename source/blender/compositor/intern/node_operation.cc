@@ -2,9 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <string>
+
 #include "BLI_assert.h"
+#include "BLI_map.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
 #include "DNA_node_types.h"
@@ -15,10 +19,12 @@
 #include "GPU_debug.hh"
 
 #include "COM_algorithm_compute_preview.hh"
+#include "COM_cached_node_results.hh"
 #include "COM_context.hh"
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
+#include "COM_profiler.hh"
 #include "COM_result.hh"
 #include "COM_utilities.hh"
 
@@ -50,17 +56,90 @@ void NodeOperation::evaluate()
   if (this->context().use_gpu()) {
     GPU_debug_group_begin(this->node().typeinfo->idname.c_str());
   }
+  Profiler *profiler = this->context().profiler();
+  const bool profile_operation = profiler && profiler->is_recording_operations();
+  if (profile_operation) {
+    profiler->begin_operation(this->node().name);
+  }
   const timeit::TimePoint before_time = timeit::Clock::now();
-  Operation::evaluate();
+  if (this->are_results_cacheable() && !this->context().use_gpu()) {
+    this->evaluate_cached();
+  }
+  else {
+    Operation::evaluate();
+  }
   const timeit::TimePoint after_time = timeit::Clock::now();
-  if (this->context().profiler()) {
-    this->context().profiler()->set_node_evaluation_time(instance_key_, after_time - before_time);
+  if (profiler) {
+    profiler->set_node_evaluation_time(instance_key_, after_time - before_time);
+  }
+  if (profile_operation) {
+    profiler->end_operation(this->get_results_pixels_count());
   }
   if (this->context().use_gpu()) {
     GPU_debug_group_end();
   }
 }
 
+void NodeOperation::evaluate_cached()
+{
+  this->evaluate_input_processors();
+
+  CachedNodeResultsContainer &cache = this->context().cache_manager().cached_node_results;
+  Profiler *profiler = this->context().profiler();
+
+  const CachedNodeResultsKey key = this->compute_cached_results_key();
+  const CachedNodeResults *cached_results = cache.get(key);
+  if (cached_results) {
+    for (const auto item : cached_results->results.items()) {
+      this->get_result(item.key).share_data(item.value);
+    }
+    if (profiler) {
+      profiler->add_node_results_cache_hit();
+    }
+  }
+  else {
+    this->execute();
+
+    Map<std::string, const Result *> results;
+    for (const std::string &identifier : key.outputs) {
+      results.add_new(identifier, &this->get_result(identifier));
+    }
+    cache.add(this->context(), key, results);
+    if (profiler) {
+      profiler->add_node_results_cache_miss();
+    }
+  }
+
+  this->compute_preview();
+  this->release_inputs();
+  this->context().evaluate_operation_post();
+}
+
+CachedNodeResultsKey NodeOperation::compute_cached_results_key()
+{
+  Vector<std::string> outputs;
+  for (const bNodeSocket *output : this->node().output_sockets()) {
+    if (!is_socket_available(output)) {
+      continue;
+    }
+
+    if (this->get_result(output->identifier).should_compute()) {
+      outputs.append(output->identifier);
+    }
+  }
+
+  Vector<const Result *> inputs;
+  for (const bNodeSocket *input : this->node().input_sockets()) {
+    if (!is_socket_available(input)) {
+      continue;
+    }
+
+    inputs.append(&this->get_input(input->identifier));
+  }
+
+  return CachedNodeResultsKey(this->node(), std::move(outputs), inputs);
+}
+
 void NodeOperation::compute_results_reference_counts(const VectorSet<const bNode *> &schedule)
 {
   for (const bNodeSocket *output : this->node().output_sockets()) {
@@ -110,6 +189,11 @@ const bNode &NodeOperation::node() const
   return node_;
 }
 
+bool NodeOperation::are_results_cacheable() const
+{
+  return false;
+}
+
 Result *NodeOperation::get_preview_result()
 {
   /* Find the first linked output. */
@@ -54,6 +54,19 @@ void Operation::free_results()
   }
 }
 
+int64_t Operation::get_results_pixels_count() const
+{
+  int64_t pixels_count = 0;
+  for (const Result &result : results_.values()) {
+    if (!result.is_allocated()) {
+      continue;
+    }
+    const int2 size = result.is_single_value() ? int2(1) : result.domain().data_size;
+    pixels_count += int64_t(size.x) * int64_t(size.y);
+  }
+  return pixels_count;
+}
+
 Domain Operation::compute_domain()
 {
   /* Default to an identity domain in case no domain input was found, most likely because all
@@ -3,8 +3,11 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <limits>
+#include <optional>
 #include <string>
 
+#include "BLI_bounds.hh"
+#include "BLI_bounds_types.hh"
 #include "BLI_map.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector_set.hh"
@@ -16,6 +19,7 @@
 
 #include "COM_algorithm_compute_preview.hh"
 #include "COM_context.hh"
+#include "COM_domain.hh"
 #include "COM_operation.hh"
 #include "COM_pixel_operation.hh"
 #include "COM_result.hh"
@@ -104,4 +108,41 @@ Map<bNodeInstanceKey, bke::bNodePreview> *PixelOperation::get_node_previews()
   return node_previews_;
 }
 
+void PixelOperation::set_region_of_interest(
+    const std::optional<Bounds<int2>> &region_of_interest)
+{
+  region_of_interest_ = region_of_interest;
+}
+
+Domain PixelOperation::compute_domain()
+{
+  Domain domain = Operation::compute_domain();
+  if (!region_of_interest_) {
+    return domain;
+  }
+
+  /* The region of interest is relative to the display window of the compositing domain, so it can
+   * only be applied to domains that differ from it in their data window only. */
+  const Domain compositing_domain = this->context().get_compositing_domain();
+  if (domain.display_size != compositing_domain.display_size ||
+      domain.transformation != compositing_domain.transformation)
+  {
+    return domain;
+  }
+
+  const Bounds<int2> data_window = Bounds<int2>(domain.data_offset,
+                                                domain.data_offset + domain.data_size);
+  const std::optional<Bounds<int2>> needed_data_window = bounds::intersect(data_window,
+                                                                           *region_of_interest_);
+
+  /* None of the data is needed, keep the domain since empty domains are not supported. */
+  if (!needed_data_window) {
+    return domain;
+  }
+
+  domain.data_offset = needed_data_window->min;
+  domain.data_size = needed_data_window->size();
+  return domain;
+}
+
 }  // namespace blender::compositor
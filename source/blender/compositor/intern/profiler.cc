@@ -2,7 +2,18 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <ostream>
+
+#include "BLI_fileops.h"
+#include "BLI_mutex.hh"
+#include "BLI_serialize.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
 
@@ -10,6 +21,42 @@
 
 namespace blender::compositor {
 
+/* The memory of all results stored on the CPU, see Profiler::add_result_allocation. If multiple
+ * compositors are evaluated at the same time, their memory is tracked together. */
+static std::atomic<int64_t> result_memory_usage = 0;
+static std::atomic<int64_t> result_allocations_count = 0;
+static std::atomic<int64_t> result_allocated_bytes = 0;
+
+/* The profilers that record operations, whose memory peak is updated on every allocation. */
+static Mutex recording_profilers_mutex;
+static Vector<Profiler *> recording_profilers;
+static std::atomic<int> recording_profilers_num = 0;
+
+Profiler::Profiler(const bool record_operations) : record_operations_(record_operations)
+{
+  if (!record_operations_) {
+    return;
+  }
+  std::lock_guard lock(recording_profilers_mutex);
+  recording_profilers.append(this);
+  recording_profilers_num.fetch_add(1);
+}
+
+Profiler::~Profiler()
+{
+  if (!record_operations_) {
+    return;
+  }
+  std::lock_guard lock(recording_profilers_mutex);
+  recording_profilers.remove_first_occurrence_and_reorder(this);
+  recording_profilers_num.fetch_sub(1);
+}
+
+bool Profiler::is_recording_operations() const
+{
+  return record_operations_;
+}
+
 Map<bNodeInstanceKey, timeit::Nanoseconds> &Profiler::get_nodes_evaluation_times()
 {
   return nodes_evaluation_times_;
@@ -21,4 +68,145 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+int64_t Profiler::get_node_results_cache_hits() const
+{
+  return node_results_cache_hits_;
+}
+
+int64_t Profiler::get_node_results_cache_misses() const
+{
+  return node_results_cache_misses_;
+}
+
+void Profiler::add_node_results_cache_hit()
+{
+  node_results_cache_hits_++;
+}
+
+void Profiler::add_node_results_cache_miss()
+{
+  node_results_cache_misses_++;
+}
+
+void Profiler::begin_operation(const StringRef name)
+{
+  if (!record_operations_) {
+    return;
+  }
+
+  this->update_peak_memory();
+
+  const timeit::TimePoint start_time = timeit::Clock::now();
+
+  OperationProfile profile;
+  profile.name = name;
+  profile.depth = active_operations_.size();
+  profile.start_time = start_time - creation_time_;
+  profile.peak_memory = result_memory_usage.load();
+  operation_profiles_.append(std::move(profile));
+
+  active_operations_.append({operation_profiles_.index_range().last(),
+                             start_time,
+                             result_allocations_count.load(),
+                             result_allocated_bytes.load()});
+}
+
+void Profiler::end_operation(const int64_t pixels_count)
+{
+  if (!record_operations_) {
+    return;
+  }
+
+  const timeit::TimePoint end_time = timeit::Clock::now();
+
+  this->update_peak_memory();
+
+  const ActiveOperation operation = active_operations_.pop_last();
+  OperationProfile &profile = operation_profiles_[operation.profile_index];
+  profile.duration = end_time - operation.start_time;
+  profile.pixels_count = pixels_count;
+  profile.allocations_count = result_allocations_count.load() - operation.allocations_count;
+  profile.allocated_bytes = result_allocated_bytes.load() - operation.allocated_bytes;
+}
+
+void Profiler::write_chrome_trace(std::ostream &stream) const
+{
+  using namespace io::serialize;
+
+  DictionaryValue trace;
+  trace.append_str("displayTimeUnit", "ms");
+  std::shared_ptr<ArrayValue> events = trace.append_array("traceEvents");
+  for (const OperationProfile &profile : operation_profiles_) {
+    std::shared_ptr<DictionaryValue> event = events->append_dict();
+    event->append_str("name", profile.name);
+    event->append_str("cat", "compositor");
+    /* A complete event, which has a start time and a duration in microseconds. Nested operations
+     * are displayed inside of their parent since all operations are evaluated on one thread. */
+    event->append_str("ph", "X");
+    event->append_double("ts", profile.start_time.count() / 1000.0);
+    event->append_double("dur", profile.duration.count() / 1000.0);
+    event->append_int("pid", 0);
+    event->append_int("tid", 0);
+
+    std::shared_ptr<DictionaryValue> args = event->append_dict("args");
+    args->append_int("depth", profile.depth);
+    args->append_int("pixels", profile.pixels_count);
+    args->append_int("allocations", profile.allocations_count);
+    args->append_int("allocated_bytes", profile.allocated_bytes);
+    args->append_int("peak_memory_bytes", profile.peak_memory);
+  }
+
+  JsonFormatter formatter;
+  formatter.serialize(stream, trace);
+}
+
+bool Profiler::write_chrome_trace(const char *filepath) const
+{
+  if (!BLI_file_ensure_parent_dir_exists(filepath)) {
+    return false;
+  }
+
+  std::ofstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream) {
+    return false;
+  }
+  this->write_chrome_trace(stream);
+  stream.close();
+  return !stream.fail();
+}
+
+void Profiler::add_result_allocation(const int64_t size)
+{
+  const int64_t memory_usage = result_memory_usage.fetch_add(size) + size;
+  result_allocations_count.fetch_add(1);
+  result_allocated_bytes.fetch_add(size);
+
+  /* Avoid locking when no compositor is profiled, which is the common case. */
+  if (recording_profilers_num.load() == 0) {
+    return;
+  }
+  std::lock_guard lock(recording_profilers_mutex);
+  for (Profiler *profiler : recording_profilers) {
+    int64_t memory_peak = profiler->result_memory_peak_.load();
+    while (memory_usage > memory_peak &&
+           !profiler->result_memory_peak_.compare_exchange_weak(memory_peak, memory_usage))
+    {
+    }
+  }
+}
+
+void Profiler::remove_result_allocation(const int64_t size)
+{
+  result_memory_usage.fetch_sub(size);
+}
+
+void Profiler::update_peak_memory()
+{
+  const int64_t memory_peak = result_memory_peak_.exchange(result_memory_usage.load());
+  for (const ActiveOperation &operation : active_operations_) {
+    int64_t &peak_memory = operation_profiles_[operation.profile_index].peak_memory;
+    peak_memory = std::max(peak_memory, memory_peak);
+  }
+}
+
 }  // namespace blender::compositor
@@ -38,11 +38,48 @@ RealizeOnDomainOperation::RealizeOnDomainOperation(Context &context,
   this->populate_result(context.create_result(type));
 }
 
+/* Returns true if the given domains only differ in their data windows and the data window of the
+ * output domain is inside that of the input domain. In that case, realization is just a copy of
+ * the output data window from the input. This is typically the case for results computed over
+ * different regions of interest, see COM_region_of_interest.hh. */
+static bool is_data_window_subset(const Domain &input_domain, const Domain &output_domain)
+{
+  if (input_domain.display_size != output_domain.display_size ||
+      input_domain.transformation != output_domain.transformation)
+  {
+    return false;
+  }
+
+  const int2 lower_bound = output_domain.data_offset - input_domain.data_offset;
+  const int2 upper_bound = lower_bound + output_domain.data_size;
+  return lower_bound.x >= 0 && lower_bound.y >= 0 && upper_bound.x <= input_domain.data_size.x &&
+         upper_bound.y <= input_domain.data_size.y;
+}
+
+static void copy_data_window(const Result &input, Result &output, const Domain &output_domain)
+{
+  output.allocate_texture(output_domain);
+
+  const int2 offset = output_domain.data_offset - input.domain().data_offset;
+  input.get_cpp_type()
+      .to_static_type<float, float2, float3, float4, Color, int32_t, int2, bool, nodes::MenuValue>(
+          [&]<typename T>() {
+            parallel_for(output_domain.data_size, [&](const int2 texel) {
+              output.store_pixel(texel, input.load_pixel<T>(texel + offset));
+            });
+          });
+}
+
 void RealizeOnDomainOperation::execute()
 {
   const Domain input_domain = this->get_input().domain();
   const Domain output_domain = target_domain_;
 
+  if (!this->context().use_gpu() && is_data_window_subset(input_domain, output_domain)) {
+    copy_data_window(this->get_input(), this->get_result(), output_domain);
+    return;
+  }
+
   /* Create a transformation matrix that transforms the pixels in the data window from the data
    * space to the virtual compositing space. This is done by first adding the data offset to go
    * from the data space to the display space, then subtracting the center of the display window to
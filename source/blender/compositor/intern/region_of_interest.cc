@@ -0,0 +1,186 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <optional>
+
+#include "BLI_bounds.hh"
+#include "BLI_bounds_types.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_vector_set.hh"
+
+#include "DNA_node_types.h"
+
+#include "BKE_node.hh"
+#include "BKE_node_runtime.hh"
+
+#include "COM_context.hh"
+#include "COM_region_of_interest.hh"
+#include "COM_utilities.hh"
+
+namespace blender::compositor {
+
+/* Returns true if all linked inputs of the given node are linked to the same output. The operation
+ * domain of such a node is the domain of that output. Unless it is a single value, in which case
+ * the domain is either the compositing domain if the node has implicit inputs, or an identity
+ * domain that is irrelevant, since the node is then evaluated on single values. */
+static bool are_linked_inputs_from_same_output(const bNode &node)
+{
+  const bNodeSocket *linked_output = nullptr;
+  for (const bNodeSocket *input : node.input_sockets()) {
+    if (!is_socket_available(input)) {
+      continue;
+    }
+
+    const bNodeSocket *output = get_output_linked_to_input(*input);
+    if (!output) {
+      continue;
+    }
+
+    if (linked_output && linked_output != output) {
+      return false;
+    }
+    linked_output = output;
+  }
+
+  return true;
+}
+
+/* Returns the radius of the neighborhood of pixels that the given filter node reads around each of
+ * its output pixels. Returns nullopt if the node is not a supported filter node or if the radius
+ * can't be known before evaluation, for instance, because the size input of the node is linked. */
+static std::optional<int2> get_filter_radius(const bNode &node)
+{
+  if (node.is_type("CompositorNodeFilter")) {
+    /* All filters are 3x3 kernels. */
+    return int2(1);
+  }
+
+  if (node.is_type("CompositorNodeBlur")) {
+    const bNodeSocket &size = *node.input_by_identifier("Size");
+    const bNodeSocket &type = *node.input_by_identifier("Type");
+    const bNodeSocket &extend_bounds = *node.input_by_identifier("Extend Bounds");
+    if (get_output_linked_to_input(size) || get_output_linked_to_input(type) ||
+        get_output_linked_to_input(extend_bounds))
+    {
+      return std::nullopt;
+    }
+
+    /* Extending the bounds changes the domain of the output. */
+    if (extend_bounds.default_value_typed<bNodeSocketValueBoolean>()->value) {
+      return std::nullopt;
+    }
+
+    /* The fast Gaussian filter is a recursive filter that reads entire rows and columns. */
+    if (type.default_value_typed<bNodeSocketValueMenu>()->value == CMP_NODE_BLUR_TYPE_FAST_GAUSS) {
+      return std::nullopt;
+    }
+
+    const float2 blur_size = size.default_value_typed<bNodeSocketValueVector>()->value;
+    return int2(math::ceil(math::max(float2(0.0f), blur_size)));
+  }
+
+  return std::nullopt;
+}
+
+/* Returns the region of the inputs of the given node that is needed to compute its region of
+ * interest, or nullopt if the inputs are needed entirely. */
+static std::optional<Bounds<int2>> compute_needed_input_region(const bNode &node,
+                                                               const RegionsOfInterest &regions,
+                                                               const Bounds<int2> &context_region)
+{
+  /* The outputs of the root node group are realized on the compositing domain by the context, so
+   * only the region of interest of the context is needed. */
+  if (node.is_group_output()) {
+    return context_region;
+  }
+
+  const Bounds<int2> *region = regions.lookup_ptr(&node);
+  if (!region) {
+    return std::nullopt;
+  }
+
+  if (!are_linked_inputs_from_same_output(node)) {
+    return std::nullopt;
+  }
+
+  if (is_pixel_node(node)) {
+    return *region;
+  }
+
+  const std::optional<int2> radius = get_filter_radius(node);
+  if (!radius) {
+    return std::nullopt;
+  }
+
+  return Bounds<int2>(region->min - *radius, region->max + *radius);
+}
+
+/* Computes the region of interest of the given node as the union of the regions needed by all
+ * nodes in the schedule that consume its outputs, or nullopt if its outputs are needed entirely.
+ * The regions of interest of all of those nodes are assumed to be already computed. */
+static std::optional<Bounds<int2>> compute_region_of_interest(
+    const bNode &node,
+    const VectorSet<const bNode *> &schedule,
+    const RegionsOfInterest &regions,
+    const Bounds<int2> &context_region)
+{
+  std::optional<Bounds<int2>> region_of_interest;
+  for (const bNodeSocket *output : node.output_sockets()) {
+    if (!is_socket_available(output)) {
+      continue;
+    }
+
+    for (const bNodeSocket *input : output->logically_linked_sockets()) {
+      if (!is_socket_available(input) || !schedule.contains(&input->owner_node())) {
+        continue;
+      }
+
+      const std::optional<Bounds<int2>> needed_region = compute_needed_input_region(
+          input->owner_node(), regions, context_region);
+      if (!needed_region) {
+        return std::nullopt;
+      }
+
+      region_of_interest = bounds::merge(region_of_interest, needed_region);
+    }
+  }
+
+  return region_of_interest;
+}
+
+RegionsOfInterest compute_regions_of_interest(const Context &context,
+                                              const VectorSet<const bNode *> &schedule,
+                                              const bool is_root_node_group,
+                                              const bool are_node_previews_needed)
+{
+  RegionsOfInterest regions;
+  if (!is_root_node_group || context.use_gpu()) {
+    return regions;
+  }
+
+  const Bounds<int2> context_region = context.get_region_of_interest();
+
+  /* Traverse the schedule in reverse, such that the regions of interest of all nodes that consume
+   * the outputs of a node are computed before the region of interest of the node itself. */
+  for (int i = schedule.size() - 1; i >= 0; i--) {
+    const bNode &node = *schedule[i];
+
+    /* Previews are computed from the entire outputs of nodes. */
+    if (are_node_previews_needed && is_node_preview_needed(node)) {
+      continue;
+    }
+
+    const std::optional<Bounds<int2>> region = compute_region_of_interest(
+        node, schedule, regions, context_region);
+    if (region) {
+      regions.add_new(&node, *region);
+    }
+  }
+
+  return regions;
+}
+
+}  // namespace blender::compositor
@@ -26,6 +26,7 @@
 #include "COM_context.hh"
 #include "COM_derived_resources.hh"
 #include "COM_domain.hh"
+#include "COM_profiler.hh"
 #include "COM_result.hh"
 
 namespace blender::compositor {
@@ -552,6 +553,7 @@ void Result::steal_data(void *data, const Domain &domain)
   storage_type_ = ResultStorageType::CPU;
   domain_ = domain;
   data_reference_count_ = new int(1);
+  Profiler::add_result_allocation(cpu_data_.size_in_bytes());
 }
 
 /* Returns true if the given GPU texture is compatible with the type and precision of the given
@@ -700,6 +702,7 @@ void Result::free()
       gpu_texture_ = nullptr;
       break;
     case ResultStorageType::CPU:
+      Profiler::remove_result_allocation(cpu_data_.size_in_bytes());
       MEM_delete_void(this->cpu_data().data());
       cpu_data_ = GMutableSpan();
       break;
@@ -766,6 +769,11 @@ bool Result::is_allocated() const
   return false;
 }
 
+bool Result::is_external() const
+{
+  return is_external_;
+}
+
 int Result::reference_count() const
 {
   return reference_count_;
@@ -864,6 +872,7 @@ void Result::allocate_data(const int2 size,
     cpp_type.default_construct_n(data, array_size);
 
     cpu_data_ = GMutableSpan(cpp_type, data, array_size);
+    Profiler::add_result_allocation(memory_size);
   }
 
   data_reference_count_ = new int(1);
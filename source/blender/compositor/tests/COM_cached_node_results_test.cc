@@ -0,0 +1,278 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+
+#include "CLG_log.h"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_appdir.hh"
+#include "BKE_global.hh"
+#include "BKE_idtype.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_material.hh"
+#include "BKE_node.hh"
+#include "BKE_node_runtime.hh"
+#include "BKE_scene.hh"
+
+#include "IMB_imbuf.hh"
+
+#include "RNA_define.hh"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_node_group_operation.hh"
+#include "COM_profiler.hh"
+#include "COM_result.hh"
+#include "COM_static_cache_manager.hh"
+
+namespace blender::compositor::tests {
+
+static const int2 image_size = int2(32, 24);
+
+/* A CPU context that composites an image of a fixed size and counts node results cache hits and
+ * misses in its profiler. */
+class TestContext : public Context {
+ private:
+  const Scene &scene_;
+  Profiler &profiler_;
+
+ public:
+  TestContext(StaticCacheManager &cache_manager, const Scene &scene, Profiler &profiler)
+      : Context(cache_manager), scene_(scene), profiler_(profiler)
+  {
+  }
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  Domain get_compositing_domain() const override
+  {
+    return Domain(image_size);
+  }
+
+  void write_viewer(Result & /*viewer_result*/) override {}
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+
+  Profiler *profiler() const override
+  {
+    return &profiler_;
+  }
+};
+
+class CachedNodeResultsTest : public ::testing::Test {
+ protected:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  /* Blurs the input image, the blur node caches its results. */
+  bNodeTree *node_group = nullptr;
+  bNode *blur = nullptr;
+  Array<float4> image;
+  /* Kept across evaluations, like the cache manager of a compositor that evaluates repeatedly. */
+  StaticCacheManager cache_manager;
+
+  int64_t hits = 0;
+  int64_t misses = 0;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    RNA_init();
+    bke::node_system_init();
+    BKE_appdir_init();
+    IMB_init();
+    BKE_materials_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    BKE_materials_exit();
+    bke::node_system_exit();
+    RNA_exit();
+    BKE_appdir_exit();
+    IMB_exit();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    G.main = bmain;
+    scene = BKE_scene_add(bmain, "Scene");
+
+    node_group = bke::node_tree_add_tree(bmain, "Group", "CompositorNodeTree");
+    node_group->tree_interface.add_socket(
+        "Image", "", "NodeSocketColor", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+    node_group->tree_interface.add_socket(
+        "Image", "", "NodeSocketColor", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+    bNode *input = bke::node_add_node(nullptr, *node_group, "NodeGroupInput");
+    bNode *output = bke::node_add_node(nullptr, *node_group, "NodeGroupOutput");
+    blur = bke::node_add_node(nullptr, *node_group, "CompositorNodeBlur");
+    BKE_main_ensure_invariants(*bmain);
+
+    this->set_blur_size(float2(3.0f, 2.0f));
+
+    bke::node_add_link(*node_group,
+                       *input,
+                       *static_cast<bNodeSocket *>(input->outputs.first),
+                       *blur,
+                       *bke::node_find_socket(*blur, SOCK_IN, "Image"));
+    bke::node_add_link(*node_group,
+                       *blur,
+                       *bke::node_find_socket(*blur, SOCK_OUT, "Image"),
+                       *output,
+                       *static_cast<bNodeSocket *>(output->inputs.first));
+    BKE_main_ensure_invariants(*bmain);
+
+    image.reinitialize(image_size.x * image_size.y);
+    RandomNumberGenerator rng(42);
+    for (float4 &pixel : image) {
+      pixel = float4(rng.get_float(), rng.get_float(), rng.get_float(), 1.0f);
+    }
+  }
+
+  void TearDown() override
+  {
+    cache_manager.free();
+    BKE_main_free(bmain);
+    G.main = nullptr;
+  }
+
+  void set_blur_size(const float2 size)
+  {
+    bNodeSocket *blur_size = bke::node_find_socket(*blur, SOCK_IN, "Size");
+    copy_v2_v2(blur_size->default_value_typed<bNodeSocketValueVector>()->value, size);
+  }
+
+  /* Evaluates the node group on the image and returns the output pixels. The cache hits and misses
+   * of the evaluation are stored in #hits and #misses. */
+  Array<float4> evaluate()
+  {
+    Profiler profiler;
+    TestContext context(cache_manager, *scene, profiler);
+    NodeGroupOperation operation(context,
+                                 *node_group,
+                                 NodeGroupOutputTypes::GroupOutputNode,
+                                 nullptr,
+                                 bke::NODE_INSTANCE_KEY_BASE,
+                                 bke::NODE_INSTANCE_KEY_BASE);
+
+    node_group->ensure_interface_cache();
+    const char *output_identifier = node_group->interface_outputs()[0]->identifier;
+    operation.get_result(output_identifier).set_reference_count(1);
+
+    Result input = context.create_result(ResultType::Color, ResultPrecision::Full);
+    input.wrap_external(image.data(), image_size);
+    operation.map_input_to_result(node_group->interface_inputs()[0]->identifier, &input);
+    operation.evaluate();
+
+    Result &output = operation.get_result(output_identifier);
+    EXPECT_EQ(output.domain().data_size, image_size);
+    Array<float4> pixels(image.size());
+    for (const int y : IndexRange(image_size.y)) {
+      for (const int x : IndexRange(image_size.x)) {
+        pixels[y * image_size.x + x] = float4(output.load_pixel<Color>(int2(x, y)));
+      }
+    }
+    output.release();
+    cache_manager.reset();
+
+    hits = profiler.get_node_results_cache_hits();
+    misses = profiler.get_node_results_cache_misses();
+    return pixels;
+  }
+};
+
+static void expect_equal_pixels(const Span<float4> a, const Span<float4> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_EQ(a[i], b[i]) << "at pixel " << i;
+  }
+}
+
+TEST_F(CachedNodeResultsTest, HitOnUnchangedEvaluation)
+{
+  const Array<float4> first = this->evaluate();
+  EXPECT_EQ(hits, 0);
+  EXPECT_EQ(misses, 1);
+
+  const Array<float4> second = this->evaluate();
+  EXPECT_EQ(hits, 1);
+  EXPECT_EQ(misses, 0);
+  expect_equal_pixels(first, second);
+
+  /* Results that are reused stay cached for the next evaluation. */
+  this->evaluate();
+  EXPECT_EQ(hits, 1);
+  EXPECT_EQ(misses, 0);
+}
+
+TEST_F(CachedNodeResultsTest, MissOnChangedInput)
+{
+  this->evaluate();
+
+  image[image_size.x + 5] = float4(0.0f, 1.0f, 0.0f, 1.0f);
+  const Array<float4> changed = this->evaluate();
+  EXPECT_EQ(hits, 0);
+  EXPECT_EQ(misses, 1);
+
+  /* The results for the changed input match results computed with an empty cache. */
+  cache_manager.free();
+  const Array<float4> recomputed = this->evaluate();
+  EXPECT_EQ(misses, 1);
+  expect_equal_pixels(changed, recomputed);
+}
+
+TEST_F(CachedNodeResultsTest, MissOnChangedProperties)
+{
+  const Array<float4> first = this->evaluate();
+
+  /* Unlinked inputs of the node are part of the key. */
+  this->set_blur_size(float2(5.0f, 1.0f));
+  const Array<float4> resized = this->evaluate();
+  EXPECT_EQ(hits, 0);
+  EXPECT_EQ(misses, 1);
+  EXPECT_NE(first[image_size.x * 10 + 10], resized[image_size.x * 10 + 10]);
+
+  /* So are the custom properties stored in the node. */
+  blur->custom1 += 1;
+  this->evaluate();
+  EXPECT_EQ(hits, 0);
+  EXPECT_EQ(misses, 1);
+
+  /* Evaluating the same state again reuses the results cached in the last evaluation. */
+  this->evaluate();
+  EXPECT_EQ(hits, 1);
+  EXPECT_EQ(misses, 0);
+}
+
+TEST_F(CachedNodeResultsTest, UnusedResultsAreFreed)
+{
+  this->evaluate();
+
+  /* The results of the first size are not needed in this evaluation, so they are freed. */
+  this->set_blur_size(float2(5.0f, 1.0f));
+  this->evaluate();
+  this->set_blur_size(float2(3.0f, 2.0f));
+  this->evaluate();
+  EXPECT_EQ(hits, 0);
+  EXPECT_EQ(misses, 1);
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,191 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <memory>
+#include <sstream>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_serialize.hh"
+
+#include "DNA_scene_types.h"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_profiler.hh"
+#include "COM_result.hh"
+#include "COM_static_cache_manager.hh"
+
+namespace blender::compositor::tests {
+
+/* A CPU context that is only used to allocate results. */
+class TestContext : public Context {
+ private:
+  Scene scene_ = {};
+
+ public:
+  TestContext(StaticCacheManager &cache_manager) : Context(cache_manager) {}
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  Domain get_compositing_domain() const override
+  {
+    return Domain(int2(1));
+  }
+
+  void write_viewer(Result & /*viewer_result*/) override {}
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+};
+
+/* Parse the Chrome trace written by the profiler and return its events. */
+static std::unique_ptr<io::serialize::Value> parse_trace(const Profiler &profiler)
+{
+  std::stringstream stream;
+  profiler.write_chrome_trace(stream);
+  io::serialize::JsonFormatter formatter;
+  return formatter.deserialize(stream);
+}
+
+static const io::serialize::DictionaryValue &event_args(const io::serialize::ArrayValue &events,
+                                                       const int index)
+{
+  return *events.elements()[index]->as_dictionary_value()->lookup_dict("args");
+}
+
+TEST(Profiler, TraceNestingAndMemory)
+{
+  StaticCacheManager cache_manager;
+  TestContext context(cache_manager);
+  Profiler profiler(true);
+
+  profiler.begin_operation("Outer");
+
+  /* 8 floats, 32 bytes. */
+  Result allocated(context, ResultType::Float, ResultPrecision::Full);
+  allocated.allocate_texture(Domain(int2(4, 2)));
+
+  profiler.begin_operation("Inner");
+
+  /* 16 floats, 64 bytes, owned by the result once stolen. */
+  Result stolen(context, ResultType::Float, ResultPrecision::Full);
+  stolen.steal_data(MEM_new_uninitialized_aligned(sizeof(float) * 16, alignof(float), __func__),
+                    Domain(int2(4, 4)));
+
+  /* Stealing the data of another result moves it without allocating. */
+  Result moved(context, ResultType::Float, ResultPrecision::Full);
+  moved.steal_data(stolen);
+  moved.free();
+
+  profiler.end_operation(16);
+
+  allocated.free();
+
+  profiler.end_operation(8);
+
+  /* All results are freed at this point, so its peak is the memory used by other results. */
+  profiler.begin_operation("Sibling");
+  profiler.end_operation(0);
+
+  const std::unique_ptr<io::serialize::Value> trace = parse_trace(profiler);
+  ASSERT_NE(trace, nullptr);
+  const io::serialize::ArrayValue *events = trace->as_dictionary_value()->lookup_array(
+      "traceEvents");
+  ASSERT_NE(events, nullptr);
+  ASSERT_EQ(events->elements().size(), 3);
+
+  const io::serialize::DictionaryValue *outer = events->elements()[0]->as_dictionary_value();
+  const io::serialize::DictionaryValue *inner = events->elements()[1]->as_dictionary_value();
+  const io::serialize::DictionaryValue *sibling = events->elements()[2]->as_dictionary_value();
+  EXPECT_EQ(outer->lookup_str("name"), "Outer");
+  EXPECT_EQ(inner->lookup_str("name"), "Inner");
+  EXPECT_EQ(sibling->lookup_str("name"), "Sibling");
+
+  const io::serialize::DictionaryValue &outer_args = event_args(*events, 0);
+  const io::serialize::DictionaryValue &inner_args = event_args(*events, 1);
+  const io::serialize::DictionaryValue &sibling_args = event_args(*events, 2);
+
+  EXPECT_EQ(outer_args.lookup_int("depth"), 0);
+  EXPECT_EQ(inner_args.lookup_int("depth"), 1);
+  EXPECT_EQ(sibling_args.lookup_int("depth"), 0);
+
+  EXPECT_EQ(outer_args.lookup_int("pixels"), 8);
+  EXPECT_EQ(inner_args.lookup_int("pixels"), 16);
+
+  /* Allocations of nested operations are included in their parent. */
+  EXPECT_EQ(outer_args.lookup_int("allocations"), 2);
+  EXPECT_EQ(outer_args.lookup_int("allocated_bytes"), 96);
+  EXPECT_EQ(inner_args.lookup_int("allocations"), 1);
+  EXPECT_EQ(inner_args.lookup_int("allocated_bytes"), 64);
+  EXPECT_EQ(sibling_args.lookup_int("allocations"), 0);
+  EXPECT_EQ(sibling_args.lookup_int("allocated_bytes"), 0);
+
+  /* Both results are alive at the same time inside of the inner operation. */
+  const int64_t base_memory = *sibling_args.lookup_int("peak_memory_bytes");
+  EXPECT_EQ(*outer_args.lookup_int("peak_memory_bytes") - base_memory, 96);
+  EXPECT_EQ(*inner_args.lookup_int("peak_memory_bytes") - base_memory, 96);
+}
+
+/* Profilers that record at the same time, like compositors rendering in parallel, track the peak
+ * memory of their operations independently. */
+TEST(Profiler, ConcurrentTracesPeakMemory)
+{
+  StaticCacheManager cache_manager;
+  TestContext context(cache_manager);
+  Profiler profiler(true);
+  Profiler other_profiler(true);
+
+  profiler.begin_operation("Operation");
+
+  /* 8 floats, 32 bytes, freed before the operation ends. */
+  Result allocated(context, ResultType::Float, ResultPrecision::Full);
+  allocated.allocate_texture(Domain(int2(4, 2)));
+  allocated.free();
+
+  /* An operation of the other profiler doesn't reset the peak of the first one. */
+  other_profiler.begin_operation("Other");
+  other_profiler.end_operation(0);
+
+  profiler.end_operation(8);
+
+  profiler.begin_operation("Sibling");
+  profiler.end_operation(0);
+
+  const std::unique_ptr<io::serialize::Value> trace = parse_trace(profiler);
+  ASSERT_NE(trace, nullptr);
+  const io::serialize::ArrayValue *events = trace->as_dictionary_value()->lookup_array(
+      "traceEvents");
+  ASSERT_NE(events, nullptr);
+  ASSERT_EQ(events->elements().size(), 2);
+
+  const int64_t base_memory = *event_args(*events, 1).lookup_int("peak_memory_bytes");
+  EXPECT_EQ(*event_args(*events, 0).lookup_int("peak_memory_bytes") - base_memory, 32);
+}
+
+TEST(Profiler, NoTraceWithoutRecording)
+{
+  Profiler profiler;
+  EXPECT_FALSE(profiler.is_recording_operations());
+
+  profiler.begin_operation("Operation");
+  profiler.end_operation(1);
+
+  const std::unique_ptr<io::serialize::Value> trace = parse_trace(profiler);
+  ASSERT_NE(trace, nullptr);
+  const io::serialize::ArrayValue *events = trace->as_dictionary_value()->lookup_array(
+      "traceEvents");
+  ASSERT_NE(events, nullptr);
+  EXPECT_TRUE(events->elements().is_empty());
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,237 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_bounds_types.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+
+#include "CLG_log.h"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_appdir.hh"
+#include "BKE_global.hh"
+#include "BKE_idtype.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_material.hh"
+#include "BKE_node.hh"
+#include "BKE_node_runtime.hh"
+#include "BKE_scene.hh"
+
+#include "IMB_imbuf.hh"
+
+#include "RNA_define.hh"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_node_group_operation.hh"
+#include "COM_result.hh"
+#include "COM_static_cache_manager.hh"
+
+namespace blender::compositor::tests {
+
+static const int2 image_size = int2(64, 48);
+
+/* A CPU context that composites an image of a fixed size and needs the given region of it. */
+class TestContext : public Context {
+ private:
+  const Scene &scene_;
+  std::optional<Bounds<int2>> region_of_interest_;
+
+ public:
+  TestContext(StaticCacheManager &cache_manager,
+              const Scene &scene,
+              const std::optional<Bounds<int2>> &region_of_interest)
+      : Context(cache_manager), scene_(scene), region_of_interest_(region_of_interest)
+  {
+  }
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  Domain get_compositing_domain() const override
+  {
+    return Domain(image_size);
+  }
+
+  Bounds<int2> get_region_of_interest() const override
+  {
+    return region_of_interest_ ? *region_of_interest_ : Context::get_region_of_interest();
+  }
+
+  void write_viewer(Result & /*viewer_result*/) override {}
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+};
+
+class RegionOfInterestTest : public ::testing::Test {
+ protected:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  /* Inverts, blurs, then inverts the input image again, such that the region of interest is
+   * propagated through both pixel and filter nodes. */
+  bNodeTree *node_group = nullptr;
+  Array<float4> image;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    RNA_init();
+    bke::node_system_init();
+    BKE_appdir_init();
+    IMB_init();
+    BKE_materials_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    BKE_materials_exit();
+    bke::node_system_exit();
+    RNA_exit();
+    BKE_appdir_exit();
+    IMB_exit();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    G.main = bmain;
+    scene = BKE_scene_add(bmain, "Scene");
+
+    node_group = bke::node_tree_add_tree(bmain, "Group", "CompositorNodeTree");
+    node_group->tree_interface.add_socket(
+        "Image", "", "NodeSocketColor", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+    node_group->tree_interface.add_socket(
+        "Image", "", "NodeSocketColor", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+    bNode *input = bke::node_add_node(nullptr, *node_group, "NodeGroupInput");
+    bNode *output = bke::node_add_node(nullptr, *node_group, "NodeGroupOutput");
+    bNode *invert = bke::node_add_node(nullptr, *node_group, "CompositorNodeInvert");
+    bNode *blur = bke::node_add_node(nullptr, *node_group, "CompositorNodeBlur");
+    bNode *invert_again = bke::node_add_node(nullptr, *node_group, "CompositorNodeInvert");
+    BKE_main_ensure_invariants(*bmain);
+
+    bNodeSocket *blur_size = bke::node_find_socket(*blur, SOCK_IN, "Size");
+    copy_v2_fl2(blur_size->default_value_typed<bNodeSocketValueVector>()->value, 3.0f, 2.0f);
+
+    bke::node_add_link(*node_group,
+                       *input,
+                       *static_cast<bNodeSocket *>(input->outputs.first),
+                       *invert,
+                       *bke::node_find_socket(*invert, SOCK_IN, "Color"));
+    bke::node_add_link(*node_group,
+                       *invert,
+                       *bke::node_find_socket(*invert, SOCK_OUT, "Color"),
+                       *blur,
+                       *bke::node_find_socket(*blur, SOCK_IN, "Image"));
+    bke::node_add_link(*node_group,
+                       *blur,
+                       *bke::node_find_socket(*blur, SOCK_OUT, "Image"),
+                       *invert_again,
+                       *bke::node_find_socket(*invert_again, SOCK_IN, "Color"));
+    bke::node_add_link(*node_group,
+                       *invert_again,
+                       *bke::node_find_socket(*invert_again, SOCK_OUT, "Color"),
+                       *output,
+                       *static_cast<bNodeSocket *>(output->inputs.first));
+    BKE_main_ensure_invariants(*bmain);
+
+    image.reinitialize(image_size.x * image_size.y);
+    RandomNumberGenerator rng(42);
+    for (float4 &pixel : image) {
+      pixel = float4(rng.get_float(), rng.get_float(), rng.get_float(), 1.0f);
+    }
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+    G.main = nullptr;
+  }
+
+  /* Evaluates the node group on the image, returning the domain of the output and its pixels in
+   * the display window, which are zero outside of the data window. */
+  Array<float4> evaluate(const std::optional<Bounds<int2>> &region_of_interest, Domain &r_domain)
+  {
+    StaticCacheManager cache_manager;
+    TestContext context(cache_manager, *scene, region_of_interest);
+    NodeGroupOperation operation(context,
+                                 *node_group,
+                                 NodeGroupOutputTypes::GroupOutputNode,
+                                 nullptr,
+                                 bke::NODE_INSTANCE_KEY_BASE,
+                                 bke::NODE_INSTANCE_KEY_BASE);
+
+    node_group->ensure_interface_cache();
+    const char *output_identifier = node_group->interface_outputs()[0]->identifier;
+    operation.get_result(output_identifier).set_reference_count(1);
+
+    Result input = context.create_result(ResultType::Color, ResultPrecision::Full);
+    input.wrap_external(image.data(), image_size);
+    operation.map_input_to_result(node_group->interface_inputs()[0]->identifier, &input);
+    operation.evaluate();
+
+    Result &output = operation.get_result(output_identifier);
+    r_domain = output.domain();
+    Array<float4> pixels(image.size(), float4(0.0f));
+    for (const int y : IndexRange(r_domain.data_size.y)) {
+      for (const int x : IndexRange(r_domain.data_size.x)) {
+        const int2 texel = int2(x, y) + r_domain.data_offset;
+        pixels[texel.y * image_size.x + texel.x] = float4(output.load_pixel<Color>(int2(x, y)));
+      }
+    }
+    output.release();
+    cache_manager.reset();
+    return pixels;
+  }
+};
+
+TEST_F(RegionOfInterestTest, CroppedMatchesFullEvaluation)
+{
+  Domain full_domain = Domain::identity();
+  const Array<float4> full = this->evaluate(std::nullopt, full_domain);
+  EXPECT_EQ(full_domain.data_size, image_size);
+  EXPECT_EQ(full_domain.data_offset, int2(0));
+
+  const Bounds<int2> region(int2(10, 7), int2(41, 30));
+  Domain cropped_domain = Domain::identity();
+  const Array<float4> cropped = this->evaluate(region, cropped_domain);
+
+  /* Only the region of interest is computed. */
+  EXPECT_EQ(cropped_domain.display_size, image_size);
+  EXPECT_EQ(cropped_domain.data_offset, region.min);
+  EXPECT_EQ(cropped_domain.data_size, region.size());
+
+  for (const int y : IndexRange(region.min.y, region.size().y)) {
+    for (const int x : IndexRange(region.min.x, region.size().x)) {
+      const int index = y * image_size.x + x;
+      for (const int channel : IndexRange(4)) {
+        EXPECT_NEAR(cropped[index][channel], full[index][channel], 1e-6f)
+            << "at pixel " << x << ", " << y;
+      }
+    }
+  }
+}
+
+TEST_F(RegionOfInterestTest, RegionOutsideImage)
+{
+  /* A region that covers the entire image computes the entire image. */
+  Domain domain = Domain::identity();
+  this->evaluate(Bounds<int2>(int2(-5), image_size + 5), domain);
+  EXPECT_EQ(domain.data_offset, int2(0));
+  EXPECT_EQ(domain.data_size, image_size);
+}
+
+}  // namespace blender::compositor::tests
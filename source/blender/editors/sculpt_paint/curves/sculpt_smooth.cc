@@ -112,8 +112,19 @@ struct SmoothOperationExecutor {
       BLI_assert_unreachable();
     }
 
+    /* Only the curves touched by the brush need their evaluated data to be updated. */
+    const OffsetIndices points_by_curve = curves_->points_by_curve();
+    IndexMaskMemory memory;
+    const IndexMask changed_curves = IndexMask::from_predicate(
+        curve_selection_, memory, [&](const int64_t curve_i) {
+          const Span<float> factors = point_smooth_factors.as_span().slice(
+              points_by_curve[curve_i]);
+          return std::any_of(
+              factors.begin(), factors.end(), [](const float factor) { return factor != 0.0f; });
+        });
+
     this->smooth(point_smooth_factors);
-    curves_->tag_positions_changed();
+    curves_->tag_positions_changed(changed_curves);
     DEG_id_tag_update(&curves_id_->id, ID_RECALC_GEOMETRY);
     WM_main_add_notifier(NC_GEOM | ND_DATA, &curves_id_->id);
     ED_region_tag_redraw(ctx_.region);
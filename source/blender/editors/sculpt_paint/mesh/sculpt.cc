@@ -3283,6 +3283,10 @@ static void do_brush_action(const Depsgraph &depsgraph,
     push_undo_nodes(depsgraph, ob, brush, node_mask);
   }
 
+  BitVector<> &step_changed_nodes = ss.cache->step_changed_nodes;
+  step_changed_nodes.resize(std::max(step_changed_nodes.size(), node_mask.min_array_size()));
+  node_mask.set_bits(step_changed_nodes);
+
   /* There are issues with the underlying normals cache / mesh data that can cause the data to
    * become out of date.
    *
@@ -3673,9 +3677,15 @@ static void sculpt_fix_noise_tear(const Sculpt &sd, Object &ob)
   const Brush &brush = *BKE_paint_brush_for_read(&sd.paint);
   const MTex *mtex = BKE_brush_mask_texture_get(&brush, OB_MODE_SCULPT);
 
-  if (ss.multires_modifier && mtex->tex && mtex->tex->type == TEX_NOISE) {
-    multires_stitch_grids(&ob);
+  if (ss.multires_modifier && mtex->tex && mtex->tex->type == TEX_NOISE && ss.subdiv_ccg) {
+    const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(ob);
+    IndexMaskMemory memory;
+    const IndexMask node_mask = IndexMask::from_bits(ss.cache->step_changed_nodes, memory);
+    const IndexMask face_mask = bke::pbvh::nodes_to_face_selection_grids(
+        *ss.subdiv_ccg, pbvh.nodes<bke::pbvh::GridsNode>(), node_mask, memory);
+    multires_stitch_grids(&ob, face_mask);
   }
+  ss.cache->step_changed_nodes.clear();
 }
 
 static void do_symmetrical_brush_actions(const Depsgraph &depsgraph,
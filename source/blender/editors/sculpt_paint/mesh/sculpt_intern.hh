@@ -16,6 +16,7 @@
 #include "BKE_subdiv_ccg.hh"
 
 #include "BLI_array.hh"
+#include "BLI_bit_vector.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_quaternion_types.hh"
 #include "BLI_math_vector_types.hh"
@@ -199,6 +200,12 @@ struct StrokeCache {
 
   bool is_last_valid = false;
 
+  /**
+   * Nodes changed by the brush in the current step, accumulated over symmetry passes. Used to only
+   * stitch the multires grids of these nodes after brushes that can tear the grids apart.
+   */
+  BitVector<> step_changed_nodes;
+
   bool pen_flip = false;
 
   /**
@@ -136,6 +136,11 @@ ImBuf *sequencer_ibuf_get(const bContext *C, const int timeline_frame, const cha
   context.view_id = BKE_scene_multiview_view_id_get(&scene->r, viewname);
   context.use_proxies = (sseq->flag & SEQ_USE_PROXIES) != 0;
   context.is_playing = screen->animtimer != nullptr;
+  if (screen->animtimer) {
+    const ScreenAnimData *sad = static_cast<const ScreenAnimData *>(
+        screen->animtimer->customdata);
+    context.is_playing_backwards = (sad->flag & ANIMPLAY_FLAG_REVERSE) != 0;
+  }
   context.is_scrubbing = screen->scrubbing;
 
   /* Sequencer could start rendering, in this case we need to be sure it wouldn't be
@@ -34,6 +34,8 @@
  * they share common sub-fields and a common context.
  */
 
+#include <atomic>
+
 #include "BLI_function_ref.hh"
 #include "BLI_generic_virtual_array.hh"
 #include "BLI_string_ref.hh"
@@ -215,6 +217,8 @@ template<typename T>
 static constexpr bool is_field_v = std::is_base_of_v<detail::TypedFieldBase, T> &&
                                    !std::is_same_v<detail::TypedFieldBase, T>;
 
+class FieldResultCache;
+
 /**
  * A #FieldNode that allows composing existing fields into new fields.
  */
@@ -229,6 +233,9 @@ class FieldOperation : public FieldNode {
   /** Inputs to the operation. */
   Vector<GField> inputs_;
 
+  /** Evaluated outputs of this operation, created when they are cached for the first time. */
+  mutable std::atomic<FieldResultCache *> result_cache_ = nullptr;
+
  public:
   FieldOperation(std::shared_ptr<const mf::MultiFunction> function, Vector<GField> inputs = {});
   FieldOperation(const mf::MultiFunction &function, Vector<GField> inputs = {});
@@ -236,22 +243,24 @@ class FieldOperation : public FieldNode {
 
   Span<GField> inputs() const;
   const mf::MultiFunction &multi_function() const;
+  FieldResultCache &result_cache() const;
 
   const CPPType &output_cpp_type(int output_index) const override;
 
   static std::shared_ptr<FieldOperation> from(std::shared_ptr<const mf::MultiFunction> function,
                                               Vector<GField> inputs = {})
   {
-    return std::make_shared<FieldOperation>(FieldOperation(std::move(function), inputs));
+    return std::make_shared<FieldOperation>(std::move(function), std::move(inputs));
   }
   static std::shared_ptr<FieldOperation> from(const mf::MultiFunction &function,
                                               Vector<GField> inputs = {})
   {
-    return std::make_shared<FieldOperation>(FieldOperation(function, inputs));
+    return std::make_shared<FieldOperation>(function, std::move(inputs));
   }
 };
 
 class FieldContext;
+class FieldResultCacheState;
 
 /**
  * A #FieldNode that represents an input to the entire field-tree.
@@ -331,6 +340,13 @@ class FieldContext {
   virtual GVArray get_varray_for_input(const FieldInput &field_input,
                                        const IndexMask &mask,
                                        ResourceScope &scope) const;
+
+  /**
+   * Add the state of all data that fields may read in this context to #r_state, so that evaluated
+   * fields can be reused when they are evaluated on the same data again. Returns false if results
+   * can't be cached in this context.
+   */
+  virtual bool result_cache_state(FieldResultCacheState &r_state) const;
 };
 
 /**
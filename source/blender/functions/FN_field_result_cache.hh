@@ -0,0 +1,122 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup fn
+ *
+ * Evaluated fields can be cached so that they don't have to be computed again when the same field
+ * is evaluated on the same data later on. For example, when one noise texture is used by multiple
+ * nodes that process the same geometry, it only has to be computed once.
+ *
+ * Every #FieldOperation owns the cache of its results, so they are freed together with the field.
+ * Fields are built by the evaluation that uses them, e.g. a geometry nodes evaluation, so cached
+ * results don't outlive it. The #FieldContext describes the data that the fields are evaluated on.
+ * Results are only reused when that data is unchanged, see #FieldResultCacheState.
+ */
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_map.hh"
+#include "BLI_mutex.hh"
+#include "BLI_timeit.hh"
+
+#include "FN_field.hh"
+
+namespace blender::fn {
+
+/**
+ * Identifies the state of all data that fields may read from a #FieldContext. Cached results are
+ * only reused when the state is exactly the same.
+ *
+ * Only data that is currently shared can be part of a valid state. Shared data can't be modified
+ * in place, so it is known to stay unchanged as long as its #ImplicitSharingInfo and version are
+ * the same. Data that is mutable might still be written to by its owner without a new version,
+ * e.g. while the field is evaluated into it.
+ */
+class FieldResultCacheState {
+ private:
+  Vector<int64_t> values_;
+  Vector<std::string> names_;
+  Vector<std::pair<const ImplicitSharingInfo *, int64_t>> data_;
+  bool is_valid_ = true;
+
+  friend class FieldResultCache;
+
+ public:
+  /** Add e.g. a domain or its size, which distinguishes evaluations on the same data. */
+  void add_value(int64_t value);
+  /** Add e.g. an attribute name, which determines which data a field input reads. */
+  void add_name(StringRef name);
+  /** Add data that fields may depend on. The state becomes invalid if the data is mutable. */
+  void add_data(const ImplicitSharingInfo *sharing_info);
+
+  /** False if the results of this evaluation must not be cached. */
+  bool is_valid() const;
+
+  uint64_t hash() const;
+  friend bool operator==(const FieldResultCacheState &a, const FieldResultCacheState &b);
+};
+
+/**
+ * Stores the evaluated outputs of one #FieldOperation for the states of the contexts it has been
+ * evaluated in. Cached values only reference the data they were computed from weakly, so a field
+ * that captures the data it is evaluated on can't create a reference cycle.
+ */
+class FieldResultCache : NonCopyable, NonMovable {
+ private:
+  struct Key {
+    int output_index;
+    FieldResultCacheState state;
+
+    uint64_t hash() const;
+
+    friend bool operator==(const Key &a, const Key &b)
+    {
+      return a.output_index == b.output_index && a.state == b.state;
+    }
+  };
+
+  struct Result {
+    GVArray varray;
+    /** Approximate time it took to compute the result originally. */
+    timeit::Nanoseconds compute_time;
+  };
+
+  Mutex mutex_;
+  Map<Key, Result> results_;
+  int64_t size_in_bytes_ = 0;
+
+ public:
+  FieldResultCache() = default;
+  ~FieldResultCache();
+
+  /** Find a result that has been computed for the operation output and state before. */
+  std::optional<GVArray> lookup(int output_index, const FieldResultCacheState &state);
+
+  /** Store the result of an operation output evaluated in the given state. */
+  void add(int output_index,
+           const FieldResultCacheState &state,
+           GVArray varray,
+           timeit::Nanoseconds compute_time);
+
+  /** Remove all cached results. */
+  void clear();
+
+ private:
+  void clear_locked();
+};
+
+/** Statistics about all #FieldResultCache since the last reset, used to measure their benefit. */
+struct FieldResultCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  /** Sum of the time it took to compute the results originally, for every time they were reused. */
+  timeit::Nanoseconds saved_time{0};
+};
+
+FieldResultCacheStats field_result_cache_stats();
+void field_result_cache_stats_reset();
+
+}  // namespace blender::fn
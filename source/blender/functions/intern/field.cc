@@ -2,14 +2,18 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <atomic>
+
 #include "BLI_array_utils.hh"
 #include "BLI_map.hh"
 #include "BLI_multi_value_map.hh"
 #include "BLI_set.hh"
 #include "BLI_stack.hh"
+#include "BLI_timeit.hh"
 #include "BLI_vector_set.hh"
 
 #include "FN_field.hh"
+#include "FN_field_result_cache.hh"
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_procedure.hh"
 #include "FN_multi_function_procedure_builder.hh"
@@ -365,6 +369,40 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     }
   }
 
+  /* Reuse varying fields that have been evaluated on the same data before. Only evaluations of
+   * the full domain are cached. */
+  FieldResultCacheState cache_state;
+  bool use_result_cache = false;
+  if (!varying_fields_to_evaluate.is_empty() && mask.size() == array_size) {
+    use_result_cache = context.result_cache_state(cache_state) && cache_state.is_valid();
+  }
+  Vector<int> fields_to_cache;
+  if (use_result_cache) {
+    Vector<GFieldRef> remaining_fields;
+    Vector<int> remaining_indices;
+    for (const int i : varying_fields_to_evaluate.index_range()) {
+      const GFieldRef &field = varying_fields_to_evaluate[i];
+      const int out_index = varying_field_indices[i];
+      if (!field.cpp_type().is_trivial) {
+        remaining_fields.append(field);
+        remaining_indices.append(out_index);
+        continue;
+      }
+      const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+      if (std::optional<GVArray> cached_varray = operation.result_cache().lookup(
+              field.node_output_index(), cache_state))
+      {
+        varrays[out_index] = std::move(*cached_varray);
+        continue;
+      }
+      fields_to_cache.append(remaining_fields.size());
+      remaining_fields.append(field);
+      remaining_indices.append(out_index);
+    }
+    varying_fields_to_evaluate = std::move(remaining_fields);
+    varying_field_indices = std::move(remaining_indices);
+  }
+
   /* Evaluate varying fields if necessary. */
   if (!varying_fields_to_evaluate.is_empty()) {
     /* Build the procedure for those fields. */
@@ -381,6 +419,10 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
       mf_params.add_readonly_single_input(varray);
     }
 
+    /* Results that are cached and have no destination span are written into arrays that are
+     * moved into the cache afterwards. */
+    Map<int, GArray<>> arrays_to_cache;
+
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
       const CPPType &type = field.cpp_type();
@@ -389,7 +431,17 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
       /* Try to get an existing virtual array that the result should be written into. */
       GVMutableArray dst_varray = get_dst_varray(out_index);
       void *buffer;
-      if (!dst_varray || !dst_varray.is_span()) {
+      if (dst_varray && dst_varray.is_span()) {
+        /* Write the result into the existing span. */
+        buffer = dst_varray.get_internal_span().data();
+
+        varrays[out_index] = dst_varray;
+        is_output_written_to_dst[out_index] = true;
+      }
+      else if (fields_to_cache.contains(i)) {
+        buffer = arrays_to_cache.lookup_or_add(i, GArray<>(type, array_size)).data();
+      }
+      else {
         /* Allocate a new buffer for the computed result. */
         buffer = scope.allocator().allocate_array(type, array_size);
 
@@ -401,20 +453,36 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
         varrays[out_index] = GVArray::from_span({type, buffer, array_size});
       }
-      else {
-        /* Write the result into the existing span. */
-        buffer = dst_varray.get_internal_span().data();
-
-        varrays[out_index] = dst_varray;
-        is_output_written_to_dst[out_index] = true;
-      }
 
       /* Pass output buffer to the procedure executor. */
       const GMutableSpan span{type, buffer, array_size};
       mf_params.add_uninitialized_single_output(span);
     }
 
+    const timeit::TimePoint start_time = timeit::Clock::now();
     procedure_executor.call_auto(mask, mf_params, mf_context);
+
+    if (!fields_to_cache.is_empty()) {
+      /* The time spent on the individual fields is unknown, so distribute it evenly. */
+      const timeit::Nanoseconds compute_time = (timeit::Clock::now() - start_time) /
+                                               varying_fields_to_evaluate.size();
+      for (const int i : fields_to_cache) {
+        const GFieldRef &field = varying_fields_to_evaluate[i];
+        const int out_index = varying_field_indices[i];
+        GVArray cached_varray;
+        if (GArray<> *array = arrays_to_cache.lookup_ptr(i)) {
+          varrays[out_index] = GVArray::from_garray(std::move(*array));
+          cached_varray = varrays[out_index];
+        }
+        else {
+          /* The result has been written into the destination, which is owned by the caller. */
+          cached_varray = GVArray::from_garray(GArray<>(varrays[out_index].get_internal_span()));
+        }
+        const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+        operation.result_cache().add(
+            field.node_output_index(), cache_state, std::move(cached_varray), compute_time);
+      }
+    }
   }
 
   /* Evaluate constant fields if necessary. */
@@ -540,6 +608,11 @@ GVArray FieldContext::get_varray_for_input(const FieldInput &field_input,
   return field_input.get_varray_for_context(*this, mask, scope);
 }
 
+bool FieldContext::result_cache_state(FieldResultCacheState & /*r_state*/) const
+{
+  return false;
+}
+
 IndexFieldInput::IndexFieldInput() : FieldInput(CPPType::get<int>(), "Index")
 {
   category_ = Category::Generated;
@@ -605,7 +678,25 @@ FieldOperation::FieldOperation(std::shared_ptr<const mf::MultiFunction> function
 }
 
 /* Avoid generating the destructor in every translation unit. */
-FieldOperation::~FieldOperation() = default;
+FieldOperation::~FieldOperation()
+{
+  delete result_cache_.load(std::memory_order_relaxed);
+}
+
+FieldResultCache &FieldOperation::result_cache() const
+{
+  if (FieldResultCache *cache = result_cache_.load(std::memory_order_acquire)) {
+    return *cache;
+  }
+  /* The operation may be evaluated by multiple threads at the same time. */
+  FieldResultCache *new_cache = new FieldResultCache();
+  FieldResultCache *expected = nullptr;
+  if (result_cache_.compare_exchange_strong(expected, new_cache, std::memory_order_acq_rel)) {
+    return *new_cache;
+  }
+  delete new_cache;
+  return *expected;
+}
 
 /**
  * Returns the field inputs used by all the provided fields.
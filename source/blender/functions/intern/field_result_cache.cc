@@ -0,0 +1,170 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <atomic>
+
+#include "BLI_hash.hh"
+
+#include "FN_field_result_cache.hh"
+
+namespace blender::fn {
+
+/**
+ * A field may be evaluated on many different geometries while it is alive, so the size of its
+ * cache is limited. When the limit is exceeded, all results are removed, because results for
+ * earlier geometries are less likely to be used again.
+ */
+static constexpr int64_t max_cache_size_in_bytes = 256 * 1024 * 1024;
+
+static std::atomic<int64_t> stats_hits = 0;
+static std::atomic<int64_t> stats_misses = 0;
+static std::atomic<int64_t> stats_saved_time_ns = 0;
+
+/* -------------------------------------------------------------------- */
+/** \name #FieldResultCacheState
+ * \{ */
+
+void FieldResultCacheState::add_value(const int64_t value)
+{
+  values_.append(value);
+}
+
+void FieldResultCacheState::add_name(const StringRef name)
+{
+  names_.append(name);
+}
+
+void FieldResultCacheState::add_data(const ImplicitSharingInfo *sharing_info)
+{
+  if (sharing_info == nullptr || sharing_info->is_mutable()) {
+    is_valid_ = false;
+    return;
+  }
+  data_.append({sharing_info, sharing_info->version()});
+}
+
+bool FieldResultCacheState::is_valid() const
+{
+  return is_valid_;
+}
+
+uint64_t FieldResultCacheState::hash() const
+{
+  uint64_t hash = 0;
+  for (const int64_t value : values_) {
+    hash = get_default_hash(hash, value);
+  }
+  for (const std::string &name : names_) {
+    hash = get_default_hash(hash, StringRef(name));
+  }
+  for (const auto &[sharing_info, version] : data_) {
+    hash = get_default_hash(hash, sharing_info, version);
+  }
+  return hash;
+}
+
+bool operator==(const FieldResultCacheState &a, const FieldResultCacheState &b)
+{
+  return a.values_ == b.values_ && a.names_ == b.names_ && a.data_ == b.data_;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name #FieldResultCache
+ * \{ */
+
+uint64_t FieldResultCache::Key::hash() const
+{
+  return get_default_hash(this->output_index, this->state.hash());
+}
+
+FieldResultCache::~FieldResultCache()
+{
+  this->clear_locked();
+}
+
+std::optional<GVArray> FieldResultCache::lookup(const int output_index,
+                                                const FieldResultCacheState &state)
+{
+  BLI_assert(state.is_valid());
+  const Key key{output_index, state};
+
+  std::lock_guard lock{mutex_};
+  if (const Result *result = results_.lookup_ptr(key)) {
+    stats_hits.fetch_add(1, std::memory_order_relaxed);
+    stats_saved_time_ns.fetch_add(result->compute_time.count(), std::memory_order_relaxed);
+    return result->varray;
+  }
+  stats_misses.fetch_add(1, std::memory_order_relaxed);
+  return std::nullopt;
+}
+
+void FieldResultCache::add(const int output_index,
+                           const FieldResultCacheState &state,
+                           GVArray varray,
+                           const timeit::Nanoseconds compute_time)
+{
+  BLI_assert(state.is_valid());
+  const int64_t size_in_bytes = varray.type().size * varray.size();
+
+  std::lock_guard lock{mutex_};
+  if (size_in_bytes_ + size_in_bytes > max_cache_size_in_bytes) {
+    this->clear_locked();
+  }
+  Key key{output_index, state};
+  if (!results_.add(std::move(key), Result{std::move(varray), compute_time})) {
+    /* The same result has been computed by another thread already. */
+    return;
+  }
+  /* Keep the sharing infos alive, so that their memory can't be reused for other data that could
+   * be mistaken for the data that the result has been computed from. */
+  for (const auto &item : state.data_) {
+    item.first->add_weak_user();
+  }
+  size_in_bytes_ += size_in_bytes;
+}
+
+void FieldResultCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  this->clear_locked();
+}
+
+void FieldResultCache::clear_locked()
+{
+  for (const Key &key : results_.keys()) {
+    for (const auto &item : key.state.data_) {
+      item.first->remove_weak_user_and_delete_if_last();
+    }
+  }
+  results_.clear();
+  size_in_bytes_ = 0;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Statistics
+ * \{ */
+
+FieldResultCacheStats field_result_cache_stats()
+{
+  FieldResultCacheStats stats;
+  stats.hits = stats_hits.load(std::memory_order_relaxed);
+  stats.misses = stats_misses.load(std::memory_order_relaxed);
+  stats.saved_time = timeit::Nanoseconds(stats_saved_time_ns.load(std::memory_order_relaxed));
+  return stats;
+}
+
+void field_result_cache_stats_reset()
+{
+  stats_hits.store(0, std::memory_order_relaxed);
+  stats_misses.store(0, std::memory_order_relaxed);
+  stats_saved_time_ns.store(0, std::memory_order_relaxed);
+}
+
+/** \} */
+
+}  // namespace blender::fn
@@ -4,8 +4,11 @@
 
 #include "testing/testing.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_cpp_type.hh"
 #include "FN_field.hh"
+#include "FN_field_result_cache.hh"
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_test_common.hh"
 
@@ -299,4 +302,102 @@ TEST(field, EvaluateWithVArrayPtr)
   EXPECT_EQ(dst_b[1], 20);
 }
 
+class CachedFieldContext : public FieldContext {
+ public:
+  int64_t value = 0;
+  const ImplicitSharingInfo *data = nullptr;
+
+  bool result_cache_state(FieldResultCacheState &r_state) const override
+  {
+    r_state.add_value(this->value);
+    if (this->data) {
+      r_state.add_data(this->data);
+    }
+    return true;
+  }
+};
+
+TEST(field, ResultCache)
+{
+  int calls_num = 0;
+  auto add_fn = mf::build::SI1_SO<int, int>("add one", [&](const int a) {
+    calls_num++;
+    return a + 1;
+  });
+  GField index_field{std::make_shared<IndexFieldInput>()};
+  GField output_field{FieldOperation::from(add_fn, {index_field}), 0};
+
+  CachedFieldContext context;
+  auto evaluate = [&]() {
+    Array<int> result(4);
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(result[0], 1);
+    EXPECT_EQ(result[3], 4);
+  };
+
+  field_result_cache_stats_reset();
+  evaluate();
+  EXPECT_EQ(calls_num, 4);
+  evaluate();
+  EXPECT_EQ(calls_num, 4);
+  EXPECT_EQ(field_result_cache_stats().hits, 1);
+  EXPECT_EQ(field_result_cache_stats().misses, 1);
+
+  /* A different state of the context has to be evaluated again. */
+  context.value = 1;
+  evaluate();
+  EXPECT_EQ(calls_num, 8);
+
+  /* Results that depend on mutable data are not cached. */
+  context.data = implicit_sharing::info_for_mem_free(MEM_new_uninitialized(4, __func__));
+  evaluate();
+  evaluate();
+  EXPECT_EQ(calls_num, 16);
+
+  /* Shared data can't change without a new version, so results can be cached again. */
+  context.data->add_user();
+  evaluate();
+  evaluate();
+  EXPECT_EQ(calls_num, 20);
+
+  /* The cached results are freed with the field. */
+  output_field = GField();
+  context.data->remove_user_and_delete_if_last();
+  context.data->remove_user_and_delete_if_last();
+}
+
+TEST(field, ResultCacheWithoutDestination)
+{
+  int calls_num = 0;
+  auto add_fn = mf::build::SI1_SO<int, int>("add one", [&](const int a) {
+    calls_num++;
+    return a + 1;
+  });
+  GField index_field{std::make_shared<IndexFieldInput>()};
+  GField output_field{FieldOperation::from(add_fn, {index_field}), 0};
+
+  const CachedFieldContext context;
+  auto evaluate = [&]() {
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add(output_field);
+    evaluator.evaluate();
+    const VArray<int> result = evaluator.get_evaluated<int>(0);
+    EXPECT_EQ(result[0], 1);
+    EXPECT_EQ(result[3], 4);
+  };
+
+  /* The cached result stays valid after the evaluator that computed it is destructed. */
+  evaluate();
+  evaluate();
+  EXPECT_EQ(calls_num, 4);
+
+  /* The cache belongs to the operation, so an equal field that is built again is evaluated. */
+  GField rebuilt_field{FieldOperation::from(add_fn, {index_field}), 0};
+  std::swap(output_field, rebuilt_field);
+  evaluate();
+  EXPECT_EQ(calls_num, 8);
+}
+
 }  // namespace blender::fn::tests
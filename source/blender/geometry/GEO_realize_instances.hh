@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "BLI_function_ref.hh"
+
 #include "BKE_geometry_set.hh"
 
 namespace blender::geometry {
@@ -77,4 +79,21 @@ RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
                                          const RealizeInstancesOptions &options,
                                          const VariedDepthOptions &varied_depth_option);
 
+/**
+ * Same as #realize_instances, but the realized point clouds, meshes and curves are passed to `fn`
+ * in chunks instead of being joined into a single geometry, so that the full result never has to
+ * exist in memory at once. This is meant for consumers that can process the realized geometry
+ * piece by piece, like exporters.
+ *
+ * Each chunk contains the realized data of consecutive instances with at most `max_chunk_size`
+ * elements, unless a single instance is larger than that. Concatenating the chunks of each
+ * geometry type in the order they are passed gives the same elements, attributes and ids as
+ * #realize_instances. Instances that are not realized, grease pencil, volumes and bundles are
+ * passed together in a separate chunk first.
+ */
+void realize_instances_chunked(bke::GeometrySet geometry_set,
+                               const RealizeInstancesOptions &options,
+                               int64_t max_chunk_size,
+                               FunctionRef<void(RealizeInstancesResult &chunk)> fn);
+
 }  // namespace blender::geometry
@@ -1367,6 +1367,7 @@ static void add_instance_attributes_to_single_geometry(
 static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &options,
                                              const GatherOffsets &offsets,
                                              const AllPointCloudsInfo &all_pointclouds_info,
+                                             const Span<RealizePointCloudTask> all_tasks,
                                              const Span<RealizePointCloudTask> tasks,
                                              const OrderedAttributes &ordered_attributes,
                                              RealizeInstancesResult &r_result)
@@ -1375,7 +1376,7 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
     return;
   }
 
-  if (tasks.size() == 1) {
+  if (all_tasks.size() == 1) {
     const RealizePointCloudTask &task = tasks.first();
     PointCloud *new_points = BKE_pointcloud_copy_for_eval(task.pointcloud_info->pointcloud);
     if (!skip_transform(task.transform)) {
@@ -1399,7 +1400,9 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
   r_result.geometry.replace_pointcloud(dst_pointcloud);
   bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
 
-  const RealizePointCloudTask &first_task = tasks.first();
+  /* Copy settings from the first task of all tasks, also when only a chunk of them is executed,
+   * so that all chunks get the same materials. */
+  const RealizePointCloudTask &first_task = all_tasks.first();
   const PointCloud &first_pointcloud = *first_task.pointcloud_info->pointcloud;
   dst_pointcloud->mat = MEM_dupalloc(first_pointcloud.mat);
   dst_pointcloud->totcol = first_pointcloud.totcol;
@@ -1812,6 +1815,7 @@ static void copy_vertex_group_names(Mesh &dst_mesh,
         continue;
       }
       copy_vertex_group_name(&dst_mesh.vertex_group_names, ordered_attributes, src);
+      existing_names.add(src.name);
     }
   }
 }
@@ -1819,6 +1823,7 @@ static void copy_vertex_group_names(Mesh &dst_mesh,
 static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
                                        const GatherOffsets &offsets,
                                        const AllMeshesInfo &all_meshes_info,
+                                       const Span<RealizeMeshTask> all_tasks,
                                        const Span<RealizeMeshTask> tasks,
                                        const OrderedAttributes &ordered_attributes,
                                        const VectorSet<Material *> &ordered_materials,
@@ -1828,7 +1833,7 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
     return;
   }
 
-  if (tasks.size() == 1) {
+  if (all_tasks.size() == 1) {
     const RealizeMeshTask &task = tasks.first();
     Mesh *new_mesh = BKE_mesh_copy_for_eval(*task.mesh_info->mesh);
     if (!skip_transform(task.transform)) {
@@ -1861,15 +1866,16 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
   MutableSpan<int> dst_corner_verts = dst_mesh->corner_verts_for_write();
   MutableSpan<int> dst_corner_edges = dst_mesh->corner_edges_for_write();
 
-  /* Copy settings from the first input geometry set with a mesh. */
-  const RealizeMeshTask &first_task = tasks.first();
+  /* Copy settings from the first input geometry set with a mesh. This is the first task of all
+   * tasks, also when only a chunk of them is executed, so that all chunks get the same settings
+   * and vertex group order as the non-chunked realization. */
+  const RealizeMeshTask &first_task = all_tasks.first();
   const Mesh &first_mesh = *first_task.mesh_info->mesh;
   BKE_mesh_copy_parameters_for_eval(dst_mesh, &first_mesh);
 
   BLI_assert(BLI_listbase_count(&dst_mesh->vertex_group_names) ==
              BLI_listbase_count(&first_mesh.vertex_group_names));
-  copy_vertex_group_names(
-      *dst_mesh, ordered_attributes, all_meshes_info.order.as_span().drop_front(1));
+  copy_vertex_group_names(*dst_mesh, ordered_attributes, all_meshes_info.order);
   dst_mesh->vertex_group_active_index = first_mesh.vertex_group_active_index;
 
   /* Add materials. */
@@ -2257,6 +2263,7 @@ static void copy_vertex_group_names(CurvesGeometry &dst_curve,
 static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
                                         const GatherOffsets &offsets,
                                         const AllCurvesInfo &all_curves_info,
+                                        const Span<RealizeCurveTask> all_tasks,
                                         const Span<RealizeCurveTask> tasks,
                                         const OrderedAttributes &ordered_attributes,
                                         RealizeInstancesResult &r_result)
@@ -2265,7 +2272,7 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
     return;
   }
 
-  if (tasks.size() == 1) {
+  if (all_tasks.size() == 1) {
     const RealizeCurveTask &task = tasks.first();
     Curves *new_curves = BKE_curves_copy_for_eval(task.curve_info->curves);
     if (!skip_transform(task.transform)) {
@@ -2298,8 +2305,9 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
   r_result.geometry.replace_curves(dst_curves_id);
   bke::MutableAttributeAccessor dst_attributes = dst_curves.attributes_for_write();
 
-  /* Copy settings from the first input geometry set with curves. */
-  const RealizeCurveTask &first_task = tasks.first();
+  /* Copy settings from the first input geometry set with curves. Like for meshes, this is the
+   * first task of all tasks, also when only a chunk of them is executed. */
+  const RealizeCurveTask &first_task = all_tasks.first();
   const Curves &first_curves_id = *first_task.curve_info->curves;
   bke::curves_copy_parameters(first_curves_id, *dst_curves_id);
 
@@ -2702,35 +2710,51 @@ static void propagate_instances_to_keep(const bke::GeometrySet &geometry_set,
   new_instances_components.replace(new_instances.release(), bke::GeometryOwnershipType::Owned);
 }
 
-RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
-                                         const RealizeInstancesOptions &options)
-{
-  if (!geometry_set.has_instances()) {
-    return {geometry_set};
+/**
+ * Preprocessed geometries and all gathered tasks. This is the state shared by the regular and
+ * the chunked realization, only the execution of the tasks differs.
+ */
+struct RealizeInstancesGather {
+  AllPointCloudsInfo pointclouds;
+  AllMeshesInfo meshes;
+  AllCurvesInfo curves;
+  AllGreasePencilsInfo grease_pencils;
+  OrderedAttributes instance_attributes;
+  ResourceScope temporary_arrays;
+  GatherTasksInfo info;
+
+  RealizeInstancesGather(bke::GeometrySet &geometry_set,
+                         const RealizeInstancesOptions &options,
+                         const VariedDepthOptions &varied_depth_option)
+      : pointclouds(preprocess_pointclouds(geometry_set, options, varied_depth_option)),
+        meshes(preprocess_meshes(geometry_set, options, varied_depth_option)),
+        curves(preprocess_curves(geometry_set, options, varied_depth_option)),
+        grease_pencils(preprocess_grease_pencils(geometry_set, options, varied_depth_option)),
+        instance_attributes(gather_generic_instance_attributes_to_propagate(
+            geometry_set, options, varied_depth_option)),
+        info{pointclouds,
+             meshes,
+             curves,
+             grease_pencils,
+             instance_attributes,
+             pointclouds.create_id_attribute || meshes.create_id_attribute ||
+                 curves.create_id_attribute,
+             varied_depth_option.selection,
+             varied_depth_option.depths,
+             temporary_arrays}
+  {
   }
+};
 
-  VariedDepthOptions all_instances;
-  all_instances.depths = VArray<int>::from_single(VariedDepthOptions::MAX_DEPTH,
-                                                  geometry_set.get_instances()->instances_num());
-  all_instances.selection = IndexMask(geometry_set.get_instances()->instances_num());
-  return realize_instances(geometry_set, options, all_instances);
-}
-
-RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
-                                         const RealizeInstancesOptions &options,
-                                         const VariedDepthOptions &varied_depth_option)
+/**
+ * Prepare the input geometry and gather all tasks needed to realize it. This corresponds to the
+ * first two steps described in #realize_instances.
+ */
+static void gather_realize_tasks(bke::GeometrySet &geometry_set,
+                                 const RealizeInstancesOptions &options,
+                                 const VariedDepthOptions &varied_depth_option,
+                                 std::optional<RealizeInstancesGather> &r_gather)
 {
-  /* The algorithm works in three steps:
-   * 1. Preprocess each unique geometry that is instanced (e.g. each `Mesh`).
-   * 2. Gather "tasks" that need to be executed to realize the instances. Each task corresponds
-   * to instances of the previously preprocessed geometry.
-   * 3. Execute all tasks in parallel.
-   */
-
-  if (!geometry_set.has_instances()) {
-    return {geometry_set};
-  }
-
   bke::GeometrySet not_to_realize_set;
   propagate_instances_to_keep(
       geometry_set, varied_depth_option.selection, not_to_realize_set, options.attribute_filter);
@@ -2739,28 +2763,8 @@ RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
     remove_id_attribute_from_instances(geometry_set);
   }
 
-  AllPointCloudsInfo all_pointclouds_info = preprocess_pointclouds(
-      geometry_set, options, varied_depth_option);
-  AllMeshesInfo all_meshes_info = preprocess_meshes(geometry_set, options, varied_depth_option);
-  AllCurvesInfo all_curves_info = preprocess_curves(geometry_set, options, varied_depth_option);
-  AllGreasePencilsInfo all_grease_pencils_info = preprocess_grease_pencils(
-      geometry_set, options, varied_depth_option);
-  OrderedAttributes all_instance_attributes = gather_generic_instance_attributes_to_propagate(
-      geometry_set, options, varied_depth_option);
-
-  const bool create_id_attribute = all_pointclouds_info.create_id_attribute ||
-                                   all_meshes_info.create_id_attribute ||
-                                   all_curves_info.create_id_attribute;
-  ResourceScope temporary_arrays;
-  GatherTasksInfo gather_info = {all_pointclouds_info,
-                                 all_meshes_info,
-                                 all_curves_info,
-                                 all_grease_pencils_info,
-                                 all_instance_attributes,
-                                 create_id_attribute,
-                                 varied_depth_option.selection,
-                                 varied_depth_option.depths,
-                                 temporary_arrays};
+  RealizeInstancesGather &gather = r_gather.emplace(geometry_set, options, varied_depth_option);
+  GatherTasksInfo &gather_info = gather.info;
 
   if (not_to_realize_set.has_instances()) {
     gather_info.instances.instances_components_to_merge.append(
@@ -2772,18 +2776,77 @@ RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
   const float4x4 transform = float4x4::identity();
   InstanceContext attribute_fallbacks(gather_info);
 
-  initialize_curves_builtin_attribute_defaults(all_curves_info, attribute_fallbacks);
+  initialize_curves_builtin_attribute_defaults(gather.curves, attribute_fallbacks);
 
   gather_realize_tasks_recursive(
       gather_info, 0, VariedDepthOptions::MAX_DEPTH, geometry_set, transform, attribute_fallbacks);
+}
 
-  RealizeInstancesResult result;
+/**
+ * Execute the tasks that are not split into chunks by #realize_instances_chunked: the instances
+ * that are kept, grease pencil, edit data, volumes and bundles.
+ */
+static void execute_unchunked_tasks(const RealizeInstancesGather &gather,
+                                    RealizeInstancesResult &r_result)
+{
+  const GatherTasksInfo &gather_info = gather.info;
   execute_instances_tasks(gather_info.instances.instances_components_to_merge,
                           gather_info.instances.instances_components_transforms,
-                          all_instance_attributes,
+                          gather.instance_attributes,
                           gather_info.instances.attribute_fallback,
-                          result.geometry);
+                          r_result.geometry);
+  execute_realize_grease_pencil_tasks(gather.grease_pencils,
+                                      gather_info.r_offsets,
+                                      gather_info.r_tasks.grease_pencil_tasks,
+                                      gather.grease_pencils.attributes,
+                                      r_result);
+  execute_realize_edit_data_tasks(gather_info.r_tasks.edit_data_tasks, r_result.geometry);
+  if (gather_info.r_tasks.first_volume) {
+    r_result.geometry.add(*gather_info.r_tasks.first_volume);
+  }
+  for (const nodes::Bundle *bundle : gather_info.r_tasks.bundles) {
+    r_result.geometry.bundle_for_write().merge(*bundle);
+  }
+}
+
+static VariedDepthOptions all_instances_depth_options(const bke::GeometrySet &geometry_set)
+{
+  VariedDepthOptions all_instances;
+  all_instances.depths = VArray<int>::from_single(VariedDepthOptions::MAX_DEPTH,
+                                                  geometry_set.get_instances()->instances_num());
+  all_instances.selection = IndexMask(geometry_set.get_instances()->instances_num());
+  return all_instances;
+}
+
+RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
+                                         const RealizeInstancesOptions &options)
+{
+  if (!geometry_set.has_instances()) {
+    return {geometry_set};
+  }
+  return realize_instances(geometry_set, options, all_instances_depth_options(geometry_set));
+}
 
+RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
+                                         const RealizeInstancesOptions &options,
+                                         const VariedDepthOptions &varied_depth_option)
+{
+  /* The algorithm works in three steps:
+   * 1. Preprocess each unique geometry that is instanced (e.g. each `Mesh`).
+   * 2. Gather "tasks" that need to be executed to realize the instances. Each task corresponds
+   * to instances of the previously preprocessed geometry.
+   * 3. Execute all tasks in parallel.
+   */
+
+  if (!geometry_set.has_instances()) {
+    return {geometry_set};
+  }
+
+  std::optional<RealizeInstancesGather> gather;
+  gather_realize_tasks(geometry_set, options, varied_depth_option, gather);
+  const GatherTasksInfo &gather_info = gather->info;
+
+  RealizeInstancesResult result;
   const int64_t total_points_num = get_final_points_num(gather_info.r_tasks);
   /* This doesn't have to be exact at all, it's just a rough estimate to make decisions about
    * multi-threading (overhead). */
@@ -2791,38 +2854,185 @@ RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
   threading::memory_bandwidth_bound_task(approximate_used_bytes_num, [&]() {
     execute_realize_pointcloud_tasks(options,
                                      gather_info.r_offsets,
-                                     all_pointclouds_info,
+                                     gather->pointclouds,
                                      gather_info.r_tasks.pointcloud_tasks,
-                                     all_pointclouds_info.attributes,
+                                     gather_info.r_tasks.pointcloud_tasks,
+                                     gather->pointclouds.attributes,
                                      result);
     execute_realize_mesh_tasks(options,
                                gather_info.r_offsets,
-                               all_meshes_info,
+                               gather->meshes,
+                               gather_info.r_tasks.mesh_tasks,
                                gather_info.r_tasks.mesh_tasks,
-                               all_meshes_info.attributes,
-                               all_meshes_info.materials,
+                               gather->meshes.attributes,
+                               gather->meshes.materials,
                                result);
     execute_realize_curve_tasks(options,
                                 gather_info.r_offsets,
-                                all_curves_info,
+                                gather->curves,
                                 gather_info.r_tasks.curve_tasks,
-                                all_curves_info.attributes,
+                                gather_info.r_tasks.curve_tasks,
+                                gather->curves.attributes,
                                 result);
-    execute_realize_grease_pencil_tasks(all_grease_pencils_info,
-                                        gather_info.r_offsets,
-                                        gather_info.r_tasks.grease_pencil_tasks,
-                                        all_grease_pencils_info.attributes,
-                                        result);
-    execute_realize_edit_data_tasks(gather_info.r_tasks.edit_data_tasks, result.geometry);
+    execute_unchunked_tasks(*gather, result);
   });
-  if (gather_info.r_tasks.first_volume) {
-    result.geometry.add(*gather_info.r_tasks.first_volume);
+
+  return result;
+}
+
+/**
+ * Split the tasks into consecutive chunks whose accumulated size does not exceed the given
+ * maximum. A task that is larger than the maximum on its own becomes a chunk by itself.
+ */
+template<typename Task, typename SizeFn, typename ChunkFn>
+static void foreach_task_chunk(const Span<Task> tasks,
+                               const int64_t max_chunk_size,
+                               const SizeFn &size_fn,
+                               const ChunkFn &chunk_fn)
+{
+  int64_t chunk_start = 0;
+  int64_t chunk_size = 0;
+  for (const int64_t task_index : tasks.index_range()) {
+    const int64_t task_size = size_fn(tasks[task_index]);
+    if (chunk_size > 0 && chunk_size + task_size > max_chunk_size) {
+      chunk_fn(tasks.slice(chunk_start, task_index - chunk_start));
+      chunk_start = task_index;
+      chunk_size = 0;
+    }
+    chunk_size += task_size;
   }
-  for (const nodes::Bundle *bundle : gather_info.r_tasks.bundles) {
-    result.geometry.bundle_for_write().merge(*bundle);
+  if (chunk_start < tasks.size()) {
+    chunk_fn(tasks.drop_front(chunk_start));
   }
+}
 
-  return result;
+void realize_instances_chunked(bke::GeometrySet geometry_set,
+                               const RealizeInstancesOptions &options,
+                               const int64_t max_chunk_size,
+                               const FunctionRef<void(RealizeInstancesResult &chunk)> fn)
+{
+  BLI_assert(max_chunk_size > 0);
+  if (!geometry_set.has_instances()) {
+    RealizeInstancesResult result{geometry_set};
+    fn(result);
+    return;
+  }
+
+  const VariedDepthOptions varied_depth_option = all_instances_depth_options(geometry_set);
+  std::optional<RealizeInstancesGather> gather;
+  gather_realize_tasks(geometry_set, options, varied_depth_option, gather);
+  const GatherTasks &tasks = gather->info.r_tasks;
+
+  {
+    RealizeInstancesResult result;
+    execute_unchunked_tasks(*gather, result);
+    if (!result.geometry.is_empty() || !result.errors.is_empty()) {
+      fn(result);
+    }
+  }
+
+  /* The start indices of the tasks in each chunk are made relative to the chunk, and the chunk
+   * size replaces the total size. Fill IDs are values rather than indices, they are kept as is so
+   * that they stay unique across chunks. Settings and vertex groups are copied from the first task
+   * of all tasks, and copying the single source geometry directly is only allowed when the
+   * non-chunked realization would do that as well, to get the same data in both cases. */
+  foreach_task_chunk(
+      tasks.pointcloud_tasks.as_span(),
+      max_chunk_size,
+      [](const RealizePointCloudTask &task) -> int64_t {
+        return task.pointcloud_info->pointcloud->totpoint;
+      },
+      [&](const Span<RealizePointCloudTask> chunk_tasks) {
+        Vector<RealizePointCloudTask> local_tasks(chunk_tasks);
+        const int start_index = chunk_tasks.first().start_index;
+        for (RealizePointCloudTask &task : local_tasks) {
+          task.start_index -= start_index;
+        }
+        const RealizePointCloudTask &last_task = local_tasks.last();
+        GatherOffsets offsets;
+        offsets.pointcloud_offset = last_task.start_index +
+                                    last_task.pointcloud_info->pointcloud->totpoint;
+
+        RealizeInstancesResult result;
+        execute_realize_pointcloud_tasks(options,
+                                         offsets,
+                                         gather->pointclouds,
+                                         tasks.pointcloud_tasks,
+                                         local_tasks,
+                                         gather->pointclouds.attributes,
+                                         result);
+        fn(result);
+      });
+
+  foreach_task_chunk(
+      tasks.mesh_tasks.as_span(),
+      max_chunk_size,
+      [](const RealizeMeshTask &task) -> int64_t {
+        const Mesh &mesh = *task.mesh_info->mesh;
+        return int64_t(mesh.verts_num) + mesh.edges_num + mesh.faces_num + mesh.corners_num;
+      },
+      [&](const Span<RealizeMeshTask> chunk_tasks) {
+        Vector<RealizeMeshTask> local_tasks(chunk_tasks);
+        const MeshElementStartIndices start = chunk_tasks.first().start_indices;
+        for (RealizeMeshTask &task : local_tasks) {
+          task.start_indices.vert -= start.vert;
+          task.start_indices.edge -= start.edge;
+          task.start_indices.face -= start.face;
+          task.start_indices.corner -= start.corner;
+        }
+        const RealizeMeshTask &last_task = local_tasks.last();
+        const Mesh &last_mesh = *last_task.mesh_info->mesh;
+        GatherOffsets offsets;
+        offsets.mesh_offsets.vert = last_task.start_indices.vert + last_mesh.verts_num;
+        offsets.mesh_offsets.edge = last_task.start_indices.edge + last_mesh.edges_num;
+        offsets.mesh_offsets.face = last_task.start_indices.face + last_mesh.faces_num;
+        offsets.mesh_offsets.corner = last_task.start_indices.corner + last_mesh.corners_num;
+
+        RealizeInstancesResult result;
+        execute_realize_mesh_tasks(options,
+                                   offsets,
+                                   gather->meshes,
+                                   tasks.mesh_tasks,
+                                   local_tasks,
+                                   gather->meshes.attributes,
+                                   gather->meshes.materials,
+                                   result);
+        fn(result);
+      });
+
+  foreach_task_chunk(
+      tasks.curve_tasks.as_span(),
+      max_chunk_size,
+      [](const RealizeCurveTask &task) -> int64_t {
+        const bke::CurvesGeometry &curves = task.curve_info->curves->geometry.wrap();
+        return int64_t(curves.points_num()) + curves.curves_num();
+      },
+      [&](const Span<RealizeCurveTask> chunk_tasks) {
+        Vector<RealizeCurveTask> local_tasks(chunk_tasks);
+        const CurvesElementStartIndices start = chunk_tasks.first().start_indices;
+        for (RealizeCurveTask &task : local_tasks) {
+          task.start_indices.point -= start.point;
+          task.start_indices.curve -= start.curve;
+          task.start_indices.custom_knot -= start.custom_knot;
+        }
+        const RealizeCurveTask &last_task = local_tasks.last();
+        const bke::CurvesGeometry &last_curves = last_task.curve_info->curves->geometry.wrap();
+        GatherOffsets offsets;
+        offsets.curves_offsets.point = last_task.start_indices.point + last_curves.points_num();
+        offsets.curves_offsets.curve = last_task.start_indices.curve + last_curves.curves_num();
+        offsets.curves_offsets.custom_knot = last_task.start_indices.custom_knot +
+                                             last_curves.custom_knot_num;
+
+        RealizeInstancesResult result;
+        execute_realize_curve_tasks(options,
+                                    offsets,
+                                    gather->curves,
+                                    tasks.curve_tasks,
+                                    local_tasks,
+                                    gather->curves.attributes,
+                                    result);
+        fn(result);
+      });
 }
 
 /** \} */
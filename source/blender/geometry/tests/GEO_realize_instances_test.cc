@@ -2,16 +2,26 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_array_utils.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.hh"
 
 #include "BKE_curves.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_idtype.hh"
 #include "BKE_instances.hh"
 #include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+#include "BKE_pointcloud.hh"
 
 #include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
 
+#include "GEO_mesh_primitive_grid.hh"
 #include "GEO_realize_instances.hh"
 
 #include "CLG_log.h"
@@ -83,5 +93,193 @@ TEST_F(RealizeInstancesTest, InstanceAttributeToBuiltinCurvesAttribute)
       geometry::realize_instances(instances_geometry, options).geometry;
 }
 
+TEST_F(RealizeInstancesTest, ChunkedMatchesJoined)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(10);
+  MutableSpan<float3> positions = pointcloud->positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(0.0f, float(i), 0.0f);
+  }
+  bke::GeometrySet pointcloud_geometry = GeometrySet::from_pointcloud(pointcloud);
+
+  auto instances = std::make_unique<Instances>(5);
+  const int handle = instances->add_reference(bke::InstanceReference{pointcloud_geometry});
+  instances->reference_handles_for_write().fill(handle);
+  MutableSpan<float4x4> transforms = instances->transforms_for_write();
+  for (const int i : transforms.index_range()) {
+    transforms[i] = math::from_location<float4x4>(float3(float(i), 0.0f, 0.0f));
+  }
+  /* Makes sure that ids are generated for the realized points. */
+  SpanAttributeWriter<int> instance_ids =
+      instances->attributes_for_write().lookup_or_add_for_write_only_span<int>(
+          "id", AttrDomain::Instance);
+  array_utils::fill_index_range(instance_ids.span);
+  instance_ids.finish();
+  bke::GeometrySet instances_geometry = GeometrySet::from_instances(std::move(instances));
+
+  geometry::RealizeInstancesOptions options;
+  const GeometrySet joined = geometry::realize_instances(instances_geometry, options).geometry;
+  const PointCloud &joined_pointcloud = *joined.get_pointcloud();
+  const VArraySpan<int> joined_ids = *joined_pointcloud.attributes().lookup<int>("id");
+  ASSERT_FALSE(joined_ids.is_empty());
+
+  /* Two instances fit into each chunk, the last chunk only contains one. */
+  Vector<int> chunk_sizes;
+  Vector<float3> chunked_positions;
+  Vector<int> chunked_ids;
+  geometry::realize_instances_chunked(
+      instances_geometry, options, 25, [&](geometry::RealizeInstancesResult &chunk) {
+        EXPECT_TRUE(chunk.errors.is_empty());
+        const PointCloud &chunk_pointcloud = *chunk.geometry.get_pointcloud();
+        chunk_sizes.append(chunk_pointcloud.totpoint);
+        chunked_positions.extend(chunk_pointcloud.positions());
+        chunked_ids.extend(VArraySpan<int>(*chunk_pointcloud.attributes().lookup<int>("id")));
+      });
+
+  EXPECT_EQ_SPAN<int>(chunk_sizes, Span({20, 20, 10}));
+  EXPECT_EQ_SPAN<float3>(chunked_positions, joined_pointcloud.positions());
+  EXPECT_EQ_SPAN<int>(chunked_ids, joined_ids);
+}
+
+static void add_vertex_group(ListBaseT<bDeformGroup> &vertex_group_names,
+                             MutableAttributeAccessor attributes,
+                             const StringRef name,
+                             const float weight_offset)
+{
+  bDeformGroup *defgroup = MEM_new<bDeformGroup>(__func__);
+  name.copy_utf8_truncated(defgroup->name);
+  BLI_addtail(&vertex_group_names, defgroup);
+
+  SpanAttributeWriter<float> weights = attributes.lookup_for_write_span<float>(name);
+  for (const int i : weights.span.index_range()) {
+    weights.span[i] = weight_offset + float(i) / 100.0f;
+  }
+  weights.finish();
+}
+
+static Vector<std::string> vertex_group_names(const ListBaseT<bDeformGroup> &vertex_group_names)
+{
+  Vector<std::string> names;
+  for (const bDeformGroup &defgroup : vertex_group_names) {
+    names.append(defgroup.name);
+  }
+  return names;
+}
+
+/* Instance the two geometries in an order that makes the second chunk start with the second
+ * geometry, whose vertex groups are in a different order than in the first one. */
+static GeometrySet instance_alternating(const GeometrySet &a, const GeometrySet &b)
+{
+  auto instances = std::make_unique<Instances>(4);
+  const int handle_a = instances->add_reference(bke::InstanceReference{a});
+  const int handle_b = instances->add_reference(bke::InstanceReference{b});
+  instances->reference_handles_for_write().copy_from({handle_a, handle_b, handle_b, handle_a});
+  MutableSpan<float4x4> transforms = instances->transforms_for_write();
+  for (const int i : transforms.index_range()) {
+    transforms[i] = math::from_location<float4x4>(float3(0.0f, 0.0f, float(i)));
+  }
+  return GeometrySet::from_instances(std::move(instances));
+}
+
+TEST_F(RealizeInstancesTest, ChunkedMeshesMatchJoined)
+{
+  Mesh *mesh_a = geometry::create_grid_mesh(2, 2, 1.0f, 1.0f, std::nullopt);
+  add_vertex_group(mesh_a->vertex_group_names, mesh_a->attributes_for_write(), "a", 0.1f);
+  add_vertex_group(mesh_a->vertex_group_names, mesh_a->attributes_for_write(), "b", 0.2f);
+  Mesh *mesh_b = geometry::create_grid_mesh(3, 2, 2.0f, 1.0f, std::nullopt);
+  add_vertex_group(mesh_b->vertex_group_names, mesh_b->attributes_for_write(), "c", 0.3f);
+  add_vertex_group(mesh_b->vertex_group_names, mesh_b->attributes_for_write(), "a", 0.4f);
+  const GeometrySet instances_geometry = instance_alternating(GeometrySet::from_mesh(mesh_a),
+                                                              GeometrySet::from_mesh(mesh_b));
+
+  geometry::RealizeInstancesOptions options;
+  const GeometrySet joined = geometry::realize_instances(instances_geometry, options).geometry;
+  const Mesh &joined_mesh = *joined.get_mesh();
+  const Vector<std::string> joined_names = vertex_group_names(joined_mesh.vertex_group_names);
+  EXPECT_EQ(joined_names.size(), 3);
+
+  /* The first mesh has 13 elements and the second one 23, so every instance is its own chunk. */
+  int chunks_num = 0;
+  Vector<float3> chunked_positions;
+  Vector<int> chunked_corner_verts;
+  Map<std::string, Vector<float>> chunked_weights;
+  geometry::realize_instances_chunked(
+      instances_geometry, options, 25, [&](geometry::RealizeInstancesResult &chunk) {
+        EXPECT_TRUE(chunk.errors.is_empty());
+        const Mesh &chunk_mesh = *chunk.geometry.get_mesh();
+        EXPECT_EQ_SPAN<std::string>(vertex_group_names(chunk_mesh.vertex_group_names),
+                                    joined_names);
+        for (const int vert : chunk_mesh.corner_verts()) {
+          chunked_corner_verts.append(chunked_positions.size() + vert);
+        }
+        chunked_positions.extend(chunk_mesh.vert_positions());
+        for (const std::string &name : joined_names) {
+          chunked_weights.lookup_or_add_default(name).extend(
+              VArraySpan<float>(*chunk_mesh.attributes().lookup<float>(name)));
+        }
+        chunks_num++;
+      });
+
+  EXPECT_EQ(chunks_num, 4);
+  EXPECT_EQ_SPAN<float3>(chunked_positions, joined_mesh.vert_positions());
+  EXPECT_EQ_SPAN<int>(chunked_corner_verts, joined_mesh.corner_verts());
+  for (const std::string &name : joined_names) {
+    const VArraySpan<float> joined_weights = *joined_mesh.attributes().lookup<float>(name);
+    EXPECT_EQ_SPAN<float>(chunked_weights.lookup(name), joined_weights);
+  }
+}
+
+TEST_F(RealizeInstancesTest, ChunkedCurvesMatchJoined)
+{
+  Curves *curves_a = BKE_id_new_nomain<Curves>("CurvesA");
+  bke::CurvesGeometry &geometry_a = curves_a->geometry.wrap();
+  create_test_curves(geometry_a, {0, 3});
+  add_vertex_group(geometry_a.vertex_group_names, geometry_a.attributes_for_write(), "a", 0.1f);
+  add_vertex_group(geometry_a.vertex_group_names, geometry_a.attributes_for_write(), "b", 0.2f);
+  Curves *curves_b = BKE_id_new_nomain<Curves>("CurvesB");
+  bke::CurvesGeometry &geometry_b = curves_b->geometry.wrap();
+  create_test_curves(geometry_b, {0, 2, 5});
+  add_vertex_group(geometry_b.vertex_group_names, geometry_b.attributes_for_write(), "c", 0.3f);
+  add_vertex_group(geometry_b.vertex_group_names, geometry_b.attributes_for_write(), "a", 0.4f);
+  const GeometrySet instances_geometry = instance_alternating(GeometrySet::from_curves(curves_a),
+                                                              GeometrySet::from_curves(curves_b));
+
+  geometry::RealizeInstancesOptions options;
+  const GeometrySet joined = geometry::realize_instances(instances_geometry, options).geometry;
+  const bke::CurvesGeometry &joined_curves = joined.get_curves()->geometry.wrap();
+  const Vector<std::string> joined_names = vertex_group_names(joined_curves.vertex_group_names);
+  EXPECT_EQ(joined_names.size(), 3);
+
+  /* The first curves have 4 elements and the second ones 7, so every instance is its own chunk. */
+  int chunks_num = 0;
+  Vector<float3> chunked_positions;
+  Vector<int> chunked_test_indices;
+  Map<std::string, Vector<float>> chunked_weights;
+  geometry::realize_instances_chunked(
+      instances_geometry, options, 8, [&](geometry::RealizeInstancesResult &chunk) {
+        EXPECT_TRUE(chunk.errors.is_empty());
+        const bke::CurvesGeometry &chunk_curves = chunk.geometry.get_curves()->geometry.wrap();
+        EXPECT_EQ_SPAN<std::string>(vertex_group_names(chunk_curves.vertex_group_names),
+                                    joined_names);
+        chunked_positions.extend(chunk_curves.positions());
+        chunked_test_indices.extend(
+            VArraySpan<int>(*chunk_curves.attributes().lookup<int>("test_index")));
+        for (const std::string &name : joined_names) {
+          chunked_weights.lookup_or_add_default(name).extend(
+              VArraySpan<float>(*chunk_curves.attributes().lookup<float>(name)));
+        }
+        chunks_num++;
+      });
+
+  EXPECT_EQ(chunks_num, 4);
+  EXPECT_EQ_SPAN<float3>(chunked_positions, joined_curves.positions());
+  EXPECT_EQ_SPAN<int>(chunked_test_indices,
+                      VArraySpan<int>(*joined_curves.attributes().lookup<int>("test_index")));
+  for (const std::string &name : joined_names) {
+    const VArraySpan<float> joined_weights = *joined_curves.attributes().lookup<float>(name);
+    EXPECT_EQ_SPAN<float>(chunked_weights.lookup(name), joined_weights);
+  }
+}
+
 }  // namespace geometry::tests
 }  // namespace blender
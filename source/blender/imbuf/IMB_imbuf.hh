@@ -57,6 +57,20 @@ ImBuf *IMB_load_image_from_filepath(const char *filepath,
                                     const int flags,
                                     char r_colorspace[IM_MAX_SPACE] = nullptr);
 
+/**
+ * Start loading the image in the background, so that a later #IMB_load_image_from_filepath with
+ * the same flags and color space gets the decoded image without waiting for the file to be read
+ * and decoded. Used to prefetch the upcoming frames of image sequences during playback.
+ *
+ * Requests are handled by a small pool of worker threads, and only the most recent ones are kept
+ * when they come faster than they can be loaded. Loaded images are kept in a movie cache until
+ * they are used or freed by the cache limiter. Only images with a known color space are
+ * prefetched. Multi-layer images are loaded by the caller itself, since they own an EXR handle.
+ */
+void IMB_prefetch_image_from_filepath(const char *filepath,
+                                      const int flags,
+                                      const char *colorspace);
+
 /**
  * Save image.
  */
@@ -124,6 +124,12 @@ enum eImBufFlags {
 
   /** Perform no color space conversions when reading, leave the image in the file colorspace. */
   IB_no_colorspace_convert = 1 << 18,
+
+  /**
+   * Together with #IB_multilayer, only read the first combined or color pass of multi-layer files,
+   * for users that only display that pass. The buffers of other passes are not allocated and their
+   * channels are not decoded. */
+  IB_multilayer_combined_only = 1 << 19,
 };
 
 /** \} */
@@ -70,6 +70,32 @@ bool IMB_exr_set_channel(
 void IMB_exr_read_channels(ExrHandle *handle);
 void IMB_exr_write_channels(ExrHandle *handle);
 
+/**
+ * Get the number of resolution levels of a file opened for reading in each direction. Files that
+ * are not tiled with mip-maps or rip-maps only have the full resolution level.
+ */
+void IMB_exr_get_num_levels(ExrHandle *handle, int *r_num_x_levels, int *r_num_y_levels);
+/**
+ * Get the size of the given resolution level, returns false if the level does not exist.
+ */
+bool IMB_exr_get_level_size(
+    ExrHandle *handle, int level_x, int level_y, int *r_width, int *r_height);
+
+/**
+ * Like #IMB_exr_read_channels, but only decode the pixels of the given region of the given
+ * resolution level. The region spans from \a region_min inclusive to \a region_max exclusive, in
+ * pixels relative to the lower left corner of the level. The buffers set using
+ * #IMB_exr_set_channel are expected to be the size of the region, and only channels that have a
+ * buffer set are decoded. OpenEXR decodes the chunks of the region in parallel on its global thread
+ * pool. Returns false if the level does not exist, if the region is outside of it, or if reading
+ * failed.
+ */
+bool IMB_exr_read_channels_region(ExrHandle *handle,
+                                  const int region_min[2],
+                                  const int region_max[2],
+                                  int level_x = 0,
+                                  int level_y = 0);
+
 void IMB_exr_multilayer_convert(ExrHandle *handle,
                                 void *base,
                                 void *(*addview)(void *base, const char *str),
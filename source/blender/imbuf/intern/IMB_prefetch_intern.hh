@@ -0,0 +1,31 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ */
+
+#pragma once
+
+#include "IMB_imbuf_enums.h"
+
+namespace blender {
+
+struct ImBuf;
+
+void imb_prefetch_exit();
+
+/**
+ * Take the image prefetched by #IMB_prefetch_image_from_filepath with the same arguments, waiting
+ * for it if it is still being loaded. The caller gets ownership of the returned image, which is
+ * removed from the prefetch cache. Returns null if the image was not prefetched.
+ */
+ImBuf *imb_prefetch_take(const char *filepath, int flags, const char *colorspace);
+
+/** Load the image from disk on the calling thread, bypassing the prefetch cache. */
+ImBuf *imb_load_image_from_filepath_direct(const char *filepath,
+                                           int flags,
+                                           char r_colorspace[IM_MAX_SPACE]);
+
+}  // namespace blender
@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <optional>
 #include <string>
 
 #include "DNA_ID.h"
@@ -21,6 +22,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "IMB_filetype.hh"
 #include "IMB_filter.hh"
@@ -118,10 +120,37 @@ float3x3 global_scene_linear_to_xyz_default = float3x3::zero();
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Settings that identify a display transform which can be baked into a lookup table. */
+struct DisplayLUTKey {
+  /* Scene linear color space the transform converts from, which blend files can change. */
+  std::string working_space;
+  std::string display;
+  std::string view;
+  std::string look;
+  float exposure;
+  float gamma;
+  float temperature;
+  float tint;
+  bool use_white_balance;
+  bool use_display_emulation;
+  ColorManagedDisplaySpace display_space;
+  /* The original curve mapping of the view settings and its time stamp. */
+  const CurveMapping *curve_mapping;
+  int curve_mapping_timestamp;
+
+  bool operator==(const DisplayLUTKey &) const = default;
+};
+
 struct ColormanageProcessor {
   std::shared_ptr<const ocio::CPUProcessor> cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+
+  /* Set for display processors when the baked display transform is enabled in the preferences. */
+  std::optional<DisplayLUTKey> display_lut_key;
+  /* Lookup table that approximates the curve mapping and the CPU processor, see
+   * #display_lut_ensure. */
+  std::shared_ptr<const ocio::BakedLUT> display_lut;
 };
 
 static struct GlobalGPUState {
@@ -152,6 +181,15 @@ static struct GlobalColorPickingState {
   bool failed = false;
 } global_color_picking_state;
 
+static struct GlobalDisplayLUTState {
+  GlobalDisplayLUTState() = default;
+
+  /* Lookup table of the display transform it was last baked for. Updates of display buffers
+   * typically use the same display transform over and over, so only one table is cached. */
+  std::optional<DisplayLUTKey> key;
+  std::shared_ptr<const ocio::BakedLUT> lut;
+} global_display_lut_state;
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -690,6 +728,7 @@ void colormanagement_exit()
 {
   global_gpu_state = GlobalGPUState();
   global_color_picking_state = GlobalColorPickingState();
+  global_display_lut_state = GlobalDisplayLUTState();
 
   colormanage_free_config();
 }
@@ -1875,6 +1914,107 @@ static void do_display_buffer_apply_no_processor(DisplayBufferThread *handle)
   }
 }
 
+/* Transform the given colors by the curve mapping and the CPU processor of the given processor,
+ * which is what the baked lookup table of display processors approximates. */
+static void display_lut_transform(const ColormanageProcessor *cm_processor,
+                                  MutableSpan<float3> colors)
+{
+  if (cm_processor->curve_mapping) {
+    for (float3 &color : colors) {
+      BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, color, color);
+    }
+  }
+
+  const ocio::PackedImage img(colors.data(),
+                              colors.size(),
+                              1,
+                              3,
+                              ocio::BitDepth::BIT_DEPTH_F32,
+                              sizeof(float),
+                              sizeof(float3),
+                              sizeof(float3) * colors.size());
+  cm_processor->cpu_processor->apply(img);
+}
+
+/**
+ * Assign the baked lookup table of the display transform of the given processor, if one is cached
+ * or if baking it is worth it for an image of the given number of pixels, that is, when it has
+ * more pixels than the table has samples.
+ */
+static void display_lut_ensure(ColormanageProcessor *cm_processor, const int64_t pixels_num)
+{
+  constexpr int64_t lut_samples_num = int64_t(ocio::BakedLUT::size) * ocio::BakedLUT::size *
+                                      ocio::BakedLUT::size;
+
+  BLI_mutex_lock(&processor_lock);
+
+  if (global_display_lut_state.key != cm_processor->display_lut_key &&
+      pixels_num >= lut_samples_num)
+  {
+    /* Isolate the baking, since the lock is held while waiting for its tasks. */
+    threading::isolate_task([&]() {
+      global_display_lut_state.lut = std::make_shared<const ocio::BakedLUT>(
+          [&](MutableSpan<float3> colors) { display_lut_transform(cm_processor, colors); });
+    });
+    global_display_lut_state.key = cm_processor->display_lut_key;
+  }
+
+  if (global_display_lut_state.key == cm_processor->display_lut_key) {
+    cm_processor->display_lut = global_display_lut_state.lut;
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+}
+
+/**
+ * Apply the display processor using its baked lookup table, falling back to the exact transform
+ * for pixels that the table does not handle.
+ */
+static void display_lut_apply(ColormanageProcessor *cm_processor,
+                              float *buffer,
+                              const int width,
+                              const int height,
+                              const int channels,
+                              const bool predivide)
+{
+  if (channels < 3) {
+    IMB_colormanagement_processor_apply(cm_processor, buffer, width, height, channels, predivide);
+    return;
+  }
+
+  const ocio::BakedLUT &lut = *cm_processor->display_lut;
+  const int64_t pixels_num = int64_t(width) * height;
+  for (int64_t i = 0; i < pixels_num; i++) {
+    float *pixel = buffer + i * channels;
+
+    if (channels == 4 && predivide && !ELEM(pixel[3], 0.0f, 1.0f)) {
+      /* The curve mapping is applied before alpha is divided, so the table only matches the exact
+       * transform of partially transparent pixels if there is no curve mapping. */
+      if (!cm_processor->curve_mapping) {
+        const float alpha = pixel[3];
+        float rgb[3] = {pixel[0] / alpha, pixel[1] / alpha, pixel[2] / alpha};
+        if (lut.apply_rgb(rgb)) {
+          mul_v3_v3fl(pixel, rgb, alpha);
+          continue;
+        }
+      }
+      IMB_colormanagement_processor_apply_v4_predivide(cm_processor, pixel);
+      continue;
+    }
+
+    if (lut.apply_rgb(pixel)) {
+      continue;
+    }
+
+    if (channels == 3) {
+      IMB_colormanagement_processor_apply_v3(cm_processor, pixel);
+    }
+    else {
+      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
+    }
+  }
+}
+
 static void do_display_buffer_apply_thread(DisplayBufferThread *handle)
 {
   ColormanageProcessor *cm_processor = handle->cm_processor;
@@ -1898,8 +2038,13 @@ static void do_display_buffer_apply_thread(DisplayBufferThread *handle)
 
   /* Apply processor (note: data buffers never get color space conversions). */
   if (!handle->is_data) {
-    IMB_colormanagement_processor_apply(
-        cm_processor, linear_buffer, width, height, channels, predivide);
+    if (cm_processor->display_lut) {
+      display_lut_apply(cm_processor, linear_buffer, width, height, channels, predivide);
+    }
+    else {
+      IMB_colormanagement_processor_apply(
+          cm_processor, linear_buffer, width, height, channels, predivide);
+    }
   }
 
   /* copy result to output buffers */
@@ -1970,6 +2115,12 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.float_colorspace = nullptr;
   }
 
+  if (cm_processor && cm_processor->display_lut_key &&
+      (ibuf->colormanage_flag & IMB_COLORMANAGE_IS_DATA) == 0)
+  {
+    display_lut_ensure(cm_processor, int64_t(ibuf->x) * ibuf->y);
+  }
+
   threading::parallel_for(IndexRange(ibuf->y), 64, [&](const IndexRange y_range) {
     DisplayBufferThread handle;
     display_buffer_init_handle(&handle, y_range.first(), y_range.size(), &init_data);
@@ -4248,6 +4399,29 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     BKE_curvemapping_premultiply(cm_processor->curve_mapping, false);
   }
 
+  if (USER_EXPERIMENTAL_TEST(&U, use_display_transform_lut) && !inverse &&
+      cm_processor->cpu_processor)
+  {
+    DisplayLUTKey key;
+    key.working_space = global_role_scene_linear;
+    key.display = display_settings->display_device;
+    key.view = applied_view_settings->view_transform;
+    key.look = applied_view_settings->look;
+    key.exposure = applied_view_settings->exposure;
+    key.gamma = applied_view_settings->gamma;
+    key.temperature = applied_view_settings->temperature;
+    key.tint = applied_view_settings->tint;
+    key.use_white_balance = use_white_balance;
+    key.use_display_emulation = get_display_emulation(*display_settings);
+    key.display_space = display_space;
+    key.curve_mapping = cm_processor->curve_mapping ? applied_view_settings->curve_mapping :
+                                                      nullptr;
+    key.curve_mapping_timestamp = cm_processor->curve_mapping ?
+                                      applied_view_settings->curve_mapping->changed_timestamp :
+                                      0;
+    cm_processor->display_lut_key = std::move(key);
+  }
+
   return cm_processor;
 }
 
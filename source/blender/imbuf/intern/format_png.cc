@@ -6,8 +6,22 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <zlib.h>
+
 #include "oiio/openimageio_support.hh"
 
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
 #include "IMB_colormanagement.hh"
 #include "IMB_filetype.hh"
 #include "IMB_imbuf_types.hh"
@@ -17,6 +31,348 @@ namespace blender {
 OIIO_NAMESPACE_USING
 using namespace blender::imbuf;
 
+/** Images with less uncompressed data than this are compressed fast enough on a single thread. */
+static constexpr int64_t parallel_deflate_min_size = 1024 * 1024;
+/** Uncompressed size of the groups of rows compressed by each task. */
+static constexpr int64_t parallel_deflate_chunk_size = 256 * 1024;
+/** Size of the deflate window, and of the dictionary taken from the previous group of rows. */
+static constexpr int64_t deflate_window_size = 32 * 1024;
+
+static constexpr uchar png_signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+
+struct PNGChunk {
+  char type[5];
+  Span<uchar> data;
+  /** The whole chunk including its length, type and checksum. */
+  Span<uchar> bytes;
+};
+
+static uint32_t png_read_uint32(const uchar *data)
+{
+  return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) |
+         uint32_t(data[3]);
+}
+
+static void png_encode_uint32(const uint32_t value, uchar r_data[4])
+{
+  r_data[0] = uchar(value >> 24);
+  r_data[1] = uchar(value >> 16);
+  r_data[2] = uchar(value >> 8);
+  r_data[3] = uchar(value);
+}
+
+static bool png_parse_chunks(const Span<uchar> file, Vector<PNGChunk> &r_chunks)
+{
+  if (file.size() < int64_t(sizeof(png_signature)) ||
+      memcmp(file.data(), png_signature, sizeof(png_signature)) != 0)
+  {
+    return false;
+  }
+
+  int64_t offset = sizeof(png_signature);
+  while (offset + 12 <= file.size()) {
+    const int64_t length = png_read_uint32(&file[offset]);
+    if (offset + 12 + length > file.size()) {
+      return false;
+    }
+    PNGChunk chunk;
+    memcpy(chunk.type, &file[offset + 4], 4);
+    chunk.type[4] = '\0';
+    chunk.data = file.slice(offset + 8, length);
+    chunk.bytes = file.slice(offset, length + 12);
+    r_chunks.append(chunk);
+    offset += length + 12;
+  }
+  return offset == file.size();
+}
+
+static bool png_write_chunk(FILE *file, const char *type, const Span<uchar> data)
+{
+  uchar header[8];
+  png_encode_uint32(uint32_t(data.size()), header);
+  memcpy(header + 4, type, 4);
+
+  uchar checksum[4];
+  uLong crc = crc32(0, header + 4, 4);
+  crc = crc32(crc, data.data(), uInt(data.size()));
+  png_encode_uint32(uint32_t(crc), checksum);
+
+  return fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+         fwrite(data.data(), 1, data.size(), file) == size_t(data.size()) &&
+         fwrite(checksum, 1, sizeof(checksum), file) == sizeof(checksum);
+}
+
+/**
+ * Data that is stored in multiple spans, like the image data of a PNG file, which is split in
+ * several chunks of the file.
+ */
+class SegmentedData {
+ private:
+  Vector<Span<uchar>> segments_;
+  /** Offset of each segment in the data, followed by the size of the data. */
+  Vector<int64_t> offsets_ = {0};
+
+ public:
+  void append(const Span<uchar> segment)
+  {
+    if (!segment.is_empty()) {
+      segments_.append(segment);
+      offsets_.append(offsets_.last() + segment.size());
+    }
+  }
+
+  int64_t size() const
+  {
+    return offsets_.last();
+  }
+
+  /** Call the function for each span of the data in the given range, in order. */
+  template<typename Fn> void foreach_span(const IndexRange range, const Fn &fn) const
+  {
+    int64_t segment = std::upper_bound(offsets_.begin(), offsets_.end(), range.start()) -
+                      offsets_.begin() - 1;
+    int64_t start = range.start();
+    while (start < range.one_after_last()) {
+      const int64_t segment_start = start - offsets_[segment];
+      const int64_t size = std::min(segments_[segment].size() - segment_start,
+                                    range.one_after_last() - start);
+      fn(segments_[segment].slice(segment_start, size));
+      start += size;
+      segment++;
+    }
+  }
+};
+
+/**
+ * Reads the zlib stream of the image data chunks of a PNG file that was written without
+ * compression, in which case the stream only consists of stored blocks. Their contents are
+ * returned as spans of the file, such that the image data is never copied.
+ */
+static bool png_stored_image_data(const Span<PNGChunk> chunks, SegmentedData &r_data)
+{
+  SegmentedData stream;
+  for (const PNGChunk &chunk : chunks) {
+    if (STREQ(chunk.type, "IDAT")) {
+      stream.append(chunk.data);
+    }
+  }
+
+  int64_t offset = 0;
+  const auto read_bytes = [&](const int64_t size, uchar *r_bytes) {
+    if (offset + size > stream.size()) {
+      return false;
+    }
+    stream.foreach_span(IndexRange(offset, size), [&](const Span<uchar> span) {
+      memcpy(r_bytes, span.data(), span.size());
+      r_bytes += span.size();
+    });
+    offset += size;
+    return true;
+  };
+
+  /* The zlib header, with the deflate method and without a preset dictionary. */
+  uchar header[2];
+  if (!read_bytes(2, header) || (header[0] & 0x0F) != Z_DEFLATED || (header[1] & 0x20)) {
+    return false;
+  }
+
+  bool is_final_block = false;
+  while (!is_final_block) {
+    /* Stored blocks start on a byte boundary, so the bits after the block type in the first byte
+     * are padding, followed by the length of the block and its complement. */
+    uchar block_header[5];
+    if (!read_bytes(5, block_header)) {
+      return false;
+    }
+    is_final_block = block_header[0] & 1;
+    const int block_type = (block_header[0] >> 1) & 3;
+    const int length = block_header[1] | (block_header[2] << 8);
+    const int length_complement = block_header[3] | (block_header[4] << 8);
+    if (block_type != 0 || length != (~length_complement & 0xFFFF) ||
+        offset + length > stream.size())
+    {
+      return false;
+    }
+    stream.foreach_span(IndexRange(offset, length), [&](const Span<uchar> span) {
+      r_data.append(span);
+    });
+    offset += length;
+  }
+  return true;
+}
+
+/**
+ * Compress a part of a zlib stream as raw deflate data, which can be concatenated with the data of
+ * the following parts. Using the end of the previous part as dictionary keeps the compression
+ * ratio close to compressing everything at once. Also computes the Adler-32 checksum of the part.
+ */
+static bool deflate_part(const SegmentedData &data,
+                         const IndexRange range,
+                         const int level,
+                         const bool is_last,
+                         Vector<uchar> &r_output,
+                         uLong &r_checksum)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  const int64_t dictionary_size = std::min(range.start(), deflate_window_size);
+  if (dictionary_size > 0) {
+    /* The dictionary is small, and may be split in multiple segments. */
+    Array<uchar> dictionary(dictionary_size, NoInitialization());
+    uchar *dictionary_end = dictionary.data();
+    data.foreach_span(IndexRange(range.start() - dictionary_size, dictionary_size),
+                      [&](const Span<uchar> span) {
+                        memcpy(dictionary_end, span.data(), span.size());
+                        dictionary_end += span.size();
+                      });
+    deflateSetDictionary(&stream, dictionary.data(), uInt(dictionary_size));
+  }
+
+  /* Leave room for the empty block that a sync flush ends with. */
+  r_output.resize(int64_t(deflateBound(&stream, uLong(range.size()))) + 16);
+  stream.next_out = r_output.data();
+  stream.avail_out = uInt(r_output.size());
+
+  bool ok = true;
+  r_checksum = adler32(0, nullptr, 0);
+  data.foreach_span(range, [&](const Span<uchar> span) {
+    r_checksum = adler32(r_checksum, span.data(), uInt(span.size()));
+    stream.next_in = const_cast<uchar *>(span.data());
+    stream.avail_in = uInt(span.size());
+    ok &= deflate(&stream, Z_NO_FLUSH) == Z_OK && stream.avail_in == 0;
+  });
+
+  /* A sync flush ends the output on a byte boundary without marking it as the final block. */
+  if (ok) {
+    const int result = deflate(&stream, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+    ok = is_last ? (result == Z_STREAM_END) : (result == Z_OK && stream.avail_out > 0);
+  }
+  r_output.resize(int64_t(stream.total_out));
+  deflateEnd(&stream);
+  return ok;
+}
+
+/**
+ * Write a PNG file from `uncompressed_file`, a PNG file with uncompressed image data, compressing
+ * the image data on multiple threads. Groups of rows are compressed independently and joined into
+ * a single zlib stream, so the result is an ordinary PNG file. The image data is read from the
+ * uncompressed file directly, so apart from it, only the compressed data is kept in memory.
+ */
+static bool png_write_compressed_parallel(const char *filepath,
+                                          const Span<uchar> uncompressed_file,
+                                          const int level)
+{
+  Vector<PNGChunk> chunks;
+  if (!png_parse_chunks(uncompressed_file, chunks) || chunks.is_empty() ||
+      !STREQ(chunks[0].type, "IHDR") || chunks[0].data.size() != 13)
+  {
+    return false;
+  }
+
+  const Span<uchar> ihdr = chunks[0].data;
+  const int64_t width = png_read_uint32(&ihdr[0]);
+  const int64_t height = png_read_uint32(&ihdr[4]);
+  const int bit_depth = ihdr[8];
+  const int color_type = ihdr[9];
+  const int interlace_method = ihdr[12];
+  int channels;
+  switch (color_type) {
+    case 0:
+    case 3:
+      channels = 1;
+      break;
+    case 2:
+      channels = 3;
+      break;
+    case 4:
+      channels = 2;
+      break;
+    case 6:
+      channels = 4;
+      break;
+    default:
+      return false;
+  }
+  if (interlace_method != 0) {
+    return false;
+  }
+
+  /* Every row starts with a byte for its filter type. */
+  const int64_t row_size = 1 + (width * channels * bit_depth + 7) / 8;
+  const int64_t image_size = row_size * height;
+  if (image_size == 0 || image_size > int64_t(UINT32_MAX)) {
+    return false;
+  }
+
+  SegmentedData image;
+  if (!png_stored_image_data(chunks, image) || image.size() != image_size) {
+    return false;
+  }
+
+  const int64_t rows_per_part = std::max<int64_t>(parallel_deflate_chunk_size / row_size, 1);
+  const int64_t parts_num = (height + rows_per_part - 1) / rows_per_part;
+  Array<Vector<uchar>> parts(parts_num);
+  Array<uLong> checksums(parts_num);
+  Array<int64_t> part_sizes(parts_num);
+  std::atomic<bool> deflate_ok = true;
+
+  threading::parallel_for(IndexRange(parts_num), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int64_t start = i * rows_per_part * row_size;
+      const int64_t size = std::min(rows_per_part * row_size, image_size - start);
+      if (!deflate_part(
+              image, IndexRange(start, size), level, i == parts_num - 1, parts[i], checksums[i]))
+      {
+        deflate_ok = false;
+      }
+      part_sizes[i] = size;
+    }
+  });
+  if (!deflate_ok) {
+    return false;
+  }
+
+  /* Wrap the deflate data in a zlib header and checksum. */
+  uLong checksum = checksums[0];
+  for (const int64_t i : parts.index_range().drop_front(1)) {
+    checksum = adler32_combine(checksum, checksums[i], z_off_t(part_sizes[i]));
+  }
+  const int level_flags = level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+  int zlib_header = (0x78 << 8) | (level_flags << 6);
+  zlib_header += 31 - zlib_header % 31;
+  parts.first().prepend({uchar(zlib_header >> 8), uchar(zlib_header)});
+  uchar checksum_data[4];
+  png_encode_uint32(uint32_t(checksum), checksum_data);
+  parts.last().extend(Span<uchar>(checksum_data, 4));
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  /* Copy all other chunks as they are, and replace the image data chunks with the new ones. */
+  bool write_ok = fwrite(png_signature, 1, sizeof(png_signature), file) == sizeof(png_signature);
+  bool image_data_written = false;
+  for (const PNGChunk &chunk : chunks) {
+    if (!STREQ(chunk.type, "IDAT")) {
+      write_ok &= fwrite(chunk.bytes.data(), 1, chunk.bytes.size(), file) ==
+                  size_t(chunk.bytes.size());
+    }
+    else if (!image_data_written) {
+      for (const Vector<uchar> &part : parts) {
+        write_ok &= png_write_chunk(file, "IDAT", part);
+      }
+      image_data_written = true;
+    }
+  }
+
+  write_ok &= fclose(file) == 0;
+  return write_ok;
+}
+
 bool imb_is_a_png(const uchar *mem, size_t size)
 {
   return imb_oiio_check(mem, size, "png");
@@ -63,6 +419,23 @@ bool imb_save_png(ImBuf *ibuf, const char *filepath, int flags)
 
   int compression = int(float(ibuf->foptions.compress) / 11.1111f);
   compression = compression < 0 ? 0 : (compression > 9 ? 9 : compression);
+
+  /* For large images, let OpenImageIO write the file without compressing the image data, and
+   * compress it on multiple threads afterwards. */
+  const int64_t image_size = int64_t(ibuf->x) * ibuf->y * file_channels * (is_16bit ? 2 : 1);
+  if (compression > 0 && !(flags & IB_mem) && image_size >= parallel_deflate_min_size &&
+      BLI_system_thread_count() > 1)
+  {
+    std::vector<uchar> uncompressed_file;
+    Filesystem::IOVecOutput writer(uncompressed_file);
+    file_spec.attribute("png:compressionLevel", 0);
+    if (imb_oiio_write(ctx, filepath, file_spec, &writer) &&
+        png_write_compressed_parallel(filepath, uncompressed_file, compression))
+    {
+      return true;
+    }
+  }
+
   file_spec.attribute("png:compressionLevel", compression);
 
   return imb_oiio_write(ctx, filepath, file_spec);
@@ -17,6 +17,7 @@
 #include "IMB_colormanagement_intern.hh"
 #include "IMB_filetype.hh"
 #include "IMB_imbuf.hh"
+#include "IMB_prefetch_intern.hh"
 
 namespace blender {
 
@@ -31,6 +32,7 @@ void IMB_init()
 
 void IMB_exit()
 {
+  imb_prefetch_exit();
   imb_filetypes_exit();
   colormanagement_exit();
 
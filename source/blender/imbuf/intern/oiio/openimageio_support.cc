@@ -297,7 +297,10 @@ ImBuf *imb_oiio_read(const ReadContext &ctx,
   return get_oiio_ibuf(in.get(), ctx, r_colorspace);
 }
 
-bool imb_oiio_write(const WriteContext &ctx, const char *filepath, const ImageSpec &file_spec)
+bool imb_oiio_write(const WriteContext &ctx,
+                    const char *filepath,
+                    const ImageSpec &file_spec,
+                    Filesystem::IOProxy *io_proxy)
 {
   unique_ptr<ImageOutput> out = ImageOutput::create(ctx.file_format);
   if (!out) {
@@ -360,22 +363,18 @@ bool imb_oiio_write(const WriteContext &ctx, const char *filepath, const ImageSp
 
   bool write_ok = false;
   bool close_ok = false;
+  /* This memory proxy must remain alive until the ImageOutput is finally closed. */
+  ImBufMemWriter mem_writer(ctx.ibuf);
   if (ctx.flags & IB_mem) {
-    /* This memory proxy must remain alive until the ImageOutput is finally closed. */
-    ImBufMemWriter writer(ctx.ibuf);
-
     imb_addencodedbufferImBuf(ctx.ibuf);
-    out->set_ioproxy(&writer);
-    if (out->open("", file_spec)) {
-      write_ok = final_buf.write(out.get());
-      close_ok = out->close();
-    }
+    io_proxy = &mem_writer;
   }
-  else {
-    if (out->open(filepath, file_spec)) {
-      write_ok = final_buf.write(out.get());
-      close_ok = out->close();
-    }
+  if (io_proxy) {
+    out->set_ioproxy(io_proxy);
+  }
+  if (out->open(io_proxy ? "" : filepath, file_spec)) {
+    write_ok = final_buf.write(out.get());
+    close_ok = out->close();
   }
 
   const bool all_ok = write_ok && close_ok;
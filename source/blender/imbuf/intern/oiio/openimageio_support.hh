@@ -76,10 +76,13 @@ ImBuf *imb_oiio_read(const ReadContext &ctx,
  * destination.
  *
  * The `file_spec` parameter will typically come from #imb_create_write_spec.
+ *
+ * When `io_proxy` is given, the file is written to it instead of `filepath`.
  */
 bool imb_oiio_write(const WriteContext &ctx,
                     const char *filepath,
-                    const OIIO::ImageSpec &file_spec);
+                    const OIIO::ImageSpec &file_spec,
+                    OIIO::Filesystem::IOProxy *io_proxy = nullptr);
 
 /**
  * Create a #WriteContext based on the provided #ImBuf and format information.
@@ -64,6 +64,7 @@
 #include <OpenEXR/ImfOutputPart.h>
 #include <OpenEXR/ImfPartHelper.h>
 #include <OpenEXR/ImfPartType.h>
+#include <OpenEXR/ImfTiledInputPart.h>
 #include <OpenEXR/ImfTiledOutputPart.h>
 
 #include "DNA_scene_types.h" /* For OpenEXR compression constants */
@@ -79,6 +80,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_math_base.hh"
@@ -87,6 +89,7 @@
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "BKE_blender_version.h"
@@ -1267,16 +1270,21 @@ void IMB_exr_write_channels(ExrHandle *handle)
   }
 }
 
-void IMB_exr_read_channels(ExrHandle *handle)
+/** Check if EXR was saved with previous versions of blender which flipped images. */
+static bool imb_exr_is_flipped(ExrHandle *handle)
 {
-  int numparts = handle->ifile->parts();
-
-  /* Check if EXR was saved with previous versions of blender which flipped images. */
   const StringAttribute *ta = handle->ifile->header(0).findTypedAttribute<StringAttribute>(
       "BlenderMultiChannel");
 
   /* 'previous multilayer attribute, flipped. */
-  short flip = (ta && STRPREFIX(ta->value().c_str(), "Blender V2.43"));
+  return ta && STRPREFIX(ta->value().c_str(), "Blender V2.43");
+}
+
+void IMB_exr_read_channels(ExrHandle *handle)
+{
+  int numparts = handle->ifile->parts();
+
+  const bool flip = imb_exr_is_flipped(handle);
 
   CLOG_DEBUG(&LOG,
              "\nIMB_exr_read_channels\n%s %-6s %-22s "
@@ -1328,6 +1336,11 @@ void IMB_exr_read_channels(ExrHandle *handle)
       }
     }
 
+    /* Don't decode parts that have none of the requested channels. */
+    if (frameBuffer.begin() == frameBuffer.end()) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1345,6 +1358,218 @@ void IMB_exr_read_channels(ExrHandle *handle)
   }
 }
 
+/**
+ * Get the data window of the given resolution level of a part. Only tiled parts can have levels
+ * other than the full resolution level, returns false if the part has no such level.
+ */
+static bool imb_exr_part_level_data_window(
+    MultiPartInputFile &file, const int part, const int level_x, const int level_y, Box2i &r_dw)
+{
+  const Header &header = file.header(part);
+  if (!header.hasTileDescription()) {
+    if (level_x != 0 || level_y != 0) {
+      return false;
+    }
+    r_dw = header.dataWindow();
+    return true;
+  }
+
+  TiledInputPart in(file, part);
+  if (!in.isValidLevel(level_x, level_y)) {
+    return false;
+  }
+  r_dw = in.dataWindowForLevel(level_x, level_y);
+  return true;
+}
+
+void IMB_exr_get_num_levels(ExrHandle *handle, int *r_num_x_levels, int *r_num_y_levels)
+{
+  *r_num_x_levels = 1;
+  *r_num_y_levels = 1;
+
+  if (!handle->ifile->header(0).hasTileDescription()) {
+    return;
+  }
+
+  try {
+    TiledInputPart in(*handle->ifile, 0);
+    *r_num_x_levels = in.numXLevels();
+    *r_num_y_levels = in.numYLevels();
+  }
+  catch (const std::exception &exc) {
+    CLOG_ERROR(&LOG, "%s: %s", __func__, exc.what());
+  }
+}
+
+bool IMB_exr_get_level_size(
+    ExrHandle *handle, const int level_x, const int level_y, int *r_width, int *r_height)
+{
+  try {
+    Box2i dw;
+    if (!imb_exr_part_level_data_window(*handle->ifile, 0, level_x, level_y, dw)) {
+      return false;
+    }
+    *r_width = dw.max.x - dw.min.x + 1;
+    *r_height = dw.max.y - dw.min.y + 1;
+    return true;
+  }
+  catch (const std::exception &exc) {
+    CLOG_ERROR(&LOG, "%s: %s", __func__, exc.what());
+    return false;
+  }
+}
+
+/**
+ * Read the given channels of the given region of a part into their buffers. The region is in file
+ * coordinates, and the rows of the buffers are ordered from the bottom of the region unless the
+ * file is flipped.
+ *
+ * OpenEXR always decodes entire chunks and writes all pixels of the scan-lines or tiles it reads
+ * into the frame buffer, so the channels are decoded into a temporary buffer that covers those
+ * and the region is then copied into the buffers of the channels.
+ */
+static void imb_exr_read_part_region(MultiPartInputFile &file,
+                                     const int part,
+                                     const Span<const ExrChannel *> channels,
+                                     const Box2i &level_dw,
+                                     const Box2i &region,
+                                     const int level_x,
+                                     const int level_y,
+                                     const bool flip)
+{
+  const bool is_tiled = file.header(part).hasTileDescription();
+
+  Box2i decoded = region;
+  int first_tile[2] = {0, 0};
+  int last_tile[2] = {0, 0};
+  if (is_tiled) {
+    TiledInputPart in(file, part);
+    first_tile[0] = (region.min.x - level_dw.min.x) / int(in.tileXSize());
+    first_tile[1] = (region.min.y - level_dw.min.y) / int(in.tileYSize());
+    last_tile[0] = (region.max.x - level_dw.min.x) / int(in.tileXSize());
+    last_tile[1] = (region.max.y - level_dw.min.y) / int(in.tileYSize());
+    decoded.min = in.dataWindowForTile(first_tile[0], first_tile[1], level_x, level_y).min;
+    decoded.max = in.dataWindowForTile(last_tile[0], last_tile[1], level_x, level_y).max;
+  }
+  else {
+    decoded.min.x = level_dw.min.x;
+    decoded.max.x = level_dw.max.x;
+  }
+
+  const int64_t decoded_width = int64_t(decoded.max.x) - decoded.min.x + 1;
+  const int64_t decoded_height = int64_t(decoded.max.y) - decoded.min.y + 1;
+  const int64_t decoded_size = decoded_width * decoded_height;
+  Array<float> decoded_pixels(decoded_size * channels.size());
+
+  FrameBuffer frameBuffer;
+  for (const int i : channels.index_range()) {
+    /* Inverse correct first pixel for the decoded window coordinates. */
+    float *rect = decoded_pixels.data() + decoded_size * i -
+                  (decoded.min.x + decoded.min.y * decoded_width);
+    frameBuffer.insert(
+        channels[i]->internal_name,
+        Slice(Imf::FLOAT, (char *)rect, sizeof(float), decoded_width * sizeof(float)));
+  }
+
+  if (is_tiled) {
+    TiledInputPart in(file, part);
+    in.setFrameBuffer(frameBuffer);
+    in.readTiles(first_tile[0], last_tile[0], first_tile[1], last_tile[1], level_x, level_y);
+  }
+  else {
+    InputPart in(file, part);
+    in.setFrameBuffer(frameBuffer);
+    in.readPixels(region.min.y, region.max.y);
+  }
+
+  const int region_width = region.max.x - region.min.x + 1;
+  const int region_height = region.max.y - region.min.y + 1;
+  threading::parallel_for(IndexRange(region_height), 64, [&](const IndexRange rows) {
+    for (const int y : rows) {
+      /* Flip to Blender convention, where the first row is the bottom of the region. */
+      const int file_y = flip ? region.min.y + y : region.max.y - y;
+      const int64_t offset = (file_y - decoded.min.y) * decoded_width + region.min.x -
+                             decoded.min.x;
+      for (const int i : channels.index_range()) {
+        const ExrChannel &echan = *channels[i];
+        const float *src = decoded_pixels.data() + decoded_size * i + offset;
+        float *dst = echan.rect + int64_t(y) * echan.ystride;
+        for (int x = 0; x < region_width; x++) {
+          dst[int64_t(x) * echan.xstride] = src[x];
+        }
+      }
+    }
+  });
+}
+
+bool IMB_exr_read_channels_region(ExrHandle *handle,
+                                  const int region_min[2],
+                                  const int region_max[2],
+                                  const int level_x,
+                                  const int level_y)
+{
+  if (region_min[0] < 0 || region_min[1] < 0 || region_max[0] <= region_min[0] ||
+      region_max[1] <= region_min[1])
+  {
+    return false;
+  }
+
+  const bool flip = imb_exr_is_flipped(handle);
+
+  for (int i = 0; i < handle->ifile->parts(); i++) {
+    Vector<const ExrChannel *> channels;
+    for (const ExrChannel &echan : handle->channels) {
+      if (echan.part_number == i && echan.rect) {
+        channels.append(&echan);
+      }
+    }
+    if (channels.is_empty()) {
+      continue;
+    }
+
+    try {
+      Box2i level_dw;
+      if (!imb_exr_part_level_data_window(*handle->ifile, i, level_x, level_y, level_dw)) {
+        CLOG_ERROR(&LOG, "%s: part %d has no level %d %d", __func__, i, level_x, level_y);
+        return false;
+      }
+
+      const int level_width = level_dw.max.x - level_dw.min.x + 1;
+      const int level_height = level_dw.max.y - level_dw.min.y + 1;
+      if (region_max[0] > level_width || region_max[1] > level_height) {
+        CLOG_ERROR(&LOG, "%s: region is outside of part %d", __func__, i);
+        return false;
+      }
+
+      /* Convert the region to file coordinates, which go from top to bottom unless flipped. */
+      Box2i region;
+      region.min.x = level_dw.min.x + region_min[0];
+      region.max.x = level_dw.min.x + region_max[0] - 1;
+      if (flip) {
+        region.min.y = level_dw.min.y + region_min[1];
+        region.max.y = level_dw.min.y + region_max[1] - 1;
+      }
+      else {
+        region.min.y = level_dw.max.y - (region_max[1] - 1);
+        region.max.y = level_dw.max.y - region_min[1];
+      }
+
+      imb_exr_read_part_region(
+          *handle->ifile, i, channels, level_dw, region, level_x, level_y, flip);
+    }
+    catch (const std::exception &exc) {
+      CLOG_ERROR(&LOG, "%s: %s", __func__, exc.what());
+      return false;
+    }
+    catch (...) { /* Catch-all for edge cases or compiler bugs. */
+      CLOG_ERROR(&LOG, "Unknown error in %s", __func__);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void IMB_exr_multilayer_convert(ExrHandle *handle,
                                 void *base,
                                 void *(*addview)(void *base, const char *str),
@@ -1377,6 +1602,10 @@ void IMB_exr_multilayer_convert(ExrHandle *handle,
     void *laybase = addlayer(base, lay.name.c_str());
     if (laybase) {
       for (ExrPass &pass : lay.passes) {
+        /* Passes that were not read, see #IB_multilayer_combined_only. */
+        if (pass.rect == nullptr) {
+          continue;
+        }
         addpass(base,
                 laybase,
                 pass.internal_name.c_str(),
@@ -1817,6 +2046,30 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   return handle;
 }
 
+/**
+ * Free the buffers of all passes except for the first combined or color pass, such that the
+ * channels of the other passes are not read.
+ */
+static void imb_exr_keep_only_combined_pass(ExrHandle *handle)
+{
+  bool found_combined_pass = false;
+  for (ExrLayer &lay : handle->layers) {
+    for (ExrPass &pass : lay.passes) {
+      if (!found_combined_pass && pass.rect &&
+          (pass.internal_name == "Combined" || STR_ELEM(pass.chan_id, "RGBA", "RGB")))
+      {
+        found_combined_pass = true;
+        continue;
+      }
+
+      for (int a = 0; a < pass.totchan; a++) {
+        pass.chan[a]->rect = nullptr;
+      }
+      MEM_SAFE_DELETE(pass.rect);
+    }
+  }
+}
+
 /* ********************************************************* */
 
 static void exr_print_filecontents(MultiPartInputFile &file)
@@ -2179,6 +2432,9 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, ImFileColorSpa
           /* constructs channels for reading, allocates memory in channels */
           ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
           if (handle) {
+            if (flags & IB_multilayer_combined_only) {
+              imb_exr_keep_only_combined_pass(handle);
+            }
             IMB_exr_read_channels(handle);
             ibuf->exrhandle = handle; /* potential danger, the caller has to check for this! */
           }
@@ -59,6 +59,28 @@ bool IMB_exr_set_channel(ExrHandle * /*handle*/,
 void IMB_exr_read_channels(ExrHandle * /*handle*/) {}
 void IMB_exr_write_channels(ExrHandle * /*handle*/) {}
 
+void IMB_exr_get_num_levels(ExrHandle * /*handle*/, int *r_num_x_levels, int *r_num_y_levels)
+{
+  *r_num_x_levels = 1;
+  *r_num_y_levels = 1;
+}
+bool IMB_exr_get_level_size(ExrHandle * /*handle*/,
+                            int /*level_x*/,
+                            int /*level_y*/,
+                            int * /*r_width*/,
+                            int * /*r_height*/)
+{
+  return false;
+}
+bool IMB_exr_read_channels_region(ExrHandle * /*handle*/,
+                                  const int /*region_min*/[2],
+                                  const int /*region_max*/[2],
+                                  int /*level_x*/,
+                                  int /*level_y*/)
+{
+  return false;
+}
+
 void IMB_exr_multilayer_convert(ExrHandle * /*handle*/,
                                 void * /*base*/,
                                 void *(* /*addview*/)(void *base, const char *str),
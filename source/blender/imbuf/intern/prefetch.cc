@@ -0,0 +1,343 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ *
+ * Background loading of images which are expected to be needed soon, like the upcoming frames of
+ * image sequences during playback. Loaded images are stored in a movie cache, from which
+ * #IMB_load_image_from_filepath takes them.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "BLI_fileops.h"
+#include "BLI_ghash.h"
+#include "BLI_math_base.h"
+#include "BLI_path_utils.hh"
+#include "BLI_set.hh"
+#include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_vector.hh"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+#include "IMB_moviecache.hh"
+#include "IMB_openexr.hh"
+
+#include "IMB_prefetch_intern.hh"
+
+namespace blender {
+
+/** Maximum number of requests waiting to be loaded, older requests are dropped first. */
+static constexpr int max_pending_requests = 16;
+/** Maximum number of threads loading images at the same time. */
+static constexpr int max_workers = 4;
+/** Number of requests that are remembered before those of images freed by the cache limiter are
+ * looked for. */
+static constexpr int min_requests_prune_size = 64;
+
+struct ImagePrefetchKey {
+  char filepath[FILE_MAX];
+  char colorspace[IM_MAX_SPACE];
+  int flags;
+  /* Modification time and size of the file when it was loaded, to not use an image that was
+   * loaded before the file changed on disk. */
+  int64_t mtime;
+  int64_t size;
+
+  friend bool operator==(const ImagePrefetchKey &a, const ImagePrefetchKey &b)
+  {
+    return a.flags == b.flags && a.mtime == b.mtime && a.size == b.size &&
+           STREQ(a.filepath, b.filepath) && STREQ(a.colorspace, b.colorspace);
+  }
+};
+
+/**
+ * The arguments of a request, without the state of the file. Used to check if an image may have
+ * been prefetched before getting the state of the file, which is more expensive.
+ */
+struct ImagePrefetchRequest {
+  std::string filepath;
+  std::string colorspace;
+  int flags;
+
+  ImagePrefetchRequest(const char *filepath, const int flags, const char *colorspace)
+      : filepath(filepath), colorspace(colorspace), flags(flags)
+  {
+  }
+
+  explicit ImagePrefetchRequest(const ImagePrefetchKey &key)
+      : ImagePrefetchRequest(key.filepath, key.flags, key.colorspace)
+  {
+  }
+
+  uint64_t hash() const
+  {
+    return get_default_hash(filepath, colorspace, flags);
+  }
+
+  friend bool operator==(const ImagePrefetchRequest &a, const ImagePrefetchRequest &b) = default;
+};
+
+static struct {
+  std::mutex mutex;
+  /** Notified whenever a worker finished loading an image. */
+  std::condition_variable loaded_cond;
+  MovieCache *cache = nullptr;
+  TaskPool *pool = nullptr;
+  /** Requests waiting for a worker, oldest first. */
+  Vector<ImagePrefetchKey> pending;
+  /** Requests that are being loaded by a worker. */
+  Vector<ImagePrefetchKey> loading;
+  /**
+   * Requests that are pending, loading or loaded and not taken yet. Loaded images may have been
+   * freed by the cache limiter since, those are removed once the set grows past
+   * #requests_prune_size.
+   */
+  Set<ImagePrefetchRequest> requests;
+  int64_t requests_prune_size = min_requests_prune_size;
+  /** Directories of multi-layer images loaded with #IB_multilayer, see #prefetch_worker. */
+  Set<std::string> multilayer_directories;
+  int num_workers = 0;
+} g_prefetch;
+
+static uint prefetch_key_hash(const void *key_v)
+{
+  const ImagePrefetchKey *key = static_cast<const ImagePrefetchKey *>(key_v);
+  return BLI_ghashutil_strhash_p(key->filepath) ^ uint(key->mtime) ^ uint(key->flags);
+}
+
+static bool prefetch_key_cmp(const void *a_v, const void *b_v)
+{
+  const ImagePrefetchKey *a = static_cast<const ImagePrefetchKey *>(a_v);
+  const ImagePrefetchKey *b = static_cast<const ImagePrefetchKey *>(b_v);
+  /* Return false when equal, following GHash conventions. */
+  return !(*a == *b);
+}
+
+static bool prefetch_is_supported(const int flags, const char *colorspace)
+{
+  /* Without a color space the loader chooses one and returns it, which is not worth supporting
+   * here. Test loads only read the header, and are not worth prefetching either. */
+  return colorspace != nullptr && colorspace[0] != '\0' && !(flags & IB_test);
+}
+
+static std::string prefetch_directory(const char *filepath)
+{
+  char dir[FILE_MAX];
+  BLI_path_split_dir_part(filepath, dir, sizeof(dir));
+  return dir;
+}
+
+static bool prefetch_key_init(ImagePrefetchKey &key,
+                              const char *filepath,
+                              const int flags,
+                              const char *colorspace)
+{
+  BLI_stat_t st;
+  if (BLI_stat(filepath, &st) == -1) {
+    return false;
+  }
+
+  memset(&key, 0, sizeof(key));
+  STRNCPY(key.filepath, filepath);
+  STRNCPY(key.colorspace, colorspace);
+  key.flags = flags;
+  key.mtime = int64_t(st.st_mtime);
+  key.size = int64_t(st.st_size);
+  return true;
+}
+
+/**
+ * Forget the requests of images that were freed by the cache limiter. Must be called with the
+ * mutex locked.
+ */
+static void prefetch_prune_requests()
+{
+  Set<ImagePrefetchRequest> requests;
+  for (const ImagePrefetchKey &key : g_prefetch.pending) {
+    requests.add(ImagePrefetchRequest(key));
+  }
+  for (const ImagePrefetchKey &key : g_prefetch.loading) {
+    requests.add(ImagePrefetchRequest(key));
+  }
+  MovieCacheIter *iter = IMB_moviecacheIter_new(g_prefetch.cache);
+  while (!IMB_moviecacheIter_done(iter)) {
+    requests.add(
+        ImagePrefetchRequest(*static_cast<const ImagePrefetchKey *>(IMB_moviecacheIter_getUserKey(
+            iter))));
+    IMB_moviecacheIter_step(iter);
+  }
+  IMB_moviecacheIter_free(iter);
+
+  g_prefetch.requests = std::move(requests);
+  /* Grow with the number of cached images, to not iterate over them for every request. */
+  g_prefetch.requests_prune_size = std::max<int64_t>(min_requests_prune_size,
+                                                     g_prefetch.requests.size() * 2);
+}
+
+static void prefetch_worker(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  std::unique_lock lock(g_prefetch.mutex);
+
+  while (!g_prefetch.pending.is_empty() && !BLI_task_pool_current_canceled(pool)) {
+    const ImagePrefetchKey key = g_prefetch.pending[0];
+    g_prefetch.pending.remove(0);
+    g_prefetch.loading.append(key);
+    lock.unlock();
+
+    char colorspace[IM_MAX_SPACE];
+    STRNCPY(colorspace, key.colorspace);
+    ImBuf *ibuf = imb_load_image_from_filepath_direct(key.filepath, key.flags, colorspace);
+
+    if (ibuf && ibuf->exrhandle) {
+      /* Multi-layer images own an EXR handle, which the movie cache would not free. The caller
+       * loads them itself, and the other images of their directory are assumed to be multi-layer
+       * images of the same sequence, so they are not requested anymore. */
+      IMB_exr_close(ibuf->exrhandle);
+      ibuf->exrhandle = nullptr;
+      IMB_freeImBuf(ibuf);
+      ibuf = nullptr;
+      lock.lock();
+      g_prefetch.multilayer_directories.add(prefetch_directory(key.filepath));
+    }
+    else {
+      lock.lock();
+    }
+
+    g_prefetch.loading.remove_first_occurrence_and_reorder(key);
+    if (ibuf) {
+      /* Failed loads are not cached, the caller will fail and report the error itself. */
+      IMB_moviecache_put(g_prefetch.cache, const_cast<ImagePrefetchKey *>(&key), ibuf);
+      IMB_freeImBuf(ibuf);
+    }
+    g_prefetch.loaded_cond.notify_all();
+  }
+
+  g_prefetch.num_workers--;
+}
+
+void IMB_prefetch_image_from_filepath(const char *filepath,
+                                      const int flags,
+                                      const char *colorspace)
+{
+  BLI_assert(!BLI_path_is_rel(filepath));
+
+  ImagePrefetchKey key;
+  if (!prefetch_is_supported(flags, colorspace) ||
+      !prefetch_key_init(key, filepath, flags, colorspace))
+  {
+    return;
+  }
+
+  std::lock_guard lock(g_prefetch.mutex);
+
+  if ((flags & IB_multilayer) &&
+      g_prefetch.multilayer_directories.contains(prefetch_directory(filepath)))
+  {
+    return;
+  }
+
+  if (g_prefetch.cache == nullptr) {
+    g_prefetch.cache = IMB_moviecache_create(
+        "Image Prefetch", sizeof(ImagePrefetchKey), prefetch_key_hash, prefetch_key_cmp);
+  }
+  else if (IMB_moviecache_has_frame(g_prefetch.cache, &key) ||
+           g_prefetch.pending.contains(key) || g_prefetch.loading.contains(key))
+  {
+    return;
+  }
+
+  if (g_prefetch.pending.size() >= max_pending_requests) {
+    g_prefetch.requests.remove(ImagePrefetchRequest(g_prefetch.pending[0]));
+    g_prefetch.pending.remove(0);
+  }
+  g_prefetch.pending.append(key);
+  g_prefetch.requests.add(ImagePrefetchRequest(key));
+  if (g_prefetch.requests.size() > g_prefetch.requests_prune_size) {
+    prefetch_prune_requests();
+  }
+
+  /* Keep a core free for the threads that use the images. */
+  const int workers_limit = clamp_i(BLI_system_thread_count() - 1, 1, max_workers);
+  if (g_prefetch.num_workers < workers_limit) {
+    if (g_prefetch.pool == nullptr) {
+      g_prefetch.pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+    }
+    g_prefetch.num_workers++;
+    BLI_task_pool_push(g_prefetch.pool, prefetch_worker, nullptr, false, nullptr);
+  }
+}
+
+ImBuf *imb_prefetch_take(const char *filepath, const int flags, const char *colorspace)
+{
+  if (!prefetch_is_supported(flags, colorspace)) {
+    return nullptr;
+  }
+
+  const ImagePrefetchRequest request(filepath, flags, colorspace);
+  {
+    /* Avoid the file system access of the key unless a matching image was requested. */
+    std::lock_guard lock(g_prefetch.mutex);
+    if (!g_prefetch.requests.contains(request)) {
+      return nullptr;
+    }
+  }
+
+  ImagePrefetchKey key;
+  const bool is_file_found = prefetch_key_init(key, filepath, flags, colorspace);
+
+  std::unique_lock lock(g_prefetch.mutex);
+
+  /* Whether or not an image is taken, the caller has the image now. */
+  g_prefetch.requests.remove(request);
+  if (!is_file_found) {
+    return nullptr;
+  }
+
+  /* The caller loads the image itself, no need for a worker to do it as well. */
+  g_prefetch.pending.remove_if([&](const ImagePrefetchKey &other) { return other == key; });
+
+  /* Waiting for a load in progress is always faster than starting over. */
+  g_prefetch.loaded_cond.wait(lock, [&]() { return !g_prefetch.loading.contains(key); });
+
+  ImBuf *ibuf = IMB_moviecache_get(g_prefetch.cache, &key, nullptr);
+  if (ibuf) {
+    /* Give ownership to the caller, which typically stores the image in its own cache. */
+    IMB_moviecache_remove(g_prefetch.cache, &key);
+  }
+  return ibuf;
+}
+
+void imb_prefetch_exit()
+{
+  TaskPool *pool;
+  {
+    std::lock_guard lock(g_prefetch.mutex);
+    g_prefetch.pending.clear();
+    g_prefetch.requests.clear();
+    g_prefetch.requests_prune_size = min_requests_prune_size;
+    g_prefetch.multilayer_directories.clear();
+    pool = g_prefetch.pool;
+    g_prefetch.pool = nullptr;
+  }
+
+  if (pool) {
+    BLI_task_pool_cancel(pool);
+    BLI_task_pool_free(pool);
+  }
+
+  if (g_prefetch.cache) {
+    IMB_moviecache_free(g_prefetch.cache);
+    g_prefetch.cache = nullptr;
+  }
+}
+
+}  // namespace blender
@@ -27,6 +27,7 @@
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
 #include "IMB_metadata.hh"
+#include "IMB_prefetch_intern.hh"
 #include "IMB_thumbs.hh"
 #include "imbuf.hh"
 
@@ -195,9 +196,9 @@ ImBuf *IMB_load_image_from_file_descriptor(const int file,
   return ibuf;
 }
 
-ImBuf *IMB_load_image_from_filepath(const char *filepath,
-                                    const int flags,
-                                    char r_colorspace[IM_MAX_SPACE])
+ImBuf *imb_load_image_from_filepath_direct(const char *filepath,
+                                           const int flags,
+                                           char r_colorspace[IM_MAX_SPACE])
 {
   ImBuf *ibuf;
   int file;
@@ -220,6 +221,16 @@ ImBuf *IMB_load_image_from_filepath(const char *filepath,
   return ibuf;
 }
 
+ImBuf *IMB_load_image_from_filepath(const char *filepath,
+                                    const int flags,
+                                    char r_colorspace[IM_MAX_SPACE])
+{
+  if (ImBuf *ibuf = imb_prefetch_take(filepath, flags, r_colorspace)) {
+    return ibuf;
+  }
+  return imb_load_image_from_filepath_direct(filepath, flags, r_colorspace);
+}
+
 ImBuf *IMB_thumb_load_image(const char *filepath,
                             const size_t max_thumb_size,
                             char r_colorspace[IM_MAX_SPACE],
@@ -19,6 +19,8 @@
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
@@ -706,6 +708,13 @@ struct MovieProxyBuilder {
 
   bool build_only_on_bad_performance;
   bool building_cancelled;
+
+  /**
+   * Scales and encodes #encode_frame into all proxy sizes, while the next frame is decoded.
+   * Only one frame is encoded at a time, so that the encoders receive the frames in order.
+   */
+  TaskPool *encode_pool;
+  AVFrame *encode_frame;
 };
 
 static MovieProxyBuilder *index_ffmpeg_create_context(MovieReader *anim,
@@ -861,6 +870,28 @@ static void index_rebuild_ffmpeg_finish(MovieProxyBuilder *context, const bool s
   MEM_delete(context);
 }
 
+static void index_rebuild_ffmpeg_encode_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  MovieProxyBuilder *context = static_cast<MovieProxyBuilder *>(BLI_task_pool_user_data(pool));
+
+  /* Every proxy size has its own scaling context and encoder, so they can run concurrently. */
+  threading::parallel_for(IndexRange(context->num_proxy_sizes), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (context->proxy_ctx[i] == nullptr) {
+        continue;
+      }
+      /* Encoding modifies the frame, so give each size its own reference to the pixels. */
+      AVFrame *frame = av_frame_clone(context->encode_frame);
+      if (frame == nullptr) {
+        /* Passing no frame would flush the encoder instead. */
+        continue;
+      }
+      add_to_proxy_output_ffmpeg(context->proxy_ctx[i], frame);
+      av_frame_free(&frame);
+    }
+  });
+}
+
 static void index_rebuild_ffmpeg_proc_decoded_frame(MovieProxyBuilder *context, AVFrame *in_frame)
 {
   int i;
@@ -868,8 +899,19 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(MovieProxyBuilder *context,
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(in_frame);
 
-  for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
+  /* Wait for the previous frame before replacing it. Keeping a reference to the decoded frame
+   * prevents the decoder from reusing its buffers while they are being encoded. */
+  BLI_task_pool_work_and_wait(context->encode_pool);
+  av_frame_unref(context->encode_frame);
+  const int ret = av_frame_ref(context->encode_frame, in_frame);
+  if (ret < 0) {
+    char error_str[AV_ERROR_MAX_STRING_SIZE];
+    av_make_error_string(error_str, AV_ERROR_MAX_STRING_SIZE, ret);
+    CLOG_ERROR(&LOG, "Error referencing proxy frame: %s", error_str);
+  }
+  else {
+    BLI_task_pool_push(
+        context->encode_pool, index_rebuild_ffmpeg_encode_task, nullptr, false, nullptr);
   }
 
   if (!context->start_pts_set) {
@@ -921,6 +963,10 @@ static int index_rebuild_ffmpeg(MovieProxyBuilder *context,
       av_guess_frame_rate(context->iFormatCtx, context->iStream, nullptr));
   context->pts_time_base = av_q2d(context->iStream->time_base);
 
+  context->encode_pool = BLI_task_pool_create(context, TASK_PRIORITY_HIGH);
+  context->encode_frame = av_frame_alloc();
+  const double start_time = BLI_time_now_seconds();
+
   float progress = 0.0f;
   while (av_read_frame(context->iFormatCtx, next_packet) >= 0) {
     float next_progress =
@@ -993,6 +1039,21 @@ static int index_rebuild_ffmpeg(MovieProxyBuilder *context,
     }
   }
 
+  BLI_task_pool_work_and_wait(context->encode_pool);
+  BLI_task_pool_free(context->encode_pool);
+  context->encode_pool = nullptr;
+  av_frame_free(&context->encode_frame);
+
+  if (!*stop) {
+    const double duration = BLI_time_now_seconds() - start_time;
+    CLOG_INFO(&LOG,
+              "Built proxies for '%s': %d frames in %.2f s (%.1f frames/s)",
+              context->iFormatCtx->url,
+              context->frameno_gapless,
+              duration,
+              duration > 0.0 ? context->frameno_gapless / duration : 0.0);
+  }
+
   av_packet_free(&next_packet);
   av_free(in_frame);
 
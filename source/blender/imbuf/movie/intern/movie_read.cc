@@ -8,21 +8,27 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <sys/types.h>
 
+#include "BLI_mutex.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_scene_types.h"
 
+#include "MEM_CacheLimiterC-Api.h"
 #include "MEM_guardedalloc.h"
 
 #include "IMB_colormanagement.hh"
@@ -57,6 +63,55 @@ namespace blender {
 
 #ifdef WITH_FFMPEG
 static CLG_LogRef LOG = {"video.read"};
+
+/* Decoding a frame requires decoding all frames since the key frame of its group of pictures
+ * (GOP), so stepping backward through footage with long GOPs would decode the GOP again for every
+ * single frame. To avoid that, the frames decoded while stepping backward are kept in this cache,
+ * which is consulted whenever the decoder would have to seek. While stepping backward, the GOP
+ * before the earliest cached frame is decoded ahead of time by a separate decoder on a background
+ * thread. Frames decoded during forward playback are not cached, since they are not requested
+ * again. */
+struct MovieGOPCache {
+  /* References to decoded frames, ordered by their PTS. */
+  Vector<AVFrame *> frames;
+  /* Total size of the data of the cached frames. */
+  int64_t size_in_bytes = 0;
+  /* The PTS of the most recently requested frame, frames farthest from it are evicted first. */
+  int64_t requested_pts = 0;
+  /* Protects the members above, since frames are also added by the prefetch task. */
+  Mutex mutex;
+
+  /* The position of the most recently fetched frame, used to detect backward stepping. */
+  int last_position = -1;
+  /* True while the main decoder decodes frames for a backward step, which are then cached. */
+  bool is_filling = false;
+
+  /* Background pool that runs the prefetch task, along with the decoder that is only used by that
+   * task. Both are created on the first prefetch. */
+  TaskPool *prefetch_pool = nullptr;
+  AVFormatContext *prefetch_format_ctx = nullptr;
+  AVCodecContext *prefetch_codec_ctx = nullptr;
+  int prefetch_stream = -1;
+  /* The PTS of the key frame that the running prefetch task decodes up to, or -1 if no prefetch
+   * task is running. */
+  std::atomic<int64_t> prefetch_end_pts = -1;
+  std::atomic<bool> prefetch_stop = false;
+};
+
+/* Upper limit of the memory budget shared by the decoded frames of all #MovieGOPCache. */
+static constexpr int64_t gop_cache_max_size_in_bytes = int64_t(256) * 1024 * 1024;
+/* Total size of the decoded frames of all #MovieGOPCache. */
+static std::atomic<int64_t> gop_cache_total_size_in_bytes = 0;
+
+/* The decoded frames of all readers share one budget. It is a part of the memory cache limit from
+ * the preferences, which also limits the movie cache that stores the final images. */
+static int64_t gop_cache_budget_in_bytes()
+{
+  if (MEM_CacheLimiter_is_disabled()) {
+    return gop_cache_max_size_in_bytes;
+  }
+  return std::min(gop_cache_max_size_in_bytes, int64_t(MEM_CacheLimiter_get_maximum() / 4));
+}
 #endif
 
 #ifdef WITH_FFMPEG
@@ -373,6 +428,39 @@ static AVFormatContext *init_format_context_vpx_workarounds(const char *filepath
   return format_ctx;
 }
 
+/* Create and open a decoder context for the given video stream. Returns nullptr on failure. */
+static AVCodecContext *init_codec_context(const AVCodec *codec, const AVStream *video_stream)
+{
+  AVCodecContext *codec_ctx = avcodec_alloc_context3(nullptr);
+  avcodec_parameters_to_context(codec_ctx, video_stream->codecpar);
+  codec_ctx->workaround_bugs = FF_BUG_AUTODETECT;
+
+  if (codec->capabilities & AV_CODEC_CAP_OTHER_THREADS) {
+    codec_ctx->thread_count = 0;
+  }
+  else {
+    codec_ctx->thread_count = MOV_thread_count();
+  }
+
+  if (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
+    codec_ctx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
+    codec_ctx->thread_type = FF_THREAD_SLICE;
+  }
+
+  if (avcodec_open2(codec_ctx, codec, nullptr) < 0) {
+    avcodec_free_context(&codec_ctx);
+    return nullptr;
+  }
+  if (codec_ctx->pix_fmt == AV_PIX_FMT_NONE) {
+    avcodec_free_context(&codec_ctx);
+    return nullptr;
+  }
+
+  return codec_ctx;
+}
+
 static int startffmpeg(MovieReader *anim)
 {
   if (anim == nullptr) {
@@ -388,31 +476,9 @@ static int startffmpeg(MovieReader *anim)
     return -1;
   }
 
-  AVCodecContext *pCodecCtx = avcodec_alloc_context3(nullptr);
   AVStream *video_stream = pFormatCtx->streams[video_stream_index];
-  avcodec_parameters_to_context(pCodecCtx, video_stream->codecpar);
-  pCodecCtx->workaround_bugs = FF_BUG_AUTODETECT;
-
-  if (pCodec->capabilities & AV_CODEC_CAP_OTHER_THREADS) {
-    pCodecCtx->thread_count = 0;
-  }
-  else {
-    pCodecCtx->thread_count = MOV_thread_count();
-  }
-
-  if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
-    pCodecCtx->thread_type = FF_THREAD_FRAME;
-  }
-  else if (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
-    pCodecCtx->thread_type = FF_THREAD_SLICE;
-  }
-
-  if (avcodec_open2(pCodecCtx, pCodec, nullptr) < 0) {
-    avformat_close_input(&pFormatCtx);
-    return -1;
-  }
-  if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
-    avcodec_free_context(&anim->pCodecCtx);
+  AVCodecContext *pCodecCtx = init_codec_context(pCodec, video_stream);
+  if (pCodecCtx == nullptr) {
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -543,6 +609,8 @@ static int startffmpeg(MovieReader *anim)
     return -1;
   }
 
+  anim->gop_cache = MEM_new<MovieGOPCache>("MovieGOPCache");
+
   return 0;
 }
 
@@ -718,7 +786,7 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
 
   if (anim->ib_flags & IB_animdeinterlace) {
     if (ffmpeg_deinterlace(anim->pFrameDeinterlaced,
-                           anim->pFrame,
+                           input,
                            anim->pCodecCtx->pix_fmt,
                            anim->pCodecCtx->width,
                            anim->pCodecCtx->height) < 0)
@@ -852,19 +920,310 @@ static AVFrame *ffmpeg_frame_by_pts_get(MovieReader *anim, int64_t pts_to_search
   return best_frame;
 }
 
-static void ffmpeg_decode_store_frame_pts(MovieReader *anim)
+static bool ffmpeg_frame_is_key_frame(const AVFrame *frame)
 {
-  anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
-
 #  ifdef FFMPEG_OLD_KEY_FRAME_QUERY_METHOD
-  if (anim->pFrame->key_frame)
+  return frame->key_frame;
 #  else
-  if (anim->pFrame->flags & AV_FRAME_FLAG_KEY)
+  return frame->flags & AV_FRAME_FLAG_KEY;
 #  endif
+}
+
+static int64_t ffmpeg_frame_pts_get(const AVFrame *frame)
+{
+  return timestamp_from_pts_or_dts(frame->pts, frame->pkt_dts);
+}
+
+static int64_t ffmpeg_frame_size_in_bytes(const AVFrame *frame)
+{
+  return av_image_get_buffer_size(AVPixelFormat(frame->format), frame->width, frame->height, 1);
+}
+
+/* Add a reference to the given decoded frame to the cache. If the memory budget shared by all
+ * caches is exceeded, the frames of this cache that are farthest from its most recently requested
+ * frame are evicted, which might be the new frame itself. */
+static void ffmpeg_gop_cache_add(MovieGOPCache &cache, const AVFrame *frame)
+{
+  const int64_t frame_size = ffmpeg_frame_size_in_bytes(frame);
+  const int64_t budget = gop_cache_budget_in_bytes();
+  if (frame_size <= 0 || frame_size > budget) {
+    return;
+  }
+
+  const int64_t pts = ffmpeg_frame_pts_get(frame);
+
+  std::lock_guard lock(cache.mutex);
+  const int64_t insert_index = std::lower_bound(cache.frames.begin(),
+                                                cache.frames.end(),
+                                                pts,
+                                                [](const AVFrame *cached_frame, int64_t value) {
+                                                  return ffmpeg_frame_pts_get(cached_frame) <
+                                                         value;
+                                                }) -
+                               cache.frames.begin();
+  if (insert_index < cache.frames.size() &&
+      ffmpeg_frame_pts_get(cache.frames[insert_index]) == pts)
+  {
+    /* Already cached. */
+    return;
+  }
+
+  AVFrame *frame_reference = av_frame_clone(frame);
+  if (frame_reference == nullptr) {
+    return;
+  }
+  cache.frames.insert(insert_index, frame_reference);
+  cache.size_in_bytes += frame_size;
+  gop_cache_total_size_in_bytes += frame_size;
+
+  while (gop_cache_total_size_in_bytes > budget && !cache.frames.is_empty()) {
+    /* Frames are ordered, so the farthest frame is either the first or the last one. */
+    const int64_t first_distance = std::abs(cache.requested_pts -
+                                            ffmpeg_frame_pts_get(cache.frames.first()));
+    const int64_t last_distance = std::abs(cache.requested_pts -
+                                           ffmpeg_frame_pts_get(cache.frames.last()));
+    AVFrame *evicted_frame = first_distance > last_distance ? cache.frames.first() :
+                                                              cache.frames.last();
+    if (first_distance > last_distance) {
+      cache.frames.remove(0);
+    }
+    else {
+      cache.frames.remove_last();
+    }
+    const int64_t evicted_size = ffmpeg_frame_size_in_bytes(evicted_frame);
+    cache.size_in_bytes -= evicted_size;
+    gop_cache_total_size_in_bytes -= evicted_size;
+    av_frame_free(&evicted_frame);
+  }
+}
+
+/* Return a new reference to the cached frame that contains `pts_to_search`, or nullptr if no such
+ * frame is cached. The returned frame must be freed with `av_frame_free`. */
+static AVFrame *ffmpeg_gop_cache_lookup(MovieReader *anim, int64_t pts_to_search)
+{
+  MovieGOPCache &cache = *anim->gop_cache;
+
+  /* Wait for the prefetch task if it is decoding frames before the requested one. */
+  if (cache.prefetch_end_pts != -1 && pts_to_search < cache.prefetch_end_pts) {
+    BLI_task_pool_work_and_wait(cache.prefetch_pool);
+  }
+
+  std::lock_guard lock(cache.mutex);
+  cache.requested_pts = pts_to_search;
+
+  for (const int64_t i : cache.frames.index_range()) {
+    const AVFrame *frame = cache.frames[i];
+    const int64_t frame_start = ffmpeg_frame_pts_get(frame);
+    int64_t frame_end = frame_start + av_get_frame_duration_in_pts_units(frame);
+    /* Assume the frame lasts until the next cached frame if its duration is unknown. */
+    if (frame_end == frame_start && i + 1 < cache.frames.size()) {
+      frame_end = ffmpeg_frame_pts_get(cache.frames[i + 1]);
+    }
+
+    if (!ffmpeg_pts_isect(frame_start, frame_end, pts_to_search)) {
+      continue;
+    }
+
+    /* The resolution can change per-frame with WebM. */
+    if (frame->width != anim->pCodecCtx->width || frame->height != anim->pCodecCtx->height) {
+      return nullptr;
+    }
+
+    final_frame_log(anim, frame_start, frame_end, "Cached");
+    return av_frame_clone(frame);
+  }
+
+  return nullptr;
+}
+
+/* Open the decoder used by the prefetch task, returns false on failure. */
+static bool ffmpeg_gop_cache_prefetch_decoder_ensure(MovieReader *anim)
+{
+  MovieGOPCache &cache = *anim->gop_cache;
+  if (cache.prefetch_codec_ctx != nullptr) {
+    return true;
+  }
+
+  const AVCodec *codec = nullptr;
+  AVFormatContext *format_ctx = init_format_context_vpx_workarounds(
+      anim->filepath, anim->streamindex, cache.prefetch_stream, codec);
+  if (format_ctx == nullptr || codec == nullptr) {
+    avformat_close_input(&format_ctx);
+    return false;
+  }
+
+  AVCodecContext *codec_ctx = init_codec_context(codec,
+                                                 format_ctx->streams[cache.prefetch_stream]);
+  if (codec_ctx == nullptr) {
+    avformat_close_input(&format_ctx);
+    return false;
+  }
+
+  cache.prefetch_format_ctx = format_ctx;
+  cache.prefetch_codec_ctx = codec_ctx;
+  return true;
+}
+
+/* Decode the GOP that precedes the key frame at `prefetch_end_pts` and add its frames to the
+ * cache. Runs in the background with a separate decoder, so it doesn't interfere with the state
+ * of the main decoder of the reader. */
+static void ffmpeg_gop_cache_prefetch_task(TaskPool *__restrict pool, void * /*task_data*/)
+{
+  MovieReader *anim = static_cast<MovieReader *>(BLI_task_pool_user_data(pool));
+  MovieGOPCache &cache = *anim->gop_cache;
+  const int64_t end_pts = cache.prefetch_end_pts;
+
+  if (!ffmpeg_gop_cache_prefetch_decoder_ensure(anim)) {
+    cache.prefetch_end_pts = -1;
+    return;
+  }
+
+  AVFormatContext *format_ctx = cache.prefetch_format_ctx;
+  AVCodecContext *codec_ctx = cache.prefetch_codec_ctx;
+
+  /* Seek to the key frame of the previous GOP. */
+  if (av_seek_frame(format_ctx, cache.prefetch_stream, end_pts - 1, AVSEEK_FLAG_BACKWARD) < 0) {
+    cache.prefetch_end_pts = -1;
+    return;
+  }
+  avcodec_flush_buffers(codec_ctx);
+
+  AVPacket *packet = av_packet_alloc();
+  AVFrame *frame = av_frame_alloc();
+  int64_t key_frame_pts = -1;
+  bool is_done = false;
+  while (!is_done && !cache.prefetch_stop) {
+    int ret = 0;
+    while ((ret = av_read_frame(format_ctx, packet)) >= 0) {
+      if (packet->stream_index == cache.prefetch_stream) {
+        break;
+      }
+      av_packet_unref(packet);
+    }
+
+    if (ret < 0) {
+      /* Flush any remaining frames out of the decoder. */
+      avcodec_send_packet(codec_ctx, nullptr);
+      is_done = true;
+    }
+    else {
+      avcodec_send_packet(codec_ctx, packet);
+      av_packet_unref(packet);
+    }
+
+    while (avcodec_receive_frame(codec_ctx, frame) == 0) {
+      const int64_t pts = ffmpeg_frame_pts_get(frame);
+      if (pts >= end_pts) {
+        is_done = true;
+      }
+      else if (key_frame_pts == -1 && ffmpeg_frame_is_key_frame(frame)) {
+        key_frame_pts = pts;
+      }
+
+      /* Frames before the key frame can't be decoded correctly after seeking. */
+      if (!is_done && key_frame_pts != -1 && pts >= key_frame_pts) {
+        ffmpeg_gop_cache_add(cache, frame);
+      }
+      av_frame_unref(frame);
+    }
+  }
+
+  av_frame_free(&frame);
+  av_packet_free(&packet);
+  cache.prefetch_end_pts = -1;
+}
+
+/* While stepping backward through the earliest GOP in the cache, start decoding the GOP before it
+ * in the background, such that it is already cached once it is reached. */
+static void ffmpeg_gop_cache_prefetch_if_needed(MovieReader *anim,
+                                                const bool is_stepping_backward,
+                                                int64_t pts_to_search)
+{
+  MovieGOPCache &cache = *anim->gop_cache;
+  if (!is_stepping_backward || cache.prefetch_end_pts != -1) {
+    return;
+  }
+
+  /* Formats that need #ffmpeg_generic_seek_workaround can't reliably seek to key frames. */
+  if (anim->pFormatCtx->iformat->flags & AVFMT_TS_DISCONT) {
+    return;
+  }
+
+  int64_t key_frame_pts;
   {
+    std::lock_guard lock(cache.mutex);
+    if (cache.frames.is_empty() || !ffmpeg_frame_is_key_frame(cache.frames.first())) {
+      return;
+    }
+
+    /* The requested frame should be in the earliest cached GOP. */
+    for (const AVFrame *frame : cache.frames.as_span().drop_front(1)) {
+      const int64_t pts = ffmpeg_frame_pts_get(frame);
+      if (pts > pts_to_search) {
+        break;
+      }
+      if (ffmpeg_frame_is_key_frame(frame)) {
+        return;
+      }
+    }
+
+    key_frame_pts = ffmpeg_frame_pts_get(cache.frames.first());
+  }
+
+  /* The earliest cached GOP is the first GOP of the stream. */
+  const AVStream *video_stream = anim->pFormatCtx->streams[anim->videoStream];
+  const int64_t start_pts = video_stream->start_time != AV_NOPTS_VALUE ? video_stream->start_time :
+                                                                         0;
+  if (key_frame_pts <= start_pts) {
+    return;
+  }
+
+  if (cache.prefetch_pool == nullptr) {
+    cache.prefetch_pool = BLI_task_pool_create_background(anim, TASK_PRIORITY_LOW);
+  }
+
+  cache.prefetch_end_pts = key_frame_pts;
+  BLI_task_pool_push(cache.prefetch_pool, ffmpeg_gop_cache_prefetch_task, nullptr, false, nullptr);
+}
+
+static void ffmpeg_gop_cache_free(MovieReader *anim)
+{
+  MovieGOPCache *cache = anim->gop_cache;
+  if (cache == nullptr) {
+    return;
+  }
+
+  if (cache->prefetch_pool) {
+    cache->prefetch_stop = true;
+    BLI_task_pool_work_and_wait(cache->prefetch_pool);
+    BLI_task_pool_free(cache->prefetch_pool);
+  }
+  if (cache->prefetch_codec_ctx) {
+    avcodec_free_context(&cache->prefetch_codec_ctx);
+    avformat_close_input(&cache->prefetch_format_ctx);
+  }
+
+  for (AVFrame *frame : cache->frames) {
+    av_frame_free(&frame);
+  }
+  gop_cache_total_size_in_bytes -= cache->size_in_bytes;
+
+  MEM_delete(cache);
+  anim->gop_cache = nullptr;
+}
+
+static void ffmpeg_decode_store_frame_pts(MovieReader *anim)
+{
+  anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
+
+  if (ffmpeg_frame_is_key_frame(anim->pFrame)) {
     anim->cur_key_frame_pts = anim->cur_pts;
   }
 
+  if (anim->gop_cache->is_filling) {
+    ffmpeg_gop_cache_add(*anim->gop_cache, anim->pFrame);
+  }
+
   av_log(anim->pFormatCtx,
          AV_LOG_DEBUG,
          "  FRAME DONE: cur_pts=%" PRId64 ", guessed_pts=%" PRId64 "\n",
@@ -1250,6 +1609,9 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
   double pts_time_base = av_q2d(v_st->time_base);
   int64_t start_pts = v_st->start_time;
 
+  /* A reference to a frame from the GOP cache, if it was used instead of decoding. */
+  AVFrame *cached_frame = nullptr;
+
   if (anim->never_seek_decode_one_frame) {
     /* If we must only ever decode one frame, and never seek, do so here. */
     if (!anim->pFrame_complete) {
@@ -1267,13 +1629,35 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
            frame_rate,
            start_pts);
 
+    MovieGOPCache &gop_cache = *anim->gop_cache;
+    const bool is_stepping_backward = position < gop_cache.last_position;
+    gop_cache.last_position = position;
+
     if (ffmpeg_must_decode(anim, position)) {
-      if (ffmpeg_must_seek(anim, position)) {
-        ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
+      /* Sequential frames are cheap to decode, only use the cache when seeking would be needed.
+       * The decoder is not advanced in that case, so it can still continue sequentially. */
+      const bool must_seek = ffmpeg_must_seek(anim, position);
+      if (must_seek) {
+        cached_frame = ffmpeg_gop_cache_lookup(anim, pts_to_search);
       }
 
-      ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+      if (cached_frame == nullptr) {
+        if (must_seek) {
+          ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
+        }
+
+        /* The frames decoded before the requested one are likely requested next when stepping
+         * backward. */
+        gop_cache.is_filling = is_stepping_backward;
+        ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+        gop_cache.is_filling = false;
+      }
+      else {
+        anim->gop_cache_hits++;
+      }
     }
+
+    ffmpeg_gop_cache_prefetch_if_needed(anim, is_stepping_backward, pts_to_search);
   }
 
   /* Update resolution as it can change per-frame with WebM. See #100741 & #100081. */
@@ -1301,7 +1685,8 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     IMB_assign_byte_buffer(cur_frame_final, buffer_data, IB_TAKE_OWNERSHIP);
   }
 
-  AVFrame *final_frame = ffmpeg_frame_by_pts_get(anim, pts_to_search);
+  AVFrame *final_frame = cached_frame ? cached_frame :
+                                        ffmpeg_frame_by_pts_get(anim, pts_to_search);
   if (final_frame == nullptr) {
     /* No valid frame was decoded for requested PTS, fall back on most recent decoded frame, even
      * if it is incorrect. */
@@ -1314,6 +1699,9 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     ffmpeg_postprocess(anim, final_frame, cur_frame_final);
   }
 
+  const bool is_cached_frame = cached_frame != nullptr;
+  av_frame_free(&cached_frame);
+
   if (anim->is_float) {
     if (anim->keep_original_colorspace) {
       /* Movie has been explicitly requested to keep original colorspace, regardless of the nature
@@ -1339,7 +1727,10 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     cur_frame_final->byte_buffer.colorspace = colormanage_colorspace_get_named(anim->colorspace);
   }
 
-  anim->cur_position = position;
+  /* The position of the decoder is only advanced when decoding. */
+  if (!is_cached_frame) {
+    anim->cur_position = position;
+  }
 
   return cur_frame_final;
 }
@@ -1350,6 +1741,8 @@ static void free_anim_ffmpeg(MovieReader *anim)
     return;
   }
 
+  ffmpeg_gop_cache_free(anim);
+
   if (anim->pCodecCtx) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1468,15 +1861,12 @@ ImBuf *MOV_decode_frame(MovieReader *anim,
 #ifdef WITH_FFMPEG
   if (anim->state == MovieReader::State::Valid) {
     ibuf = ffmpeg_fetchibuf(anim, position, tc);
-    if (ibuf) {
-      anim->cur_position = position;
-    }
   }
 #endif
 
   if (ibuf) {
     STRNCPY(ibuf->filepath, anim->filepath);
-    ibuf->fileframe = anim->cur_position + 1;
+    ibuf->fileframe = position + 1;
   }
   return ibuf;
 }
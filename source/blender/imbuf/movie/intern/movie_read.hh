@@ -31,6 +31,7 @@ extern "C" {
 namespace blender {
 
 struct IDProperty;
+struct MovieGOPCache;
 struct MovieIndex;
 
 struct MovieReader {
@@ -76,6 +77,12 @@ struct MovieReader {
   bool seek_before_decode = false;
   bool is_float = false;
 
+  /* Recently decoded frames, used to avoid decoding the group of pictures again for every frame
+   * when stepping backward. See #MovieGOPCache in `movie_read.cc`. */
+  MovieGOPCache *gop_cache = nullptr;
+  /* Number of frames that were taken from the GOP cache instead of being decoded. */
+  int64_t gop_cache_hits = 0;
+
   /* When set, never seek within the video, and only ever decode one frame.
    * This is a workaround for some Ogg files that have full audio but only
    * one frame of "album art" as a video stream in non-Theora format.
@@ -0,0 +1,193 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_path_utils.hh"
+
+#include "BKE_appdir.hh"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "MOV_read.hh"
+
+#include "movie_read.hh"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/log.h>
+}
+
+namespace blender::tests {
+
+static constexpr int movie_width = 64;
+static constexpr int movie_height = 48;
+static constexpr int movie_frames_num = 36;
+static constexpr int movie_gop_size = 12;
+
+static void encode_frame(AVFormatContext *format_ctx,
+                         AVCodecContext *codec_ctx,
+                         const AVStream *stream,
+                         const AVFrame *frame,
+                         AVPacket *packet)
+{
+  avcodec_send_frame(codec_ctx, frame);
+  while (avcodec_receive_packet(codec_ctx, packet) == 0) {
+    av_packet_rescale_ts(packet, codec_ctx->time_base, stream->time_base);
+    packet->stream_index = stream->index;
+    av_interleaved_write_frame(format_ctx, packet);
+  }
+}
+
+/* Write a movie with key frames every #movie_gop_size frames and a gradient that moves a bit in
+ * every frame, such that the encoder doesn't insert key frames for scene changes. */
+static bool write_test_movie(const std::string &filepath)
+{
+  const AVCodec *codec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+  if (codec == nullptr) {
+    return false;
+  }
+
+  AVFormatContext *format_ctx = nullptr;
+  avformat_alloc_output_context2(&format_ctx, nullptr, "matroska", filepath.c_str());
+  if (format_ctx == nullptr) {
+    return false;
+  }
+  AVStream *stream = avformat_new_stream(format_ctx, nullptr);
+
+  AVCodecContext *codec_ctx = avcodec_alloc_context3(codec);
+  codec_ctx->width = movie_width;
+  codec_ctx->height = movie_height;
+  codec_ctx->time_base = {1, 25};
+  codec_ctx->framerate = {25, 1};
+  codec_ctx->pix_fmt = AV_PIX_FMT_YUV420P;
+  codec_ctx->gop_size = movie_gop_size;
+  codec_ctx->max_b_frames = 0;
+  if (format_ctx->oformat->flags & AVFMT_GLOBALHEADER) {
+    codec_ctx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+  }
+  AVDictionary *options = nullptr;
+  av_dict_set(&options, "sc_threshold", "1000000000", 0);
+  const bool is_open = avcodec_open2(codec_ctx, codec, &options) >= 0;
+  av_dict_free(&options);
+  if (!is_open || avio_open(&format_ctx->pb, filepath.c_str(), AVIO_FLAG_WRITE) < 0) {
+    avcodec_free_context(&codec_ctx);
+    avformat_free_context(format_ctx);
+    return false;
+  }
+  avcodec_parameters_from_context(stream->codecpar, codec_ctx);
+  stream->time_base = codec_ctx->time_base;
+  avformat_write_header(format_ctx, nullptr);
+
+  AVFrame *frame = av_frame_alloc();
+  frame->format = codec_ctx->pix_fmt;
+  frame->width = movie_width;
+  frame->height = movie_height;
+  av_frame_get_buffer(frame, 0);
+  AVPacket *packet = av_packet_alloc();
+
+  for (const int frame_index : IndexRange(movie_frames_num)) {
+    av_frame_make_writable(frame);
+    for (const int y : IndexRange(movie_height)) {
+      for (const int x : IndexRange(movie_width)) {
+        frame->data[0][y * frame->linesize[0] + x] = uint8_t(16 + x * 2 + y + frame_index);
+      }
+    }
+    for (const int y : IndexRange(movie_height / 2)) {
+      std::memset(frame->data[1] + y * frame->linesize[1], 128, movie_width / 2);
+      std::memset(frame->data[2] + y * frame->linesize[2], 128, movie_width / 2);
+    }
+    frame->pts = frame_index;
+    encode_frame(format_ctx, codec_ctx, stream, frame, packet);
+  }
+  encode_frame(format_ctx, codec_ctx, stream, nullptr, packet);
+  av_write_trailer(format_ctx);
+
+  av_packet_free(&packet);
+  av_frame_free(&frame);
+  avcodec_free_context(&codec_ctx);
+  avio_closep(&format_ctx->pb);
+  avformat_free_context(format_ctx);
+  return true;
+}
+
+class MovieReadTest : public testing::Test {
+ protected:
+  std::string filepath;
+
+  static void SetUpTestSuite()
+  {
+    BKE_appdir_init();
+    IMB_init();
+    av_log_set_level(AV_LOG_QUIET);
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+    BKE_appdir_exit();
+  }
+
+  void SetUp() override
+  {
+    BKE_tempdir_init(nullptr);
+    filepath = std::string(BKE_tempdir_session()) + SEP_STR + "gop_cache_test.mkv";
+    if (!write_test_movie(filepath)) {
+      GTEST_SKIP() << "MPEG-4 encoding is not available";
+    }
+  }
+
+  void TearDown() override
+  {
+    BKE_tempdir_session_purge();
+  }
+
+  /* Decode the frame at the given position and return its pixels. */
+  static Array<uchar> decode_frame(MovieReader *anim, const int position)
+  {
+    ImBuf *ibuf = MOV_decode_frame(anim, position, IMB_TC_NONE, IMB_PROXY_NONE);
+    EXPECT_NE(ibuf, nullptr);
+    if (ibuf == nullptr) {
+      return {};
+    }
+    const Array<uchar> pixels(Span(ibuf->byte_buffer.data, int64_t(ibuf->x) * ibuf->y * 4));
+    IMB_freeImBuf(ibuf);
+    return pixels;
+  }
+};
+
+TEST_F(MovieReadTest, GOPCacheBackwardStep)
+{
+  /* Decoding forward doesn't need the cache. */
+  MovieReader *forward_anim = MOV_open_file(filepath.c_str(), IB_byte_data, 0, true, nullptr);
+  Array<Array<uchar>> expected_frames(movie_frames_num);
+  for (const int position : IndexRange(movie_frames_num)) {
+    expected_frames[position] = decode_frame(forward_anim, position);
+  }
+  EXPECT_EQ(forward_anim->gop_cache_hits, 0);
+  MOV_close(forward_anim);
+
+  MovieReader *anim = MOV_open_file(filepath.c_str(), IB_byte_data, 0, true, nullptr);
+  decode_frame(anim, movie_frames_num - 1);
+  for (int position = movie_frames_num - 2; position >= 0; position--) {
+    EXPECT_EQ(decode_frame(anim, position).as_span(), expected_frames[position].as_span())
+        << "at frame " << position;
+  }
+
+  /* The first backward step decodes the last GOP, the frames decoded on the way are cached for
+   * the following steps. The earlier GOPs are decoded ahead of time in the background, or when
+   * they are reached at the latest, so at most one step per GOP misses the cache. */
+  const int steps_num = movie_frames_num - 1;
+  const int gops_num = movie_frames_num / movie_gop_size;
+  EXPECT_GE(anim->gop_cache_hits, steps_num - gops_num);
+  MOV_close(anim);
+}
+
+}  // namespace blender::tests
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "OCIO_baked_lut.hh"
 #include "OCIO_colorspace.hh"
 #include "OCIO_config.hh"
 #include "OCIO_cpu_processor.hh"
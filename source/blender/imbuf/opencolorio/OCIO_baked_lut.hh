@@ -0,0 +1,48 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+namespace blender::ocio {
+
+/**
+ * A 3D lookup table which approximates a transform of scene linear RGB colors, used as a fast path
+ * for applying expensive display transforms on large images on the CPU.
+ *
+ * Colors are first mapped by a logarithmic shaper which gives more resolution to dark colors, and
+ * the table is then sampled using tetrahedral interpolation. Colors outside of the domain of the
+ * shaper, like negative or very bright colors, are not handled by the table and need to be
+ * transformed using the exact transform.
+ */
+class BakedLUT {
+ public:
+  /* Number of samples of the table along each axis. */
+  static constexpr int size = 65;
+  /* Largest value of the domain of the shaper, the smallest value being zero. */
+  static constexpr float max_value = 128.0f;
+
+ private:
+  /* Transformed colors of the samples, padded to four components for SIMD loads. */
+  Array<float4> table_;
+
+ public:
+  /**
+   * Bake the table by evaluating the given transform on the colors of its samples. The transform
+   * modifies the colors in-place, and is called from multiple threads on parts of the samples.
+   */
+  explicit BakedLUT(FunctionRef<void(MutableSpan<float3> colors)> transform);
+
+  /**
+   * Apply the table on the given color in-place. Returns false without modifying the color if it
+   * is outside of the domain of the table.
+   */
+  bool apply_rgb(float rgb[3]) const;
+};
+
+}  // namespace blender::ocio
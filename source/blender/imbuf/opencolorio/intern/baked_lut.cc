@@ -0,0 +1,167 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <array>
+#include <cmath>
+
+#include "BLI_index_range.hh"
+#include "BLI_math_base.hh"
+#include "BLI_simd.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "OCIO_baked_lut.hh"
+
+namespace blender::ocio {
+
+/* The shaper maps values logarithmically, offset such that zero maps to the start of the table. */
+static constexpr float shaper_offset = 1.0f / 1024.0f;
+static const float shaper_log_min = std::log2(shaper_offset);
+static const float shaper_log_max = std::log2(BakedLUT::max_value + shaper_offset);
+
+static float shaper_apply(const float value)
+{
+  return (std::log2(value + shaper_offset) - shaper_log_min) / (shaper_log_max - shaper_log_min);
+}
+
+static float shaper_apply_inverse(const float value)
+{
+  const double log_value = double(value) * (shaper_log_max - shaper_log_min) + shaper_log_min;
+  return float(std::exp2(log_value) - double(shaper_offset));
+}
+
+BakedLUT::BakedLUT(const FunctionRef<void(MutableSpan<float3> colors)> transform)
+    : table_(int64_t(size) * size * size)
+{
+  /* Values of the samples along each axis. */
+  std::array<float, size> values;
+  for (const int i : IndexRange(size)) {
+    values[i] = shaper_apply_inverse(float(i) / (size - 1));
+  }
+
+  threading::parallel_for(IndexRange(size), 4, [&](const IndexRange z_range) {
+    Vector<float3> colors(size * size);
+    for (const int z : z_range) {
+      for (const int y : IndexRange(size)) {
+        for (const int x : IndexRange(size)) {
+          colors[y * size + x] = float3(values[x], values[y], values[z]);
+        }
+      }
+
+      transform(colors);
+
+      float4 *slice = table_.data() + int64_t(z) * size * size;
+      for (const int i : colors.index_range()) {
+        slice[i] = float4(colors[i], 0.0f);
+      }
+    }
+  });
+}
+
+bool BakedLUT::apply_rgb(float rgb[3]) const
+{
+  /* Written such that NaN values are outside of the domain as well. */
+  for (int i = 0; i < 3; i++) {
+    if (!(rgb[i] >= 0.0f && rgb[i] <= max_value)) {
+      return false;
+    }
+  }
+
+  int index[3];
+  float t[3];
+  for (int i = 0; i < 3; i++) {
+    const float coordinate = shaper_apply(rgb[i]) * (size - 1);
+    index[i] = math::clamp(int(coordinate), 0, size - 2);
+    t[i] = math::clamp(coordinate - index[i], 0.0f, 1.0f);
+  }
+
+  /* Tetrahedral interpolation, the unit cube around the color is split into six tetrahedra which
+   * all share the first and last corners of the cube. Find the tetrahedron that contains the
+   * color, its two other corners, and the barycentric weights of its four corners. */
+  constexpr int dx = 1;
+  constexpr int dy = size;
+  constexpr int dz = size * size;
+  int corner_1, corner_2;
+  float weights[4];
+  if (t[0] > t[1]) {
+    if (t[1] > t[2]) {
+      corner_1 = dx;
+      corner_2 = dx + dy;
+      weights[0] = 1.0f - t[0];
+      weights[1] = t[0] - t[1];
+      weights[2] = t[1] - t[2];
+      weights[3] = t[2];
+    }
+    else if (t[0] > t[2]) {
+      corner_1 = dx;
+      corner_2 = dx + dz;
+      weights[0] = 1.0f - t[0];
+      weights[1] = t[0] - t[2];
+      weights[2] = t[2] - t[1];
+      weights[3] = t[1];
+    }
+    else {
+      corner_1 = dz;
+      corner_2 = dx + dz;
+      weights[0] = 1.0f - t[2];
+      weights[1] = t[2] - t[0];
+      weights[2] = t[0] - t[1];
+      weights[3] = t[1];
+    }
+  }
+  else {
+    if (t[2] > t[1]) {
+      corner_1 = dz;
+      corner_2 = dy + dz;
+      weights[0] = 1.0f - t[2];
+      weights[1] = t[2] - t[1];
+      weights[2] = t[1] - t[0];
+      weights[3] = t[0];
+    }
+    else if (t[2] > t[0]) {
+      corner_1 = dy;
+      corner_2 = dy + dz;
+      weights[0] = 1.0f - t[1];
+      weights[1] = t[1] - t[2];
+      weights[2] = t[2] - t[0];
+      weights[3] = t[0];
+    }
+    else {
+      corner_1 = dy;
+      corner_2 = dx + dy;
+      weights[0] = 1.0f - t[1];
+      weights[1] = t[1] - t[0];
+      weights[2] = t[0] - t[2];
+      weights[3] = t[2];
+    }
+  }
+
+  const float *corner_0 = &table_[(int64_t(index[2]) * size + index[1]) * size + index[0]].x;
+  const int corner_3 = dx + dy + dz;
+
+#if BLI_HAVE_SSE2
+  __m128 result = _mm_mul_ps(_mm_set1_ps(weights[0]), _mm_loadu_ps(corner_0));
+  result = _mm_add_ps(result,
+                      _mm_mul_ps(_mm_set1_ps(weights[1]), _mm_loadu_ps(corner_0 + corner_1 * 4)));
+  result = _mm_add_ps(result,
+                      _mm_mul_ps(_mm_set1_ps(weights[2]), _mm_loadu_ps(corner_0 + corner_2 * 4)));
+  result = _mm_add_ps(result,
+                      _mm_mul_ps(_mm_set1_ps(weights[3]), _mm_loadu_ps(corner_0 + corner_3 * 4)));
+
+  float result_rgba[4];
+  _mm_storeu_ps(result_rgba, result);
+  rgb[0] = result_rgba[0];
+  rgb[1] = result_rgba[1];
+  rgb[2] = result_rgba[2];
+#else
+  for (int i = 0; i < 3; i++) {
+    rgb[i] = weights[0] * corner_0[i] + weights[1] * corner_0[corner_1 * 4 + i] +
+             weights[2] * corner_0[corner_2 * 4 + i] + weights[3] * corner_0[corner_3 * 4 + i];
+  }
+#endif
+
+  return true;
+}
+
+}  // namespace blender::ocio
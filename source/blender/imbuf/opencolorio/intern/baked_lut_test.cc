@@ -0,0 +1,160 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cmath>
+#include <memory>
+
+#include "BLI_math_vector.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_rand.hh"
+
+#include "OCIO_baked_lut.hh"
+#include "OCIO_config.hh"
+#include "OCIO_cpu_processor.hh"
+#include "OCIO_role_names.hh"
+
+#include "testing/testing.h"
+
+namespace blender::ocio {
+
+/* A transform resembling a display transform: mix the channels, tone map, and encode. */
+static float3 display_transform(const float3 &color)
+{
+  const float3 mixed = float3(0.8f * color.x + 0.15f * color.y + 0.05f * color.z,
+                              0.1f * color.x + 0.8f * color.y + 0.1f * color.z,
+                              0.05f * color.x + 0.15f * color.y + 0.8f * color.z);
+  float3 result;
+  for (int i = 0; i < 3; i++) {
+    const float tone_mapped = mixed[i] / (mixed[i] + 1.0f);
+    result[i] = (tone_mapped <= 0.0031308f) ? 12.92f * tone_mapped :
+                                              1.055f * std::pow(tone_mapped, 1.0f / 2.4f) - 0.055f;
+  }
+  return result;
+}
+
+static BakedLUT bake_display_transform()
+{
+  return BakedLUT([](MutableSpan<float3> colors) {
+    for (float3 &color : colors) {
+      color = display_transform(color);
+    }
+  });
+}
+
+TEST(ocio_baked_lut, accuracy)
+{
+  const BakedLUT lut = bake_display_transform();
+
+  RandomNumberGenerator rng(42);
+  float max_error = 0.0f;
+  for (int i = 0; i < 100000; i++) {
+    /* Distribute the colors logarithmically, like the shaper. */
+    const float3 color(std::exp2(rng.get_float() * 17.0f - 10.0f),
+                       std::exp2(rng.get_float() * 17.0f - 10.0f),
+                       std::exp2(rng.get_float() * 17.0f - 10.0f));
+
+    float3 result = color;
+    EXPECT_TRUE(lut.apply_rgb(result));
+    const float3 error = math::abs(result - display_transform(color));
+    max_error = math::max(max_error, math::reduce_max(error));
+  }
+
+  /* Less than a quarter of a step of 8-bit display buffers. */
+  EXPECT_LT(max_error, 0.25f / 255.0f);
+}
+
+TEST(ocio_baked_lut, exact_at_boundaries)
+{
+  const BakedLUT lut = bake_display_transform();
+
+  float3 black(0.0f);
+  EXPECT_TRUE(lut.apply_rgb(black));
+  EXPECT_V3_NEAR(black, display_transform(float3(0.0f)), 1e-6f);
+
+  float3 max(BakedLUT::max_value);
+  EXPECT_TRUE(lut.apply_rgb(max));
+  EXPECT_V3_NEAR(max, display_transform(float3(BakedLUT::max_value)), 1e-5f);
+}
+
+TEST(ocio_baked_lut, outside_domain)
+{
+  const BakedLUT lut = bake_display_transform();
+
+  float3 negative(0.5f, -0.1f, 0.5f);
+  EXPECT_FALSE(lut.apply_rgb(negative));
+  EXPECT_EQ(negative, float3(0.5f, -0.1f, 0.5f));
+
+  float3 bright(0.5f, 0.5f, BakedLUT::max_value * 2.0f);
+  EXPECT_FALSE(lut.apply_rgb(bright));
+
+  float3 nan(0.5f, NAN, 0.5f);
+  EXPECT_FALSE(lut.apply_rgb(nan));
+}
+
+/* Bake display transforms of the bundled configuration and compare the table with the exact
+ * OpenColorIO processor at the sample points of the table, between them, and at random colors. */
+TEST(ocio_baked_lut, matches_opencolorio_processor)
+{
+  std::string config_filepath = blender::tests::flags_test_release_dir() +
+                                "/datafiles/colormanagement/config.ocio";
+  BLI_setenv("OCIO", config_filepath.c_str());
+  const std::unique_ptr<Config> config = Config::create_from_environment();
+  BLI_setenv("OCIO", nullptr);
+  if (!config) {
+    GTEST_SKIP() << "OpenColorIO configuration " << config_filepath << " is not available";
+  }
+
+  const struct {
+    const char *view;
+    float scale;
+  } cases[] = {{"Standard", 1.0f}, {"AgX", 1.0f}, {"AgX", 4.0f}};
+  for (const auto &test_case : cases) {
+    DisplayParameters display_parameters;
+    display_parameters.from_colorspace = OCIO_ROLE_SCENE_LINEAR;
+    display_parameters.display = "sRGB";
+    display_parameters.view = test_case.view;
+    display_parameters.scale = test_case.scale;
+    const std::shared_ptr<const CPUProcessor> processor = config->get_display_cpu_processor(
+        display_parameters);
+    ASSERT_NE(processor, nullptr);
+
+    const BakedLUT lut([&](MutableSpan<float3> colors) {
+      for (float3 &color : colors) {
+        processor->apply_rgb(color);
+      }
+    });
+
+    const auto expect_near_processor = [&](const float3 &color) {
+      float3 result = color;
+      EXPECT_TRUE(lut.apply_rgb(result));
+      float3 expected = color;
+      processor->apply_rgb(expected);
+      /* Less than half a step of 8-bit display buffers. */
+      for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(result[i], expected[i], 0.5f / 255.0f)
+            << "view " << test_case.view << " scale " << test_case.scale << " color " << color;
+      }
+    };
+
+    /* Black, white, the primaries, and colors at both ends of the domain. */
+    expect_near_processor(float3(0.0f));
+    expect_near_processor(float3(1.0f));
+    expect_near_processor(float3(1.0f, 0.0f, 0.0f));
+    expect_near_processor(float3(0.0f, 1.0f, 0.0f));
+    expect_near_processor(float3(0.0f, 0.0f, 1.0f));
+    expect_near_processor(float3(0.18f, 0.18f, 0.18f));
+    expect_near_processor(float3(0.001f, 0.002f, 0.0005f));
+    expect_near_processor(float3(BakedLUT::max_value));
+    expect_near_processor(float3(20.0f, 0.5f, 3.0f));
+
+    RandomNumberGenerator rng(7);
+    for (int i = 0; i < 1000; i++) {
+      expect_near_processor(float3(std::exp2(rng.get_float() * 17.0f - 10.0f),
+                                   std::exp2(rng.get_float() * 17.0f - 10.0f),
+                                   std::exp2(rng.get_float() * 17.0f - 10.0f)));
+    }
+  }
+}
+
+}  // namespace blender::ocio
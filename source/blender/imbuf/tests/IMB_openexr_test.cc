@@ -0,0 +1,209 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <OpenEXR/ImfChannelList.h>
+#include <OpenEXR/ImfFrameBuffer.h>
+#include <OpenEXR/ImfHeader.h>
+#include <OpenEXR/ImfTileDescription.h>
+#include <OpenEXR/ImfTiledOutputFile.h>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_index_range.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_tempfile.h"
+
+#include "DNA_scene_types.h"
+
+#include "IMB_imbuf.hh"
+#include "IMB_openexr.hh"
+
+namespace blender::imbuf::tests {
+
+class OpenEXRTest : public ::testing::Test {
+ protected:
+  char filepath[FILE_MAX];
+
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+
+  void SetUp() override
+  {
+    BLI_temp_directory_path_get(filepath, sizeof(filepath));
+    BLI_path_append(filepath, sizeof(filepath), "blender_openexr_region_test.exr");
+  }
+
+  void TearDown() override
+  {
+    BLI_delete(filepath, false, false);
+  }
+};
+
+/* Value of a channel of a pixel, distinct for every level, pixel and channel. */
+static float test_value(const int level, const int x, const int y, const int channel)
+{
+  return float(level * 1000000 + y * 1000 + x) + float(channel) * 0.25f;
+}
+
+/* Only the requested channels of the region are decoded, in the bottom to top row order of Blender
+ * images. */
+TEST_F(OpenEXRTest, read_scanline_region_channel_subset)
+{
+  const int width = 70;
+  const int height = 45;
+  Array<float> pixels(width * height * 3);
+  for (const int y : IndexRange(height)) {
+    for (const int x : IndexRange(width)) {
+      for (const int channel : IndexRange(3)) {
+        pixels[(y * width + x) * 3 + channel] = test_value(0, x, y, channel);
+      }
+    }
+  }
+
+  ExrHandle *write_handle = IMB_exr_get_handle();
+  IMB_exr_add_channels(write_handle, "", "RGB", "", "", 3, 3 * width, pixels.data(), false);
+  const double ppm[2] = {0.0, 0.0};
+  ASSERT_TRUE(IMB_exr_begin_write(
+      write_handle, filepath, width, height, ppm, R_IMF_EXR_CODEC_ZIP, 0, nullptr));
+  IMB_exr_write_channels(write_handle);
+  IMB_exr_close(write_handle);
+
+  ExrHandle *handle = IMB_exr_get_handle();
+  int file_width, file_height;
+  ASSERT_TRUE(IMB_exr_begin_read(handle, filepath, &file_width, &file_height, false));
+  EXPECT_EQ(file_width, width);
+  EXPECT_EQ(file_height, height);
+
+  /* Scan-line files only have the full resolution level. */
+  int num_x_levels, num_y_levels;
+  IMB_exr_get_num_levels(handle, &num_x_levels, &num_y_levels);
+  EXPECT_EQ(num_x_levels, 1);
+  EXPECT_EQ(num_y_levels, 1);
+  int level_width, level_height;
+  EXPECT_TRUE(IMB_exr_get_level_size(handle, 0, 0, &level_width, &level_height));
+  EXPECT_EQ(level_width, width);
+  EXPECT_EQ(level_height, height);
+  EXPECT_FALSE(IMB_exr_get_level_size(handle, 1, 1, &level_width, &level_height));
+
+  /* A region that doesn't start at a chunk boundary, reading only the green and blue channels. */
+  const int region_min[2] = {13, 7};
+  const int region_max[2] = {51, 40};
+  const int region_width = region_max[0] - region_min[0];
+  const int region_height = region_max[1] - region_min[1];
+  Array<float> green(region_width * region_height, -1.0f);
+  Array<float> blue(region_width * region_height, -1.0f);
+  ASSERT_TRUE(IMB_exr_set_channel(handle, "G", 1, region_width, green.data()));
+  ASSERT_TRUE(IMB_exr_set_channel(handle, "B", 1, region_width, blue.data()));
+  ASSERT_TRUE(IMB_exr_read_channels_region(handle, region_min, region_max));
+
+  for (const int y : IndexRange(region_height)) {
+    for (const int x : IndexRange(region_width)) {
+      const int i = y * region_width + x;
+      EXPECT_EQ(green[i], test_value(0, region_min[0] + x, region_min[1] + y, 1));
+      EXPECT_EQ(blue[i], test_value(0, region_min[0] + x, region_min[1] + y, 2));
+    }
+  }
+
+  /* Regions outside of the image and levels that don't exist are rejected. */
+  const int outside_max[2] = {width + 1, height};
+  EXPECT_FALSE(IMB_exr_read_channels_region(handle, region_min, outside_max));
+  const int empty_max[2] = {region_min[0], region_max[1]};
+  EXPECT_FALSE(IMB_exr_read_channels_region(handle, region_min, empty_max));
+  EXPECT_FALSE(IMB_exr_read_channels_region(handle, region_min, region_max, 1, 1));
+
+  IMB_exr_close(handle);
+}
+
+/* Blender doesn't write tiled files, so write one with mip-maps using OpenEXR directly. */
+TEST_F(OpenEXRTest, read_tiled_mipmap_level_region)
+{
+  const int width = 100;
+  const int height = 60;
+  {
+    Imf::Header header(width, height);
+    header.channels().insert("Y", Imf::Channel(Imf::FLOAT));
+    header.setTileDescription(Imf::TileDescription(16, 16, Imf::MIPMAP_LEVELS, Imf::ROUND_DOWN));
+    Imf::TiledOutputFile file(filepath, header);
+    for (const int level : IndexRange(file.numLevels())) {
+      const int level_width = file.levelWidth(level);
+      const int level_height = file.levelHeight(level);
+      /* Rows of OpenEXR files go from top to bottom. */
+      Array<float> pixels(level_width * level_height);
+      for (const int y : IndexRange(level_height)) {
+        for (const int x : IndexRange(level_width)) {
+          pixels[y * level_width + x] = test_value(level, x, level_height - 1 - y, 0);
+        }
+      }
+      Imf::FrameBuffer frame_buffer;
+      frame_buffer.insert("Y",
+                          Imf::Slice(Imf::FLOAT,
+                                     reinterpret_cast<char *>(pixels.data()),
+                                     sizeof(float),
+                                     sizeof(float) * level_width));
+      file.setFrameBuffer(frame_buffer);
+      file.writeTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level);
+    }
+  }
+
+  ExrHandle *handle = IMB_exr_get_handle();
+  int file_width, file_height;
+  ASSERT_TRUE(IMB_exr_begin_read(handle, filepath, &file_width, &file_height, false));
+
+  /* Levels down to a single pixel: 100x60, 50x30, 25x15, 12x7, 6x3, 3x1 and 1x1. */
+  int num_x_levels, num_y_levels;
+  IMB_exr_get_num_levels(handle, &num_x_levels, &num_y_levels);
+  EXPECT_EQ(num_x_levels, 7);
+  EXPECT_EQ(num_y_levels, 7);
+  int level_width, level_height;
+  EXPECT_TRUE(IMB_exr_get_level_size(handle, 2, 2, &level_width, &level_height));
+  EXPECT_EQ(level_width, 25);
+  EXPECT_EQ(level_height, 15);
+  /* Mip-maps only have levels that are reduced equally in both directions. */
+  EXPECT_FALSE(IMB_exr_get_level_size(handle, 1, 2, &level_width, &level_height));
+
+  /* Regions spanning several tiles of the full resolution level and a single tile of a reduced
+   * level. */
+  const struct {
+    int level;
+    int region_min[2];
+    int region_max[2];
+  } cases[] = {{0, {10, 5}, {90, 50}}, {1, {3, 4}, {41, 29}}, {2, {0, 0}, {25, 15}}};
+  for (const auto &test_case : cases) {
+    const int region_width = test_case.region_max[0] - test_case.region_min[0];
+    const int region_height = test_case.region_max[1] - test_case.region_min[1];
+    Array<float> luminance(region_width * region_height, -1.0f);
+    ASSERT_TRUE(IMB_exr_set_channel(handle, "Y", 1, region_width, luminance.data()));
+    ASSERT_TRUE(IMB_exr_read_channels_region(
+        handle, test_case.region_min, test_case.region_max, test_case.level, test_case.level));
+
+    for (const int y : IndexRange(region_height)) {
+      for (const int x : IndexRange(region_width)) {
+        EXPECT_EQ(luminance[y * region_width + x],
+                  test_value(test_case.level,
+                             test_case.region_min[0] + x,
+                             test_case.region_min[1] + y,
+                             0))
+            << "at level " << test_case.level << " pixel " << x << ", " << y;
+      }
+    }
+  }
+
+  /* The region must fit into the requested level. */
+  const int region_min[2] = {0, 0};
+  const int region_max[2] = {26, 15};
+  EXPECT_FALSE(IMB_exr_read_channels_region(handle, region_min, region_max, 2, 2));
+
+  IMB_exr_close(handle);
+}
+
+}  // namespace blender::imbuf::tests
@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_fileops.h"
+#include "BLI_index_range.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_tempfile.h"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+namespace blender::imbuf::tests {
+
+class PNGTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+};
+
+/* Large images are compressed on multiple threads, the file must still read back exactly. */
+TEST_F(PNGTest, roundtrip_large_image)
+{
+  /* More than a megabyte of image data, and rows that don't evenly divide the groups of rows
+   * that are compressed by each thread. */
+  const int width = 1000;
+  const int height = 523;
+  ImBuf *ibuf = IMB_allocImBuf(width, height, 32, IB_byte_data);
+  ibuf->ftype = IMB_FTYPE_PNG;
+  ibuf->foptions.compress = 90;
+  uchar *pixels = ibuf->byte_buffer.data;
+  uint32_t state = 1;
+  for (const int64_t i : IndexRange(int64_t(width) * height * 4)) {
+    /* Gradients with some noise, which compress well but not to almost nothing. */
+    state = state * 1664525u + 1013904223u;
+    pixels[i] = uchar((i / 4) % width + (i % 4) * 40 + ((state >> 28) & 3));
+  }
+
+  char filepath[FILE_MAX];
+  BLI_temp_directory_path_get(filepath, sizeof(filepath));
+  BLI_path_append(filepath, sizeof(filepath), "blender_png_roundtrip_test.png");
+
+  ASSERT_TRUE(IMB_save_image(ibuf, filepath, IB_byte_data));
+  /* The image data is compressed. */
+  EXPECT_LT(BLI_file_size(filepath), size_t(width) * height * 4);
+
+  ImBuf *loaded = IMB_load_image_from_filepath(filepath, IB_byte_data);
+  BLI_delete(filepath, false, false);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->x, width);
+  ASSERT_EQ(loaded->y, height);
+  EXPECT_EQ(memcmp(loaded->byte_buffer.data, pixels, size_t(width) * height * 4), 0);
+
+  IMB_freeImBuf(loaded);
+  IMB_freeImBuf(ibuf);
+}
+
+}  // namespace blender::imbuf::tests
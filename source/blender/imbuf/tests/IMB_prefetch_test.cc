@@ -0,0 +1,113 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "BLI_fileops.h"
+#include "BLI_index_range.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_string.h"
+#include "BLI_tempfile.h"
+
+#include "IMB_colormanagement.hh"
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "intern/IMB_prefetch_intern.hh"
+
+namespace blender::imbuf::tests {
+
+static constexpr int image_width = 64;
+static constexpr int image_height = 32;
+
+class PrefetchTest : public ::testing::Test {
+ protected:
+  char filepath[FILE_MAX];
+  char colorspace[IM_MAX_SPACE];
+
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+
+  void SetUp() override
+  {
+    STRNCPY(colorspace, IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DEFAULT_BYTE));
+
+    BLI_temp_directory_path_get(filepath, sizeof(filepath));
+    BLI_path_append(filepath, sizeof(filepath), "blender_prefetch_test.png");
+
+    ImBuf *ibuf = IMB_allocImBuf(image_width, image_height, 32, IB_byte_data);
+    ibuf->ftype = IMB_FTYPE_PNG;
+    for (const int64_t i : IndexRange(int64_t(image_width) * image_height * 4)) {
+      ibuf->byte_buffer.data[i] = uchar(i * 7);
+    }
+    ASSERT_TRUE(IMB_save_image(ibuf, filepath, IB_byte_data));
+    IMB_freeImBuf(ibuf);
+  }
+
+  void TearDown() override
+  {
+    BLI_delete(filepath, false, false);
+  }
+
+  void expect_test_pixels(const ImBuf *ibuf)
+  {
+    ASSERT_NE(ibuf, nullptr);
+    ASSERT_EQ(ibuf->x, image_width);
+    ASSERT_EQ(ibuf->y, image_height);
+    for (const int64_t i : IndexRange(int64_t(image_width) * image_height * 4)) {
+      ASSERT_EQ(ibuf->byte_buffer.data[i], uchar(i * 7)) << "at byte " << i;
+    }
+  }
+};
+
+/* Images are prefetched with the load flags of the image editor and of the sequencer, which
+ * include the multi-layer flags even for files that are not OpenEXR files. */
+TEST_F(PrefetchTest, load_takes_prefetched_image)
+{
+  const int flags_list[] = {
+      IB_byte_data,
+      IB_byte_data | IB_multilayer | IB_metadata,
+      IB_byte_data | IB_multilayer | IB_multilayer_combined_only | IB_metadata,
+  };
+  for (const int flags : flags_list) {
+    /* The image is prefetched. */
+    IMB_prefetch_image_from_filepath(filepath, flags, colorspace);
+    ImBuf *prefetched = imb_prefetch_take(filepath, flags, colorspace);
+    this->expect_test_pixels(prefetched);
+    IMB_freeImBuf(prefetched);
+    EXPECT_EQ(imb_prefetch_take(filepath, flags, colorspace), nullptr);
+
+    /* Loading the image takes the prefetched image, so it is not left in the prefetch cache. */
+    IMB_prefetch_image_from_filepath(filepath, flags, colorspace);
+    ImBuf *loaded = IMB_load_image_from_filepath(filepath, flags, colorspace);
+    this->expect_test_pixels(loaded);
+    IMB_freeImBuf(loaded);
+    EXPECT_EQ(imb_prefetch_take(filepath, flags, colorspace), nullptr);
+  }
+}
+
+/* Images are only taken by loads with the same flags and color space. */
+TEST_F(PrefetchTest, load_with_other_arguments)
+{
+  IMB_prefetch_image_from_filepath(filepath, IB_byte_data, colorspace);
+
+  ImBuf *loaded = IMB_load_image_from_filepath(filepath, IB_byte_data | IB_metadata, colorspace);
+  this->expect_test_pixels(loaded);
+  IMB_freeImBuf(loaded);
+
+  ImBuf *prefetched = imb_prefetch_take(filepath, IB_byte_data, colorspace);
+  this->expect_test_pixels(prefetched);
+  IMB_freeImBuf(prefetched);
+}
+
+}  // namespace blender::imbuf::tests
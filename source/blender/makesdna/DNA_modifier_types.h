@@ -1222,6 +1222,7 @@ enum MultiresModifierFlag {
   eMultiresModifierFlag_UseCrease = (1 << 2),
   eMultiresModifierFlag_UseCustomNormals = (1 << 3),
   eMultiresModifierFlag_UseSculptBaseMesh = (1 << 4),
+  eMultiresModifierFlag_UseHalfPrecisionReshape = (1 << 5),
 };
 
 struct MultiresModifierData {
@@ -818,7 +818,8 @@ struct UserDef_Experimental {
   char use_geometry_nodes_lists = 0;
   char use_geometry_bundle = 0;
   char use_remote_asset_libraries = 0;
-  char _pad[3] = {};
+  char use_display_transform_lut = 0;
+  char _pad[2] = {};
 };
 
 #define USER_EXPERIMENTAL_TEST(userdef, member) (((userdef)->experimental).member)
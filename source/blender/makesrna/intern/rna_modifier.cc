@@ -2837,6 +2837,17 @@ static void rna_def_modifier_multires(BlenderRNA *brna)
                            "displacement of higher subdivision levels");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_half_precision_reshape", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "flags", eMultiresModifierFlag_UseHalfPrecisionReshape);
+  RNA_def_property_ui_text(prop,
+                           "Half Precision Reshape",
+                           "While applying sculpt changes or changing subdivision levels, keep "
+                           "the temporary copy of the original displacement in half precision. "
+                           "This lowers the peak memory usage of these operations at the cost of "
+                           "precision. The stored displacement keeps full precision");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   RNA_define_lib_overridable(false);
 }
 
@@ -7565,6 +7565,12 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Remote Asset Libraries", "Enable asset libraries served over HTTP/HTTPS");
 
+  prop = RNA_def_property(srna, "use_display_transform_lut", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Baked Display Transform",
+                           "Convert large images to display buffers on the CPU using a baked "
+                           "lookup table, which is faster but approximates the view transform");
+
   prop = RNA_def_property(srna, "use_extensions_debug", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
@@ -428,6 +428,7 @@ static void advanced_panel_draw(const bContext * /*C*/, Panel *panel)
 
   layout.prop(ptr, "use_creases", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   layout.prop(ptr, "use_custom_normals", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+  layout.prop(ptr, "use_half_precision_reshape", UI_ITEM_NONE, std::nullopt, ICON_NONE);
 }
 
 static void panel_register(ARegionType *region_type)
@@ -298,15 +298,39 @@ static bool is_disabled(const Scene * /*scene*/, ModifierData *md, bool /*use_re
   return false;
 }
 
-static bool logging_enabled(const ModifierEvalContext *ctx)
+/**
+ * How much of the evaluation is logged. The log is only used to display information in the user
+ * interface, so logging is reduced when nobody can look at it. Logging socket values is the most
+ * expensive part, especially in repeat zones with many iterations.
+ */
+enum class NodesLogMode {
+  /** Nothing is logged, e.g. for final renders. */
+  None,
+  /** Warnings and other node information are logged, but no socket values. */
+  NoSocketValues,
+  /** Socket values are only logged in compute contexts that are shown in a node editor. */
+  VisibleSocketValues,
+  /** Socket values are logged in all compute contexts. Only meant for debugging and benchmarks. */
+  AllSocketValues,
+};
+
+static NodesLogMode get_log_mode(const ModifierEvalContext *ctx)
 {
   if (!DEG_is_active(ctx->depsgraph)) {
-    return false;
+    return NodesLogMode::None;
   }
   if ((ctx->flag & MOD_APPLY_ORCO) != 0) {
-    return false;
+    return NodesLogMode::None;
   }
-  return true;
+  if (G.debug_value == 4002) {
+    return NodesLogMode::AllSocketValues;
+  }
+  if (G.background) {
+    /* Node editors stored in the file can't be looked at, but warnings are still accessible from
+     * Python. */
+    return NodesLogMode::NoSocketValues;
+  }
+  return NodesLogMode::VisibleSocketValues;
 }
 
 static void update_id_properties_from_node_group(NodesModifierData *nmd)
@@ -1893,11 +1917,16 @@ static void modifyGeometry(ModifierData *md,
   call_data.bake_params = &bake_params;
 
   Set<ComputeContextHash> socket_log_contexts;
-  if (logging_enabled(ctx)) {
+  const NodesLogMode log_mode = get_log_mode(ctx);
+  if (log_mode != NodesLogMode::None) {
     call_data.eval_log = eval_log.get();
 
-    find_socket_log_contexts(*nmd, *ctx, socket_log_contexts);
-    call_data.socket_log_contexts = &socket_log_contexts;
+    if (log_mode == NodesLogMode::VisibleSocketValues) {
+      find_socket_log_contexts(*nmd, *ctx, socket_log_contexts);
+    }
+    if (log_mode != NodesLogMode::AllSocketValues) {
+      call_data.socket_log_contexts = &socket_log_contexts;
+    }
   }
 
   nodes::GeoNodesSideEffectNodes side_effect_nodes;
@@ -1913,7 +1942,7 @@ static void modifyGeometry(ModifierData *md,
                                                            call_data,
                                                            std::move(geometry_set));
 
-  if (logging_enabled(ctx)) {
+  if (log_mode != NodesLogMode::None) {
     nmd_orig->runtime->eval_log = std::move(eval_log);
   }
 
@@ -46,6 +46,13 @@ struct GeometryNodesEvalDependencies {
   bool needs_active_camera = false;
   bool needs_scene_render_params = false;
   bool time_dependent = false;
+  /**
+   * The result depends on the context of the evaluation beyond the dependencies above (e.g.
+   * whether it is evaluated in the viewport or which tool is used), or the evaluation has side
+   * effects like logging warnings or gizmos. Results of such node trees must not be reused for
+   * other evaluations.
+   */
+  bool context_dependent = false;
 
   /**
    * Adds a generic data-block dependency. Note that this does not add a dependency to e.g. the
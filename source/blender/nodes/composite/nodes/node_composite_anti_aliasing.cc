@@ -48,6 +48,11 @@ class AntiAliasingOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     smaa(this->context(),
@@ -43,6 +43,11 @@ class BilateralBlurOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     const Result &input_image = this->get_input("Image");
@@ -101,6 +101,11 @@ class BlurOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     const Result &input = this->get_input("Image");
@@ -55,6 +55,11 @@ class DespeckleOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     const Result &input = this->get_input("Image");
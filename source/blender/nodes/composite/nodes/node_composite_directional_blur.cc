@@ -67,6 +67,11 @@ class DirectionalBlurOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     if (this->is_identity()) {
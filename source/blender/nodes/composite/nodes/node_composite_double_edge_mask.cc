@@ -42,6 +42,11 @@ class DoubleEdgeMaskOperation : public NodeOperation {
  public:
   using NodeOperation::NodeOperation;
 
+  bool are_results_cacheable() const override
+  {
+    return true;
+  }
+
   void execute() override
   {
     Result &inner_mask = get_input("Inner Mask");
@@ -567,6 +567,7 @@ static void node_register()
   ntype.blend_write_storage_content = node_blend_write;
   ntype.blend_data_read_storage_content = node_blend_read;
   bke::node_type_storage(ntype, "NodeGeometryBake", node_free_storage, node_copy_storage);
+  ntype.depends_on_evaluation_context = true;
   bke::node_register_type(ntype);
 }
 NOD_REGISTER_NODE(node_register)
@@ -62,6 +62,7 @@ static void node_register()
   ntype.declare = node_declare;
   ntype.draw_buttons = node_layout;
   ntype.initfunc = node_init;
+  ntype.depends_on_evaluation_context = true;
   bke::node_register_type(ntype);
 
   node_rna(ntype.rna_ext.srna);
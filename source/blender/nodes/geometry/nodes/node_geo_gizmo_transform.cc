@@ -75,6 +75,7 @@ static void node_register()
   ntype.declare = node_declare;
   ntype.draw_buttons_ex = node_layout_ex;
   ntype.initfunc = node_init;
+  ntype.depends_on_evaluation_context = true;
   bke::node_register_type(ntype);
 }
 NOD_REGISTER_NODE(node_register)
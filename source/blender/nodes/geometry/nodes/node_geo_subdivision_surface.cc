@@ -2,8 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <xxhash.h>
+
 #include "DNA_modifier_types.h"
 
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_mutex.hh"
+
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
@@ -102,6 +108,143 @@ static fn::Field<float> clamp_crease(fn::Field<float> crease_field)
   return fn::Field<float>(fn::FieldOperation::from(clamp_fn, {std::move(crease_field)}));
 }
 
+/**
+ * Identifies a subdivision surface descriptor in the global memory cache. The topology refiner
+ * and the evaluator with its patch and stencil tables only depend on the settings and on the
+ * topology of the mesh, so they can be reused when only positions change, e.g. when subdividing
+ * a deforming character.
+ */
+class SubdivCacheKey : public GenericKey {
+ public:
+  bke::subdiv::Settings settings;
+  uint64_t topology_hash;
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(this->topology_hash,
+                            this->settings.is_adaptive,
+                            this->settings.level,
+                            this->settings.use_creases,
+                            int(this->settings.vtx_boundary_interpolation),
+                            int(this->settings.fvar_linear_interpolation));
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const SubdivCacheKey *>(&other)) {
+      return this->topology_hash == other_typed->topology_hash &&
+             this->settings.use_creases == other_typed->settings.use_creases &&
+             bke::subdiv::settings_equal(&this->settings, &other_typed->settings);
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<SubdivCacheKey>(*this);
+  }
+};
+
+class SubdivCacheValue : public memory_cache::CachedValue {
+ public:
+  /** The evaluator stores the coarse positions, so only one evaluation can use it at a time. */
+  mutable Mutex mutex;
+  mutable bke::subdiv::Subdiv *subdiv = nullptr;
+  /** Rough estimate of the memory used by the refiner and the evaluator. */
+  int64_t estimated_bytes = 0;
+
+  ~SubdivCacheValue() override
+  {
+    if (this->subdiv) {
+      bke::subdiv::free(this->subdiv);
+    }
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    memory.add(this->estimated_bytes);
+  }
+};
+
+/**
+ * Hash of everything the topology refiner is built from except for face-varying data. Hash
+ * collisions and changed UV maps are still detected by #bke::subdiv::update_from_mesh, which
+ * compares the full topology.
+ */
+static uint64_t mesh_topology_hash(const Mesh &mesh, const bool use_creases)
+{
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  BLI_SCOPED_DEFER([&]() { XXH3_freeState(state); });
+
+  const auto add_span = [&](const auto span) {
+    XXH3_64bits_update(state, span.data(), span.size_in_bytes());
+  };
+  XXH3_64bits_update(state, &mesh.verts_num, sizeof(mesh.verts_num));
+  add_span(mesh.edges());
+  add_span(mesh.face_offsets());
+  add_span(mesh.corner_verts());
+
+  if (use_creases) {
+    const bke::AttributeAccessor attributes = mesh.attributes();
+    for (const auto &[name, domain] : {std::pair("crease_vert", AttrDomain::Point),
+                                       std::pair("crease_edge", AttrDomain::Edge)})
+    {
+      if (const VArray<float> creases = *attributes.lookup<float>(name, domain)) {
+        const VArraySpan<float> creases_span(creases);
+        add_span(Span<float>(creases_span));
+      }
+    }
+  }
+  return XXH3_64bits_digest(state);
+}
+
+/**
+ * Subdivide the mesh with a subdivision surface descriptor that is reused across evaluations
+ * when the topology and settings did not change. Then only the coarse positions have to be
+ * refreshed and the limit surface evaluated, which happens in parallel.
+ */
+static Mesh *subdiv_to_mesh_cached(const bke::subdiv::Settings &subdiv_settings,
+                                   const bke::subdiv::ToMeshSettings &mesh_settings,
+                                   const Mesh &mesh)
+{
+  if (mesh.verts_num == 0) {
+    return nullptr;
+  }
+
+  SubdivCacheKey key;
+  key.settings = subdiv_settings;
+  key.topology_hash = mesh_topology_hash(mesh, subdiv_settings.use_creases);
+  const std::shared_ptr<const SubdivCacheValue> value = memory_cache::get<SubdivCacheValue>(
+      key, [&]() {
+        auto new_value = std::make_unique<SubdivCacheValue>();
+        /* Every subdivision level quadruples the number of refined faces and vertices. */
+        new_value->estimated_bytes = int64_t(mesh.corners_num) *
+                                     (int64_t(1) << (2 * subdiv_settings.level)) * 64;
+        return new_value;
+      });
+
+  std::unique_lock lock(value->mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    /* Another evaluation with the same topology is using the cached descriptor. Don't wait for
+     * it, both evaluations are multi-threaded internally and waiting could deadlock when this
+     * thread is used to execute a task of the other evaluation. */
+    bke::subdiv::Subdiv *subdiv = bke::subdiv::new_from_mesh(&subdiv_settings, &mesh);
+    if (!subdiv) {
+      return nullptr;
+    }
+    Mesh *result = bke::subdiv::subdiv_to_mesh(subdiv, &mesh_settings, &mesh);
+    bke::subdiv::free(subdiv);
+    return result;
+  }
+
+  value->subdiv = bke::subdiv::update_from_mesh(value->subdiv, &subdiv_settings, &mesh);
+  if (!value->subdiv) {
+    return nullptr;
+  }
+  return bke::subdiv::subdiv_to_mesh(value->subdiv, &mesh_settings, &mesh);
+}
+
 static Mesh *mesh_subsurf_calc(const Mesh *mesh,
                                const int level,
                                const int quality,
@@ -151,13 +294,7 @@ static Mesh *mesh_subsurf_calc(const Mesh *mesh,
   subdiv_settings.fvar_linear_interpolation = bke::subdiv::fvar_interpolation_from_uv_smooth(
       uv_smooth);
 
-  bke::subdiv::Subdiv *subdiv = bke::subdiv::new_from_mesh(&subdiv_settings, mesh);
-  if (!subdiv) {
-    return nullptr;
-  }
-
-  Mesh *result = bke::subdiv::subdiv_to_mesh(subdiv, &mesh_settings, mesh);
-  bke::subdiv::free(subdiv);
+  Mesh *result = subdiv_to_mesh_cached(subdiv_settings, mesh_settings, *mesh);
 
   if (use_creases && result) {
     /* Remove the layer in case it was created by the node from the field input. The fact
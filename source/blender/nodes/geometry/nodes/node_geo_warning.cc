@@ -113,6 +113,7 @@ static void node_register()
   ntype.declare = node_declare;
   ntype.labelfunc = node_label;
   ntype.draw_buttons = node_layout;
+  ntype.depends_on_evaluation_context = true;
   bke::node_register_type(ntype);
 
   node_rna(ntype.rna_ext.srna);
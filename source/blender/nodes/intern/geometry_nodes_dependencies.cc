@@ -62,6 +62,7 @@ void GeometryNodesEvalDependencies::merge(const GeometryNodesEvalDependencies &o
   this->needs_active_camera |= other.needs_active_camera;
   this->needs_scene_render_params |= other.needs_scene_render_params;
   this->time_dependent |= other.time_dependent;
+  this->context_dependent |= other.context_dependent;
 }
 
 static void add_eval_dependencies_from_socket(const bNodeSocket &socket,
@@ -197,6 +198,19 @@ static void add_own_transform_dependencies(const bNodeTree &tree,
   deps.needs_own_transform |= needs_own_transform;
 }
 
+static bool is_context_dependent(const bNodeTree &ntree)
+{
+  for (const bNode *node : ntree.all_nodes()) {
+    if (node->is_muted()) {
+      continue;
+    }
+    if (node->typeinfo->depends_on_evaluation_context) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static bool needs_scene_render_params(const bNodeTree &ntree)
 {
   for (const bNode *node : ntree.nodes_by_type("GeometryNodeCameraInfo")) {
@@ -224,6 +238,7 @@ static void gather_geometry_nodes_eval_dependencies(
   deps.needs_scene_render_params |= needs_scene_render_params(ntree);
   deps.time_dependent |= has_enabled_nodes_of_type(ntree, "GeometryNodeSimulationInput") ||
                          has_enabled_nodes_of_type(ntree, "GeometryNodeInputSceneTime");
+  deps.context_dependent |= is_context_dependent(ntree);
 
   add_eval_dependencies_from_node_data(ntree, deps);
   add_own_transform_dependencies(ntree, deps);
@@ -0,0 +1,208 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+
+#include "BKE_appdir.hh"
+#include "BKE_compute_contexts.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_global.hh"
+#include "BKE_idprop.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_material.hh"
+#include "BKE_mesh.hh"
+#include "BKE_node.hh"
+#include "BKE_node_runtime.hh"
+#include "BKE_node_tree_update.hh"
+
+#include "BLI_memory_cache.hh"
+
+#include "IMB_imbuf.hh"
+
+#include "RNA_define.hh"
+
+#include "NOD_geometry_nodes_execute.hh"
+#include "NOD_geometry_nodes_lazy_function.hh"
+
+namespace blender::nodes::tests {
+
+class GroupOutputCacheTest : public ::testing::Test {
+ protected:
+  Main *bmain = nullptr;
+  /** Group with a "Count" input that creates a mesh line with that many vertices. */
+  bNodeTree *inner_tree = nullptr;
+  bNode *line_node = nullptr;
+  /** Tree that passes its own "Count" input to a node using the inner group. */
+  bNodeTree *outer_tree = nullptr;
+  bNode *group_node = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+    RNA_init();
+    bke::node_system_init();
+    BKE_appdir_init();
+    IMB_init();
+    BKE_materials_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    BKE_materials_exit();
+    bke::node_system_exit();
+    RNA_exit();
+    BKE_appdir_exit();
+    IMB_exit();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    G.main = bmain;
+    memory_cache::clear();
+
+    inner_tree = bke::node_tree_add_tree(bmain, "Inner", "GeometryNodeTree");
+    bNode *inner_input = bke::node_add_node(nullptr, *inner_tree, "NodeGroupInput");
+    bNode *inner_output = bke::node_add_node(nullptr, *inner_tree, "NodeGroupOutput");
+    line_node = bke::node_add_node(nullptr, *inner_tree, "GeometryNodeMeshLine");
+    const bNodeTreeInterfaceSocket *inner_count = inner_tree->tree_interface.add_socket(
+        "Count", "", "NodeSocketInt", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+    const bNodeTreeInterfaceSocket *inner_geometry = inner_tree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+
+    outer_tree = bke::node_tree_add_tree(bmain, "Outer", "GeometryNodeTree");
+    bNode *outer_input = bke::node_add_node(nullptr, *outer_tree, "NodeGroupInput");
+    bNode *outer_output = bke::node_add_node(nullptr, *outer_tree, "NodeGroupOutput");
+    group_node = bke::node_add_node(nullptr, *outer_tree, "GeometryNodeGroup");
+    group_node->id = &inner_tree->id;
+    id_us_plus(&inner_tree->id);
+    const bNodeTreeInterfaceSocket *outer_count = outer_tree->tree_interface.add_socket(
+        "Count", "", "NodeSocketInt", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+    const bNodeTreeInterfaceSocket *outer_geometry = outer_tree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+    BKE_ntree_update_tag_node_property(outer_tree, group_node);
+    BKE_main_ensure_invariants(*bmain);
+
+    bke::node_add_link(*inner_tree,
+                       *inner_input,
+                       *bke::node_find_socket(*inner_input, SOCK_OUT, inner_count->identifier),
+                       *line_node,
+                       *bke::node_find_socket(*line_node, SOCK_IN, "Count"));
+    bke::node_add_link(*inner_tree,
+                       *line_node,
+                       *bke::node_find_socket(*line_node, SOCK_OUT, "Mesh"),
+                       *inner_output,
+                       *bke::node_find_socket(*inner_output, SOCK_IN, inner_geometry->identifier));
+    bke::node_add_link(*outer_tree,
+                       *outer_input,
+                       *bke::node_find_socket(*outer_input, SOCK_OUT, outer_count->identifier),
+                       *group_node,
+                       *bke::node_find_socket(*group_node, SOCK_IN, inner_count->identifier));
+    bke::node_add_link(*outer_tree,
+                       *group_node,
+                       *bke::node_find_socket(*group_node, SOCK_OUT, inner_geometry->identifier),
+                       *outer_output,
+                       *bke::node_find_socket(*outer_output, SOCK_IN, outer_geometry->identifier));
+    BKE_main_ensure_invariants(*bmain);
+  }
+
+  void TearDown() override
+  {
+    memory_cache::clear();
+    BKE_main_free(bmain);
+    G.main = nullptr;
+  }
+
+  /** Evaluate the outer tree like a final render, where the group outputs may be cached. */
+  bke::GeometrySet evaluate(const int count)
+  {
+    outer_tree->ensure_interface_cache();
+    auto properties = bke::idprop::create_group("Properties");
+    IDP_AddToGroup(
+        properties.get(),
+        bke::idprop::create(outer_tree->interface_inputs()[0]->identifier, count).release());
+
+    GeoNodesModifierData modifier_data;
+    GeoNodesCallData call_data;
+    call_data.modifier_data = &modifier_data;
+    const bke::ModifierComputeContext compute_context{nullptr, 1};
+    return execute_geometry_nodes_on_geometry(
+        *outer_tree, properties.get(), compute_context, call_data, {});
+  }
+};
+
+TEST_F(GroupOutputCacheTest, ReuseOutputsForSameInputs)
+{
+  const bke::GeometrySet first = this->evaluate(4);
+  const bke::GeometrySet second = this->evaluate(4);
+  ASSERT_NE(first.get_mesh(), nullptr);
+  EXPECT_EQ(first.get_mesh()->verts_num, 4);
+  /* The cached mesh is shared instead of being generated again. */
+  EXPECT_EQ(first.get_mesh(), second.get_mesh());
+}
+
+TEST_F(GroupOutputCacheTest, InvalidateOnInputChange)
+{
+  const bke::GeometrySet first = this->evaluate(4);
+  const bke::GeometrySet second = this->evaluate(7);
+  ASSERT_NE(second.get_mesh(), nullptr);
+  EXPECT_NE(first.get_mesh(), second.get_mesh());
+  EXPECT_EQ(second.get_mesh()->verts_num, 7);
+
+  /* Outputs for the old input values are still cached. */
+  const bke::GeometrySet third = this->evaluate(4);
+  EXPECT_EQ(first.get_mesh(), third.get_mesh());
+}
+
+TEST_F(GroupOutputCacheTest, InvalidateOnGroupChange)
+{
+  const bke::GeometrySet first = this->evaluate(4);
+  ASSERT_NE(first.get_mesh(), nullptr);
+  EXPECT_FLOAT_EQ(first.get_mesh()->vert_positions()[1].z, 1.0f);
+
+  bNodeSocket *offset_socket = bke::node_find_socket(*line_node, SOCK_IN, "Offset");
+  offset_socket->default_value_typed<bNodeSocketValueVector>()->value[2] = 2.0f;
+  BKE_ntree_update_tag_socket_property(inner_tree, offset_socket);
+  BKE_main_ensure_invariants(*bmain);
+
+  const bke::GeometrySet second = this->evaluate(4);
+  ASSERT_NE(second.get_mesh(), nullptr);
+  EXPECT_NE(first.get_mesh(), second.get_mesh());
+  EXPECT_FLOAT_EQ(second.get_mesh()->vert_positions()[1].z, 2.0f);
+}
+
+TEST_F(GroupOutputCacheTest, NoCacheForFieldInputs)
+{
+  /* Add an unused input to the group and pass a field to it. */
+  const bNodeTreeInterfaceSocket *inner_value = inner_tree->tree_interface.add_socket(
+      "Value", "", "NodeSocketFloat", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+  BKE_ntree_update_tag_node_property(outer_tree, group_node);
+  BKE_main_ensure_invariants(*bmain);
+  bNode *index_node = bke::node_add_node(nullptr, *outer_tree, "GeometryNodeInputIndex");
+  bke::node_add_link(*outer_tree,
+                     *index_node,
+                     *bke::node_find_socket(*index_node, SOCK_OUT, "Index"),
+                     *group_node,
+                     *bke::node_find_socket(*group_node, SOCK_IN, inner_value->identifier));
+  BKE_main_ensure_invariants(*bmain);
+
+  const bke::GeometrySet first = this->evaluate(4);
+  const bke::GeometrySet second = this->evaluate(4);
+  ASSERT_NE(first.get_mesh(), nullptr);
+  ASSERT_NE(second.get_mesh(), nullptr);
+  EXPECT_EQ(second.get_mesh()->verts_num, 4);
+  /* The outputs are computed again, because fields can't be used to look up cached outputs. */
+  EXPECT_NE(first.get_mesh(), second.get_mesh());
+}
+
+}  // namespace blender::nodes::tests
@@ -24,6 +24,7 @@
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_bundle.hh"
 #include "NOD_geometry_nodes_closure.hh"
+#include "NOD_geometry_nodes_dependencies.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_list.hh"
 #include "NOD_multi_function.hh"
@@ -35,6 +36,8 @@
 #include "BLI_cpp_types.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
 
 #include "DNA_ID.h"
 
@@ -54,6 +57,7 @@
 
 #include "ED_node.hh"
 
+#include "FN_lazy_function_execute.hh"
 #include "FN_lazy_function_graph_executor.hh"
 
 #include "DEG_depsgraph_query.hh"
@@ -1088,6 +1092,150 @@ bool should_log_socket_values_for_context(const GeoNodesUserData &user_data,
   return true;
 }
 
+/**
+ * Identifies the outputs of a group node for specific input values, see
+ * #LazyFunctionForGroupNode::execute_with_output_cache.
+ */
+class GroupOutputCacheKey : public GenericKey {
+ public:
+  uint64_t group_node_cache_id;
+  ComputeContextHash compute_context_hash;
+  /** Values of the main inputs of the group, all of them are single values. */
+  Vector<SocketValueVariant> inputs;
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(this->group_node_cache_id, this->compute_context_hash);
+    for (const SocketValueVariant &value : this->inputs) {
+      const GPointer value_ptr = value.get_single_ptr();
+      hash = get_default_hash(hash, value_ptr.type()->hash(value_ptr.get()));
+    }
+    return hash;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    const auto *other_key = dynamic_cast<const GroupOutputCacheKey *>(&other);
+    if (!other_key) {
+      return false;
+    }
+    if (this->group_node_cache_id != other_key->group_node_cache_id ||
+        this->compute_context_hash != other_key->compute_context_hash ||
+        this->inputs.size() != other_key->inputs.size())
+    {
+      return false;
+    }
+    for (const int i : this->inputs.index_range()) {
+      const GPointer a = this->inputs[i].get_single_ptr();
+      const GPointer b = other_key->inputs[i].get_single_ptr();
+      if (a.type() != b.type() || !a.type()->is_equal(a.get(), b.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<GroupOutputCacheKey>(*this);
+  }
+};
+
+class GroupOutputCacheValue : public memory_cache::CachedValue {
+ public:
+  /** Values of the main outputs of the group. Geometries are shared with the users. */
+  Vector<SocketValueVariant> outputs;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const SocketValueVariant &value : this->outputs) {
+      value.count_memory(memory);
+    }
+  }
+};
+
+/**
+ * Check whether the outputs of the group node only depend on its input values, so that they can
+ * be cached and reused in later evaluations.
+ */
+static bool group_outputs_are_cacheable(const bNode &group_node,
+                                        const bNodeTree &group,
+                                        const GeometryNodesGroupFunction &function)
+{
+  if (!function.inputs.references_to_propagate.range.is_empty()) {
+    return false;
+  }
+  /* Fields are not compared by value, so the outputs for field inputs can't be looked up. This is
+   * checked on the group node, because the cache waits for all inputs to be computed, which would
+   * be wasted when the inputs turn out to be fields. */
+  for (const bNodeSocket *input_bsocket : group_node.input_sockets()) {
+    if (input_bsocket->is_available() && input_bsocket->may_be_field()) {
+      return false;
+    }
+  }
+  const GeometryNodesEvalDependencies *deps =
+      group.runtime->geometry_nodes_eval_dependencies.get();
+  if (deps == nullptr) {
+    return false;
+  }
+  if (deps->time_dependent || deps->context_dependent || deps->needs_own_transform ||
+      deps->needs_active_camera || deps->needs_scene_render_params)
+  {
+    return false;
+  }
+  for (const ID *id : deps->ids.values()) {
+    /* Materials are only referenced by the generated geometry. The data of other data-blocks may
+     * change without the node group changing. */
+    if (GS(id->name) != ID_MA) {
+      return false;
+    }
+  }
+  const auto is_plain_data_type = [](const eNodeSocketDatatype type) {
+    return ELEM(type,
+                SOCK_FLOAT,
+                SOCK_INT,
+                SOCK_BOOLEAN,
+                SOCK_VECTOR,
+                SOCK_RGBA,
+                SOCK_ROTATION,
+                SOCK_MATRIX,
+                SOCK_STRING,
+                SOCK_MENU);
+  };
+  for (const bNodeTreeInterfaceSocket *interface_bsocket : group.interface_inputs()) {
+    if (!is_plain_data_type(interface_bsocket->socket_typeinfo()->type)) {
+      return false;
+    }
+  }
+  /* Only cache groups that generate geometry. Other outputs are usually cheap to compute. */
+  bool has_geometry_output = false;
+  for (const bNodeTreeInterfaceSocket *interface_bsocket : group.interface_outputs()) {
+    const eNodeSocketDatatype type = interface_bsocket->socket_typeinfo()->type;
+    if (type == SOCK_GEOMETRY) {
+      has_geometry_output = true;
+    }
+    else if (!is_plain_data_type(type)) {
+      return false;
+    }
+  }
+  return has_geometry_output;
+}
+
+static bool group_output_cache_is_allowed(const GeoNodesCallData &call_data)
+{
+  /* Nodes in the cached group are not executed, so nothing would be logged for them. This is
+   * only acceptable when nothing is logged at all, e.g. in final renders. */
+  if (call_data.eval_log != nullptr) {
+    return false;
+  }
+  if (call_data.side_effect_nodes != nullptr &&
+      !call_data.side_effect_nodes->nodes_by_context.is_empty())
+  {
+    return false;
+  }
+  return call_data.modifier_data != nullptr;
+}
+
 /**
  * This lazy-function wraps a group node. Internally it just executes the lazy-function graph of
  * the referenced group.
@@ -1096,17 +1244,28 @@ class LazyFunctionForGroupNode : public LazyFunction {
  private:
   const bNode &group_node_;
   const LazyFunction &group_lazy_function_;
+  const GeometryNodesGroupFunction &group_function_;
   bool has_many_nodes_ = false;
+  /**
+   * Unique identifier of this group node used in cache keys. Empty if the outputs of the group
+   * are not cached. Every change of the node tree creates a new lazy-function, so outdated cached
+   * outputs are never found.
+   */
+  std::optional<uint64_t> output_cache_id_;
 
   struct Storage {
     void *group_storage = nullptr;
+    /** Decided on the first execution, whether the output cache is used for this evaluation. */
+    std::optional<bool> use_output_cache;
   };
 
  public:
   LazyFunctionForGroupNode(const bNode &group_node,
                            const GeometryNodesLazyFunctionGraphInfo &group_lf_graph_info,
                            GeometryNodesLazyFunctionGraphInfo &own_lf_graph_info)
-      : group_node_(group_node), group_lazy_function_(*group_lf_graph_info.function.function)
+      : group_node_(group_node),
+        group_lazy_function_(*group_lf_graph_info.function.function),
+        group_function_(group_lf_graph_info.function)
   {
     debug_name_ = group_node.name;
     allow_missing_requested_inputs_ = true;
@@ -1137,6 +1296,27 @@ class LazyFunctionForGroupNode : public LazyFunction {
           .lf_input_index_for_reference_set_for_output[output_bsocket.index_in_all_outputs()] =
           lf_index;
     }
+
+    if (group_outputs_are_cacheable(
+            group_node, *reinterpret_cast<const bNodeTree *>(group_node.id), group_function_))
+    {
+      static std::atomic<uint64_t> next_output_cache_id = 0;
+      output_cache_id_ = next_output_cache_id.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  ~LazyFunctionForGroupNode() override
+  {
+    if (!output_cache_id_) {
+      return;
+    }
+    /* Outputs cached by this group node can't be found anymore. */
+    memory_cache::remove_if([&](const GenericKey &key) {
+      if (const auto *output_key = dynamic_cast<const GroupOutputCacheKey *>(&key)) {
+        return output_key->group_node_cache_id == *output_cache_id_;
+      }
+      return false;
+    });
   }
 
   void execute_impl(lf::Params &params, const lf::Context &context) const override
@@ -1166,9 +1346,139 @@ class LazyFunctionForGroupNode : public LazyFunction {
     lf::Context group_context{storage->group_storage, &group_user_data, &group_local_user_data};
 
     ScopedComputeContextTimer timer(group_context);
+
+    if (output_cache_id_) {
+      if (!storage->use_output_cache.has_value()) {
+        storage->use_output_cache = group_output_cache_is_allowed(*user_data->call_data);
+      }
+      if (*storage->use_output_cache) {
+        this->execute_with_output_cache(params, group_context);
+        return;
+      }
+    }
+
     group_lazy_function_.execute(params, group_context);
   }
 
+  /**
+   * Instead of evaluating the group lazily, wait for all inputs, and then compute all outputs at
+   * once, or reuse them from a previous evaluation with the same input values.
+   */
+  void execute_with_output_cache(lf::Params &params, const lf::Context &group_context) const
+  {
+    /* Claim that all inputs are used before they are available, because computing the inputs may
+     * depend on their usage. Being conservative here is allowed. */
+    for (const int i : group_function_.outputs.input_usages) {
+      if (!params.output_was_set(i) && params.get_output_usage(i) != lf::ValueUsage::Unused) {
+        params.set_output(i, true);
+      }
+    }
+    bool all_inputs_available = true;
+    for (const int i : group_function_.inputs.main) {
+      if (params.try_get_input_data_ptr_or_request(i) == nullptr) {
+        all_inputs_available = false;
+      }
+    }
+    if (!all_inputs_available) {
+      /* The function is executed again when the requested inputs are available. */
+      return;
+    }
+
+    GroupOutputCacheKey key;
+    key.group_node_cache_id = *output_cache_id_;
+    key.compute_context_hash = static_cast<const GeoNodesUserData *>(group_context.user_data)
+                                   ->compute_context->hash();
+    bool inputs_are_hashable = true;
+    for (const int i : group_function_.inputs.main) {
+      const SocketValueVariant &value = params.get_input<SocketValueVariant>(i);
+      if (!value.is_single()) {
+        /* Fields are not compared by value. Inputs that may be fields are already excluded when
+         * creating the function, so this is only a fallback. */
+        inputs_are_hashable = false;
+        break;
+      }
+      const CPPType &type = *value.get_single_ptr().type();
+      if (!type.is_hashable() || !type.is_equality_comparable()) {
+        inputs_are_hashable = false;
+        break;
+      }
+      key.inputs.append(value);
+    }
+
+    const auto compute_outputs = [&]() {
+      return this->compute_all_outputs(params, group_context);
+    };
+    std::shared_ptr<const GroupOutputCacheValue> cached_outputs;
+    if (inputs_are_hashable) {
+      cached_outputs = memory_cache::get<GroupOutputCacheValue>(key, compute_outputs);
+    }
+    else {
+      cached_outputs = compute_outputs();
+    }
+
+    for (const int i : group_function_.outputs.main.index_range()) {
+      const int output_index = group_function_.outputs.main[i];
+      if (!params.output_was_set(output_index) &&
+          params.get_output_usage(output_index) != lf::ValueUsage::Unused)
+      {
+        params.set_output(output_index, SocketValueVariant(cached_outputs->outputs[i]));
+      }
+    }
+  }
+
+  std::unique_ptr<GroupOutputCacheValue> compute_all_outputs(
+      const lf::Params &params, const lf::Context &group_context) const
+  {
+    LinearAllocator<> allocator;
+    const int inputs_num = group_lazy_function_.inputs().size();
+    const int outputs_num = group_lazy_function_.outputs().size();
+
+    /* Copy the inputs, because the group may move from them while they are still used by the
+     * cache key. */
+    Array<SocketValueVariant> main_inputs(group_function_.inputs.main.size());
+    Array<bool> output_usages(group_function_.inputs.output_usages.size(), true);
+    Array<GMutablePointer> inputs(inputs_num);
+    for (const int i : group_function_.inputs.main.index_range()) {
+      const int input_index = group_function_.inputs.main[i];
+      main_inputs[i] = params.get_input<SocketValueVariant>(input_index);
+      inputs[input_index] = &main_inputs[i];
+    }
+    for (const int i : group_function_.inputs.output_usages.index_range()) {
+      inputs[group_function_.inputs.output_usages[i]] = &output_usages[i];
+    }
+
+    Array<GMutablePointer> outputs(outputs_num);
+    for (const int i : IndexRange(outputs_num)) {
+      const CPPType &type = *group_lazy_function_.outputs()[i].type;
+      outputs[i] = {type, allocator.allocate(type)};
+    }
+    Array<std::optional<lf::ValueUsage>> input_usages(inputs_num);
+    Array<lf::ValueUsage> output_usages_for_execution(outputs_num, lf::ValueUsage::Used);
+    Array<bool> set_outputs(outputs_num, false);
+
+    lf::Context eval_context{group_lazy_function_.init_storage(allocator),
+                             group_context.user_data,
+                             group_context.local_user_data};
+    lf::BasicParams eval_params{group_lazy_function_,
+                                inputs,
+                                outputs,
+                                input_usages,
+                                output_usages_for_execution,
+                                set_outputs};
+    group_lazy_function_.execute(eval_params, eval_context);
+    group_lazy_function_.destruct_storage(eval_context.storage);
+    BLI_assert(!set_outputs.as_span().contains(false));
+
+    auto result = std::make_unique<GroupOutputCacheValue>();
+    for (const int output_index : group_function_.outputs.main) {
+      result->outputs.append(std::move(*outputs[output_index].get<SocketValueVariant>()));
+    }
+    for (GMutablePointer output : outputs) {
+      output.destruct();
+    }
+    return result;
+  }
+
   void *init_storage(LinearAllocator<> &allocator) const override
   {
     Storage *s = allocator.construct<Storage>().release();
@@ -13,6 +13,7 @@
 #include "BLT_translation.hh"
 
 #include "BLI_array_utils.hh"
+#include "BLI_lazy_threading.hh"
 
 #include "DEG_depsgraph_query.hh"
 
@@ -22,6 +23,52 @@ namespace blender::nodes {
 
 using bke::SocketValueVariant;
 
+/**
+ * Minimum number of iterations for which the evaluation of iterations is overlapped (see
+ * #RepeatBodyParams). For fewer iterations, the threading overhead is likely not worth it.
+ */
+static constexpr int min_iterations_for_overlapped_evaluation = 8;
+
+/**
+ * Parameters of a single loop body evaluation that forward to the parameters provided by the
+ * graph executor.
+ *
+ * Repeat zones are often used to do mostly independent work per iteration which is then combined
+ * with the result of the previous iteration (e.g. with a Join Geometry node). When the body
+ * requests a repeat item from the previous iteration, the previous iteration is scheduled on the
+ * current thread, but would only run after this body is done with all the work that does not
+ * depend on the previous iteration. Sending a hint at that point allows other threads to pick up
+ * the previous iteration right away. This way, the independent parts of all iterations are
+ * evaluated in parallel, while the dependent parts still run in order.
+ */
+class RepeatBodyParams : public lf::RemappedParams {
+ private:
+  Span<int> repeat_item_inputs_;
+  bool hint_sent_ = false;
+
+ public:
+  RepeatBodyParams(const LazyFunction &fn,
+                   lf::Params &base_params,
+                   const Span<int> input_map,
+                   const Span<int> output_map,
+                   bool &multi_threading_enabled,
+                   const Span<int> repeat_item_inputs)
+      : RemappedParams(fn, base_params, input_map, output_map, multi_threading_enabled),
+        repeat_item_inputs_(repeat_item_inputs)
+  {
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    void *value = RemappedParams::try_get_input_data_ptr_or_request_impl(index);
+    if (value == nullptr && !hint_sent_ && repeat_item_inputs_.contains(index)) {
+      hint_sent_ = true;
+      lazy_threading::send_hint();
+    }
+    return value;
+  }
+};
+
 /**
  * Wraps the execution of a repeat loop body. The purpose is to setup the correct #ComputeContext
  * inside of the loop body. This is necessary to support correct logging inside of a repeat zone.
@@ -32,6 +79,17 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
  public:
   const bNode *repeat_output_bnode_ = nullptr;
   VectorSet<lf::FunctionNode *> *lf_body_nodes_ = nullptr;
+  /** Body function inputs of the repeat items, see #RepeatBodyParams. */
+  Span<int> repeat_item_inputs_;
+  /** Identity mappings used to forward the parameters of a body evaluation. */
+  Array<int> input_index_map_;
+  Array<int> output_index_map_;
+  /**
+   * Whether multi-threading was enabled for each body node. A body node may be executed multiple
+   * times, so this has to persist across executions, just like for the graph of the zone.
+   */
+  MutableSpan<bool> body_multi_threading_enabled_;
+  bool overlap_iterations_ = false;
 
   void execute_node(const lf::FunctionNode &node,
                     lf::Params &params,
@@ -56,7 +114,17 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
 
     GeoNodesLocalUserData body_local_user_data{body_user_data};
     lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
-    fn.execute(params, body_context);
+    if (!overlap_iterations_) {
+      fn.execute(params, body_context);
+      return;
+    }
+    RepeatBodyParams body_params{fn,
+                                 params,
+                                 input_index_map_,
+                                 output_index_map_,
+                                 body_multi_threading_enabled_[iteration],
+                                 repeat_item_inputs_};
+    fn.execute(body_params, body_context);
   }
 };
 
@@ -102,6 +170,7 @@ struct RepeatEvalStorage {
   Array<SocketValueVariant> index_values;
   void *graph_executor_storage = nullptr;
   bool multi_threading_enabled = false;
+  Array<bool> body_multi_threading_enabled;
   Vector<int> input_index_map;
   Vector<int> output_index_map;
 };
@@ -380,8 +449,23 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     lf_graph_outputs.extend(lf_outputs.as_span().drop_front(iteration_usage_index + 1));
 
     eval_storage.body_execute_wrapper.emplace();
-    eval_storage.body_execute_wrapper->repeat_output_bnode_ = &repeat_output_bnode_;
-    eval_storage.body_execute_wrapper->lf_body_nodes_ = &lf_body_nodes;
+    RepeatBodyNodeExecuteWrapper &body_execute_wrapper = *eval_storage.body_execute_wrapper;
+    body_execute_wrapper.repeat_output_bnode_ = &repeat_output_bnode_;
+    body_execute_wrapper.lf_body_nodes_ = &lf_body_nodes;
+    if (iterations >= min_iterations_for_overlapped_evaluation && num_repeat_items > 0) {
+      const LazyFunction &body_function = *body_fn_.function;
+      body_execute_wrapper.overlap_iterations_ = true;
+      body_execute_wrapper.repeat_item_inputs_ = body_fn_.indices.inputs.main.as_span().drop_front(
+          body_inputs_offset);
+      body_execute_wrapper.input_index_map_.reinitialize(body_function.inputs().size());
+      body_execute_wrapper.output_index_map_.reinitialize(body_function.outputs().size());
+      array_utils::fill_index_range<int>(body_execute_wrapper.input_index_map_);
+      array_utils::fill_index_range<int>(body_execute_wrapper.output_index_map_);
+      eval_storage.body_multi_threading_enabled.reinitialize(lf_body_nodes.size());
+      eval_storage.body_multi_threading_enabled.fill(false);
+      body_execute_wrapper.body_multi_threading_enabled_ =
+          eval_storage.body_multi_threading_enabled;
+    }
     eval_storage.side_effect_provider.emplace();
     eval_storage.side_effect_provider->repeat_output_bnode_ = &repeat_output_bnode_;
     eval_storage.side_effect_provider->lf_body_nodes_ = lf_body_nodes;
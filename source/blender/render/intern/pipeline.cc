@@ -14,6 +14,8 @@
 #include <cstring>
 #include <forward_list>
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "DNA_anim_types.h"
 #include "DNA_defs.h"
@@ -31,8 +33,10 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_mutex.hh"
+#include "BLI_path_utils.hh"
 #include "BLI_rect.h"
 #include "BLI_set.hh"
+#include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
@@ -63,6 +67,7 @@
 #include "NOD_composite.hh"
 
 #include "COM_node_group_operation.hh"
+#include "COM_profiler.hh"
 #include "COM_render_context.hh"
 
 #include "DEG_depsgraph.hh"
@@ -1210,6 +1215,28 @@ static void do_render_compositor_scenes(Render *re)
   }
 }
 
+/* Write the Chrome trace of the compositor evaluation of the given frame. Hash characters in the
+ * file name are replaced by the frame number, otherwise the number is appended, such that the
+ * frames of an animation render do not overwrite each other. */
+static void write_compositor_trace(const compositor::Profiler &profiler,
+                                   const char *trace_filepath,
+                                   const int frame)
+{
+  char filepath[FILE_MAX];
+  STRNCPY(filepath, trace_filepath);
+  BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+  if (!BLI_path_frame(filepath, sizeof(filepath), frame, 0)) {
+    BLI_path_suffix(filepath, sizeof(filepath), std::to_string(frame).c_str(), "_");
+  }
+
+  if (profiler.write_chrome_trace(filepath)) {
+    CLOG_INFO(&LOG, "Compositor trace written to \"%s\"", filepath);
+  }
+  else {
+    CLOG_ERROR(&LOG, "Failed to write compositor trace to \"%s\"", filepath);
+  }
+}
+
 /* Render compositor nodes, along with any scenes required for them.
  * The result will be output into a compositing render layer in the render result. */
 static void do_render_compositor(Render *re)
@@ -1281,6 +1308,14 @@ static void do_render_compositor(Render *re)
         re->display->stats_draw(&re->i);
         re->i.infostr = nullptr;
 
+        /* Profile the compositor when a trace file is requested, which is mainly useful to find
+         * the nodes that dominate the compositing time of render farm jobs. */
+        const char *trace_filepath = BLI_getenv("BLENDER_COMPOSITOR_TRACE");
+        std::optional<compositor::Profiler> profiler;
+        if (trace_filepath && trace_filepath[0] != '\0') {
+          profiler.emplace(true);
+        }
+
         compositor::RenderContext compositor_render_context;
         compositor_render_context.is_animation_render = re->flag & R_ANIMATION;
         for (RenderView &rv : re->result->views) {
@@ -1290,10 +1325,14 @@ static void do_render_compositor(Render *re)
                                 *ntree,
                                 rv.name,
                                 &compositor_render_context,
-                                nullptr,
+                                profiler ? &*profiler : nullptr,
                                 needed_outputs);
         }
         compositor_render_context.save_file_outputs(re->pipeline_scene_eval);
+
+        if (profiler) {
+          write_compositor_trace(*profiler, trace_filepath, re->r.cfra);
+        }
       }
     }
   }
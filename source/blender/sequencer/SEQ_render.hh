@@ -40,6 +40,8 @@ struct RenderData {
   bool skip_cache = false;
   bool is_prefetch_render = false;
   bool is_playing = false;
+  /* Whether playback goes backwards, used to prefetch frames in the direction of playback. */
+  bool is_playing_backwards = false;
   bool is_scrubbing = false;
   int view_id = 0;
 
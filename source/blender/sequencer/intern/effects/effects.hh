@@ -14,8 +14,11 @@
 #include "BLI_math_color.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_mutex.hh"
+#include "BLI_simd.hh"
 #include "BLI_task.hh"
 
+#include "DNA_sequence_types.h"
+
 #include "IMB_imbuf_types.hh"
 #include "SEQ_effects.hh"
 
@@ -106,6 +109,22 @@ inline void store_premul_pixel(const float4 &pix, float *dst)
   *reinterpret_cast<float4 *>(dst) = pix;
 }
 
+#if BLI_HAVE_SSE2
+/* Take the color from `color` and the alpha from `alpha`, for four byte pixels or one float
+ * pixel. */
+inline __m128i keep_alpha_epu8(const __m128i color, const __m128i alpha)
+{
+  const __m128i mask = _mm_set1_epi32(int(0xFF000000u));
+  return _mm_or_si128(_mm_andnot_si128(mask, color), _mm_and_si128(mask, alpha));
+}
+
+inline __m128 keep_alpha_ps(const __m128 color, const __m128 alpha)
+{
+  const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  return _mm_or_ps(_mm_and_ps(mask, color), _mm_andnot_ps(mask, alpha));
+}
+#endif
+
 StripEarlyOut early_out_mul_input1(const Strip * /*strip*/, float fac);
 StripEarlyOut early_out_mul_input2(const Strip * /*strip*/, float fac);
 StripEarlyOut early_out_fade(const Strip * /*strip*/, float fac);
@@ -168,6 +187,39 @@ static void apply_effect_op(const OpT &op, const ImBuf *src1, const ImBuf *src2,
   });
 }
 
+/* Apply the cross, add, subtract or multiply effect to byte pixels. The SIMD kernels process as
+ * many pixels as they can and the scalar code the remaining ones, unless `use_simd` is false, in
+ * which case only the scalar code is used. That is only meant for testing the SIMD kernels. */
+void cross_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+void add_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+void sub_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+void mul_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+
+/* Apply the alpha over, alpha under or a blend mode effect, with the same meaning of `use_simd`.
+ * Only some of the blend modes have SIMD kernels. */
+void alpha_over_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+void alpha_under_effect_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+void blend_mode_effect_byte(const uchar *src1,
+                            const uchar *src2,
+                            uchar *dst,
+                            int64_t size,
+                            float fac,
+                            StripBlendMode blend_mode,
+                            bool use_simd);
+void blend_mode_effect_float(const float *src1,
+                             const float *src2,
+                             float *dst,
+                             int64_t size,
+                             float fac,
+                             StripBlendMode blend_mode,
+                             bool use_simd);
+
 std::unique_lock<Mutex> text_runtime_scoped_lock_get();
 TextVarsRuntime *text_effect_calc_runtime(const Strip *strip, int font, const int2 image_size);
 int text_effect_font_init(const RenderData *context, const Strip *strip, FontFlags font_flags);
@@ -6,6 +6,8 @@
  * \ingroup sequencer
  */
 
+#include "BLI_simd.hh"
+
 #include "DNA_sequence_types.h"
 
 #include "IMB_imbuf.hh"
@@ -16,6 +18,150 @@
 
 namespace blender::seq {
 
+#if BLI_HAVE_SSE2
+/* Broadcast the alpha of each of the two pixels in a register of 16-bit channels. */
+static __m128i broadcast_alpha_epi16(const __m128i pixels)
+{
+  return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                             _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+/* Compute `(ifac * src2[3] * src2[i]) >> 16` for the color channels of four pixels, which is the
+ * amount added or subtracted by the add and subtract effects. */
+static __m128i add_sub_amount_epu8(const __m128i src2, const __m128i ifac)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_unpacklo_epi8(src2, zero);
+  const __m128i hi = _mm_unpackhi_epi8(src2, zero);
+  const __m128i f_lo = _mm_mullo_epi16(broadcast_alpha_epi16(lo), ifac);
+  const __m128i f_hi = _mm_mullo_epi16(broadcast_alpha_epi16(hi), ifac);
+  return _mm_packus_epi16(_mm_mulhi_epu16(f_lo, lo), _mm_mulhi_epu16(f_hi, hi));
+}
+
+/* Factor of the add and subtract effects for a float pixel, broadcast to all channels. */
+static __m128 add_sub_factor_ps(const __m128 a, const __m128 b, const __m128 mfac)
+{
+  const __m128 alpha1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+  const __m128 alpha2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(alpha1, mfac)), alpha2);
+}
+
+/* The kernels below return the number of pixels they processed, the remaining ones are processed
+ * by the scalar code. Byte kernels are exact, but only handle factors up to one such that the
+ * intermediate products fit in 16 bits. */
+
+static int64_t add_sse2(
+    const uchar *src1, const uchar *src2, uchar *dst, const int64_t size, const float fac)
+{
+  const int ifac = int(256.0f * fac);
+  if (ifac < 0 || ifac > 256) {
+    return 0;
+  }
+  const __m128i vfac = _mm_set1_epi16(short(ifac));
+  int64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx * 4));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + idx * 4));
+    const __m128i result = _mm_adds_epu8(a, add_sub_amount_epu8(b, vfac));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx * 4), keep_alpha_epu8(result, a));
+  }
+  return idx;
+}
+
+static int64_t add_sse2(
+    const float *src1, const float *src2, float *dst, const int64_t size, const float fac)
+{
+  const __m128 mfac = _mm_set1_ps(1.0f - fac);
+  for (int64_t idx = 0; idx < size; idx++) {
+    const __m128 a = _mm_loadu_ps(src1 + idx * 4);
+    const __m128 b = _mm_loadu_ps(src2 + idx * 4);
+    const __m128 result = _mm_add_ps(a, _mm_mul_ps(add_sub_factor_ps(a, b, mfac), b));
+    _mm_storeu_ps(dst + idx * 4, keep_alpha_ps(result, a));
+  }
+  return size;
+}
+
+static int64_t sub_sse2(
+    const uchar *src1, const uchar *src2, uchar *dst, const int64_t size, const float fac)
+{
+  const int ifac = int(256.0f * fac);
+  if (ifac < 0 || ifac > 256) {
+    return 0;
+  }
+  const __m128i vfac = _mm_set1_epi16(short(ifac));
+  int64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx * 4));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + idx * 4));
+    const __m128i result = _mm_subs_epu8(a, add_sub_amount_epu8(b, vfac));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx * 4), keep_alpha_epu8(result, a));
+  }
+  return idx;
+}
+
+static int64_t sub_sse2(
+    const float *src1, const float *src2, float *dst, const int64_t size, const float fac)
+{
+  const __m128 mfac = _mm_set1_ps(1.0f - fac);
+  const __m128 zero = _mm_setzero_ps();
+  for (int64_t idx = 0; idx < size; idx++) {
+    const __m128 a = _mm_loadu_ps(src1 + idx * 4);
+    const __m128 b = _mm_loadu_ps(src2 + idx * 4);
+    const __m128 result = _mm_max_ps(_mm_sub_ps(a, _mm_mul_ps(add_sub_factor_ps(a, b, mfac), b)),
+                                     zero);
+    _mm_storeu_ps(dst + idx * 4, keep_alpha_ps(result, a));
+  }
+  return size;
+}
+
+static int64_t mul_sse2(
+    const uchar *src1, const uchar *src2, uchar *dst, const int64_t size, const float fac)
+{
+  const int ifac = int(256.0f * fac);
+  if (ifac < 0 || ifac > 256) {
+    return 0;
+  }
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i vfac = _mm_set1_epi16(short(ifac));
+  const __m128i v255 = _mm_set1_epi16(255);
+  /* The scalar code computes `a + ((ifac * a * (b - 255)) >> 16)`, the shift of the negative
+   * product rounds towards negative infinity. So subtract the rounded up positive product, whose
+   * 32-bit value is split in the high and low halves of the 16-bit multiplication. */
+  auto mul_epi16 = [&](const __m128i a, const __m128i b) {
+    const __m128i t = _mm_mullo_epi16(a, _mm_sub_epi16(v255, b));
+    const __m128i high = _mm_mulhi_epu16(t, vfac);
+    const __m128i low_is_zero = _mm_cmpeq_epi16(_mm_mullo_epi16(t, vfac), zero);
+    /* Add one, unless the low half is zero and the comparison gives minus one. */
+    const __m128i rounded_up = _mm_add_epi16(_mm_add_epi16(high, _mm_set1_epi16(1)),
+                                             low_is_zero);
+    return _mm_sub_epi16(a, rounded_up);
+  };
+  int64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx * 4));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + idx * 4));
+    const __m128i lo = mul_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    const __m128i hi = mul_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx * 4), _mm_packus_epi16(lo, hi));
+  }
+  return idx;
+}
+
+static int64_t mul_sse2(
+    const float *src1, const float *src2, float *dst, const int64_t size, const float fac)
+{
+  const __m128 vfac = _mm_set1_ps(fac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (int64_t idx = 0; idx < size; idx++) {
+    const __m128 a = _mm_loadu_ps(src1 + idx * 4);
+    const __m128 b = _mm_loadu_ps(src2 + idx * 4);
+    _mm_storeu_ps(dst + idx * 4,
+                  _mm_add_ps(a, _mm_mul_ps(_mm_mul_ps(vfac, a), _mm_sub_ps(b, one))));
+  }
+  return size;
+}
+#endif
+
 /* -------------------------------------------------------------------- */
 /* Color Add Effect */
 
@@ -24,7 +170,16 @@ struct AddEffectOp {
   {
     const float fac = this->factor;
     int ifac = int(256.0f * fac);
-    for (int64_t idx = 0; idx < size; idx++) {
+    int64_t idx = 0;
+#if BLI_HAVE_SSE2
+    if (this->use_simd) {
+      idx = add_sse2(src1, src2, dst, size, fac);
+      src1 += idx * 4;
+      src2 += idx * 4;
+      dst += idx * 4;
+    }
+#endif
+    for (; idx < size; idx++) {
       if constexpr (std::is_same_v<T, uchar>) {
         const int f = ifac * int(src2[3]);
         dst[0] = min_ii(src1[0] + ((f * src2[0]) >> 16), 255);
@@ -44,8 +199,22 @@ struct AddEffectOp {
     }
   }
   float factor;
+  bool use_simd = true;
 };
 
+void add_effect_byte(const uchar *src1,
+                     const uchar *src2,
+                     uchar *dst,
+                     const int64_t size,
+                     const float fac,
+                     const bool use_simd)
+{
+  AddEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_add_effect(const RenderData *context,
                             SeqRenderState * /*state*/,
                             Strip * /*strip*/,
@@ -69,7 +238,16 @@ struct SubEffectOp {
   {
     const float fac = this->factor;
     int ifac = int(256.0f * fac);
-    for (int64_t idx = 0; idx < size; idx++) {
+    int64_t idx = 0;
+#if BLI_HAVE_SSE2
+    if (this->use_simd) {
+      idx = sub_sse2(src1, src2, dst, size, fac);
+      src1 += idx * 4;
+      src2 += idx * 4;
+      dst += idx * 4;
+    }
+#endif
+    for (; idx < size; idx++) {
       if constexpr (std::is_same_v<T, uchar>) {
         const int f = ifac * int(src2[3]);
         dst[0] = max_ii(src1[0] - ((f * src2[0]) >> 16), 0);
@@ -89,8 +267,22 @@ struct SubEffectOp {
     }
   }
   float factor;
+  bool use_simd = true;
 };
 
+void sub_effect_byte(const uchar *src1,
+                     const uchar *src2,
+                     uchar *dst,
+                     const int64_t size,
+                     const float fac,
+                     const bool use_simd)
+{
+  SubEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_sub_effect(const RenderData *context,
                             SeqRenderState * /*state*/,
                             Strip * /*strip*/,
@@ -114,7 +306,16 @@ struct MulEffectOp {
   {
     const float fac = this->factor;
     int ifac = int(256.0f * fac);
-    for (int64_t idx = 0; idx < size; idx++) {
+    int64_t idx = 0;
+#if BLI_HAVE_SSE2
+    if (this->use_simd) {
+      idx = mul_sse2(src1, src2, dst, size, fac);
+      src1 += idx * 4;
+      src2 += idx * 4;
+      dst += idx * 4;
+    }
+#endif
+    for (; idx < size; idx++) {
       /* Formula: `fac * (a * b) + (1-fac) * a => fac * a * (b - 1) + a` */
       if constexpr (std::is_same_v<T, uchar>) {
         dst[0] = src1[0] + ((ifac * src1[0] * (src2[0] - 255)) >> 16);
@@ -134,8 +335,22 @@ struct MulEffectOp {
     }
   }
   float factor;
+  bool use_simd = true;
 };
 
+void mul_effect_byte(const uchar *src1,
+                     const uchar *src2,
+                     uchar *dst,
+                     const int64_t size,
+                     const float fac,
+                     const bool use_simd)
+{
+  MulEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_mul_effect(const RenderData *context,
                             SeqRenderState * /*state*/,
                             Strip * /*strip*/,
@@ -7,6 +7,7 @@
  */
 
 #include "BLI_math_color_blend.h"
+#include "BLI_simd.hh"
 
 #include "DNA_sequence_types.h"
 
@@ -40,6 +41,44 @@ static bool alpha_opaque(float alpha)
   return alpha >= 1.0f;
 }
 
+#if BLI_HAVE_SSE2
+/* SSE2 versions of #load_premul_pixel and #store_premul_pixel for a byte pixel. They do the same
+ * float operations in the same order, so they give the same results. */
+static __m128 load_premul_pixel_sse2(const uchar *ptr)
+{
+  int32_t packed;
+  memcpy(&packed, ptr, sizeof(packed));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 color = _mm_cvtepi32_ps(
+      _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero));
+  const __m128 alpha = _mm_mul_ps(_mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3)),
+                                  _mm_set1_ps(1.0f / 255.0f));
+  const __m128 fac = _mm_mul_ps(alpha, _mm_set1_ps(1.0f / 255.0f));
+  return keep_alpha_ps(_mm_mul_ps(color, fac), alpha);
+}
+
+static void store_premul_pixel_sse2(const __m128 color, uchar *dst)
+{
+  const float alpha = _mm_cvtss_f32(_mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3)));
+  __m128 straight = color;
+  if (alpha != 0.0f && alpha != 1.0f) {
+    straight = keep_alpha_ps(_mm_mul_ps(color, _mm_set1_ps(1.0f / alpha)), color);
+  }
+  /* Same as #unit_float_to_uchar_clamp for each channel. */
+  const __m128i rounded = _mm_cvttps_epi32(
+      _mm_add_ps(_mm_mul_ps(straight, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+  const __m128i is_low = _mm_castps_si128(_mm_cmple_ps(straight, _mm_setzero_ps()));
+  const __m128i is_high = _mm_castps_si128(
+      _mm_cmpgt_ps(straight, _mm_set1_ps(1.0f - 0.5f / 255.0f)));
+  __m128i result = _mm_andnot_si128(is_low, rounded);
+  result = _mm_or_si128(_mm_andnot_si128(is_high, result),
+                        _mm_and_si128(is_high, _mm_set1_epi32(255)));
+  result = _mm_packs_epi32(result, result);
+  const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(result, result));
+  memcpy(dst, &packed, sizeof(packed));
+}
+#endif
+
 /* dst = src1 over src2 (alpha from src1) */
 struct AlphaOverEffectOp {
   template<typename T> void apply(const T *src1, const T *src2, T *dst, int64_t size) const
@@ -50,6 +89,9 @@ struct AlphaOverEffectOp {
       return;
     }
 
+#if BLI_HAVE_SSE2
+    const __m128 vfac = _mm_set1_ps(fac);
+#endif
     for (int64_t idx = 0; idx < size; idx++) {
       if (src1[3] <= 0.0f) {
         /* Alpha of zero. No color addition will happen as the colors are pre-multiplied. */
@@ -60,11 +102,29 @@ struct AlphaOverEffectOp {
         memcpy(dst, src1, sizeof(T) * 4);
       }
       else {
-        float4 col1 = load_premul_pixel(src1);
-        float mfac = 1.0f - fac * col1.w;
-        float4 col2 = load_premul_pixel(src2);
-        float4 col = fac * col1 + mfac * col2;
-        store_premul_pixel(col, dst);
+#if BLI_HAVE_SSE2
+        if constexpr (std::is_same_v<T, float>) {
+          const __m128 col1 = _mm_loadu_ps(src1);
+          const __m128 mfac = _mm_set1_ps(1.0f - fac * src1[3]);
+          const __m128 col2 = _mm_loadu_ps(src2);
+          _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(vfac, col1), _mm_mul_ps(mfac, col2)));
+        }
+        else if (this->use_simd) {
+          const __m128 col1 = load_premul_pixel_sse2(src1);
+          const __m128 mfac = _mm_set1_ps(1.0f - fac * (src1[3] * (1.0f / 255.0f)));
+          const __m128 col2 = load_premul_pixel_sse2(src2);
+          store_premul_pixel_sse2(_mm_add_ps(_mm_mul_ps(vfac, col1), _mm_mul_ps(mfac, col2)),
+                                  dst);
+        }
+        else
+#endif
+        {
+          float4 col1 = load_premul_pixel(src1);
+          float mfac = 1.0f - fac * col1.w;
+          float4 col2 = load_premul_pixel(src2);
+          float4 col = fac * col1 + mfac * col2;
+          store_premul_pixel(col, dst);
+        }
       }
       src1 += 4;
       src2 += 4;
@@ -73,8 +133,22 @@ struct AlphaOverEffectOp {
   }
 
   float factor;
+  bool use_simd = true;
 };
 
+void alpha_over_effect_byte(const uchar *src1,
+                            const uchar *src2,
+                            uchar *dst,
+                            const int64_t size,
+                            const float fac,
+                            const bool use_simd)
+{
+  AlphaOverEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_alphaover_effect(const RenderData *context,
                                   SeqRenderState * /*state*/,
                                   Strip * /*strip*/,
@@ -111,11 +185,28 @@ struct AlphaUnderEffectOp {
         memcpy(dst, src2, sizeof(T) * 4);
       }
       else {
-        float4 col2 = load_premul_pixel(src2);
-        float mfac = fac * (1.0f - col2.w);
-        float4 col1 = load_premul_pixel(src1);
-        float4 col = mfac * col1 + col2;
-        store_premul_pixel(col, dst);
+#if BLI_HAVE_SSE2
+        if constexpr (std::is_same_v<T, float>) {
+          const __m128 col2 = _mm_loadu_ps(src2);
+          const __m128 mfac = _mm_set1_ps(fac * (1.0f - src2[3]));
+          const __m128 col1 = _mm_loadu_ps(src1);
+          _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(mfac, col1), col2));
+        }
+        else if (this->use_simd) {
+          const __m128 col2 = load_premul_pixel_sse2(src2);
+          const __m128 mfac = _mm_set1_ps(fac * (1.0f - src2[3] * (1.0f / 255.0f)));
+          const __m128 col1 = load_premul_pixel_sse2(src1);
+          store_premul_pixel_sse2(_mm_add_ps(_mm_mul_ps(mfac, col1), col2), dst);
+        }
+        else
+#endif
+        {
+          float4 col2 = load_premul_pixel(src2);
+          float mfac = fac * (1.0f - col2.w);
+          float4 col1 = load_premul_pixel(src1);
+          float4 col = mfac * col1 + col2;
+          store_premul_pixel(col, dst);
+        }
       }
       src1 += 4;
       src2 += 4;
@@ -123,8 +214,22 @@ struct AlphaUnderEffectOp {
     }
   }
   float factor;
+  bool use_simd = true;
 };
 
+void alpha_under_effect_byte(const uchar *src1,
+                             const uchar *src2,
+                             uchar *dst,
+                             const int64_t size,
+                             const float fac,
+                             const bool use_simd)
+{
+  AlphaUnderEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_alphaunder_effect(const RenderData *context,
                                    SeqRenderState * /*state*/,
                                    Strip * /*strip*/,
@@ -143,16 +248,269 @@ static ImBuf *do_alphaunder_effect(const RenderData *context,
 /* -------------------------------------------------------------------- */
 /* Blend Mode Effect */
 
-/* blend_function has to be: void (T* dst, const T *src1, const T *src2) */
-template<typename T, typename Func>
-static void apply_blend_function(
-    float fac, int64_t size, const T *src1, const T *src2, T *dst, Func blend_function)
+#if BLI_HAVE_SSE2
+/* Divide 16-bit unsigned integers by 255, rounding down. */
+static __m128i div255_epu16(const __m128i x)
+{
+  return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(short(0x8081))), 7);
+}
+
+/**
+ * Apply a blend mode to four byte pixels at a time. The given function blends two pixels of each
+ * input given as 16-bit channels, with the faded alpha of the second input broadcast to the
+ * channels of each pixel. Only factors from zero to one are handled, for which the faded alpha
+ * fits in a byte like in the scalar code.
+ */
+template<typename BlendFn>
+static int64_t blend_byte_sse2(const float fac,
+                               const int64_t size,
+                               const uchar *src1,
+                               const uchar *src2,
+                               uchar *dst,
+                               const BlendFn &blend)
+{
+  if (!(fac >= 0.0f && fac <= 1.0f)) {
+    return 0;
+  }
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 vfac = _mm_set1_ps(fac);
+  int64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx * 4));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + idx * 4));
+    /* Fade the alpha of the second input, truncating like the conversion of the scalar code. */
+    const __m128i t32 = _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(b, 24)), vfac));
+    const __m128i t16 = _mm_packs_epi32(t32, t32);
+    const __m128i t_pairs = _mm_unpacklo_epi16(t16, t16);
+    const __m128i lo = blend(_mm_unpacklo_epi8(a, zero),
+                             _mm_unpacklo_epi8(b, zero),
+                             _mm_unpacklo_epi32(t_pairs, t_pairs));
+    const __m128i hi = blend(_mm_unpackhi_epi8(a, zero),
+                             _mm_unpackhi_epi8(b, zero),
+                             _mm_unpackhi_epi32(t_pairs, t_pairs));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx * 4),
+                     keep_alpha_epu8(_mm_packus_epi16(lo, hi), a));
+  }
+  return idx;
+}
+
+/**
+ * Apply a blend mode to one float pixel at a time. The given function blends the pixels of both
+ * inputs with the faded alpha of the second input. Pixels with a faded alpha of zero are copied
+ * from the first input, like in the scalar code.
+ */
+template<typename BlendFn>
+static int64_t blend_float_sse2(const float fac,
+                                const int64_t size,
+                                const float *src1,
+                                const float *src2,
+                                float *dst,
+                                const BlendFn &blend)
+{
+  for (int64_t idx = 0; idx < size; idx++) {
+    const float t = src2[idx * 4 + 3] * fac;
+    if (t == 0.0f) {
+      memcpy(dst + idx * 4, src1 + idx * 4, sizeof(float) * 4);
+      continue;
+    }
+    const __m128 a = _mm_loadu_ps(src1 + idx * 4);
+    const __m128 b = _mm_loadu_ps(src2 + idx * 4);
+    _mm_storeu_ps(dst + idx * 4, keep_alpha_ps(blend(a, b, t), a));
+  }
+  return size;
+}
+
+/* `(mt * a + t * b) / 255` rounded to the nearest integer, like the lighten and darken modes. */
+static __m128i mix_round_epi16(const __m128i a, const __m128i b, const __m128i t)
+{
+  const __m128i mt = _mm_sub_epi16(_mm_set1_epi16(255), t);
+  const __m128i sum = _mm_add_epi16(_mm_mullo_epi16(mt, a), _mm_mullo_epi16(t, b));
+  return div255_epu16(_mm_add_epi16(sum, _mm_set1_epi16(127)));
+}
+
+/* `(mt * a + t * b) / 255` rounded down, like the screen and overlay modes. */
+static __m128i mix_floor_epi16(const __m128i a, const __m128i b, const __m128i t)
+{
+  const __m128i mt = _mm_sub_epi16(_mm_set1_epi16(255), t);
+  return div255_epu16(_mm_add_epi16(_mm_mullo_epi16(mt, a), _mm_mullo_epi16(t, b)));
+}
+
+static __m128 mix_ps(const __m128 a, const __m128 b, const float t)
+{
+  return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0f - t), a), _mm_mul_ps(_mm_set1_ps(t), b));
+}
+
+/* `t * b + (1 - t) * a`, in the order of operations of the screen and overlay modes. */
+static __m128 mix_fac_first_ps(const __m128 a, const __m128 b, const float t)
+{
+  return _mm_add_ps(_mm_mul_ps(b, _mm_set1_ps(t)), _mm_mul_ps(a, _mm_set1_ps(1.0f - t)));
+}
+
+/**
+ * SSE2 kernels of blend modes, for the modes that are commonly used to composite strips. The
+ * kernels do the same operations as the scalar blend functions, byte kernels give the same
+ * results. #apply processes as many pixels as it can and returns their number, the remaining
+ * pixels are processed by the scalar blend function.
+ */
+template<auto blend_function> struct BlendModeSSE2 {
+  static constexpr bool is_supported = false;
+};
+
+template<> struct BlendModeSSE2<blend_color_lighten_byte> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const uchar *src1, const uchar *src2, uchar *dst)
+  {
+    return blend_byte_sse2(fac, size, src1, src2, dst, [](__m128i a, __m128i b, __m128i t) {
+      return mix_round_epi16(a, _mm_max_epi16(a, b), t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_darken_byte> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const uchar *src1, const uchar *src2, uchar *dst)
+  {
+    return blend_byte_sse2(fac, size, src1, src2, dst, [](__m128i a, __m128i b, __m128i t) {
+      return mix_round_epi16(a, _mm_min_epi16(a, b), t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_screen_byte> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const uchar *src1, const uchar *src2, uchar *dst)
+  {
+    return blend_byte_sse2(fac, size, src1, src2, dst, [](__m128i a, __m128i b, __m128i t) {
+      const __m128i v255 = _mm_set1_epi16(255);
+      const __m128i product = _mm_mullo_epi16(_mm_sub_epi16(v255, a), _mm_sub_epi16(v255, b));
+      return mix_floor_epi16(a, _mm_sub_epi16(v255, div255_epu16(product)), t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_overlay_byte> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const uchar *src1, const uchar *src2, uchar *dst)
+  {
+    return blend_byte_sse2(fac, size, src1, src2, dst, [](__m128i a, __m128i b, __m128i t) {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i v255 = _mm_set1_epi16(255);
+      /* For bright colors of the first input, `255 - (509 - 2 * a) * (255 - b) / 255`. The
+       * scalar code divides a negative product when `a` is 255, which rounds towards zero and
+       * only gives a non-zero quotient of -1 when `b` is zero. */
+      const __m128i bright_fac = _mm_max_epi16(
+          _mm_sub_epi16(_mm_set1_epi16(509), _mm_add_epi16(a, a)), zero);
+      const __m128i negative_product = _mm_and_si128(_mm_cmpeq_epi16(a, v255),
+                                                     _mm_cmpeq_epi16(b, zero));
+      const __m128i bright = _mm_sub_epi16(
+          _mm_sub_epi16(v255,
+                        div255_epu16(_mm_mullo_epi16(bright_fac, _mm_sub_epi16(v255, b)))),
+          negative_product);
+      /* For dark colors, `(2 * a * b) >> 8`. */
+      const __m128i dark = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(a, a), b), 8);
+      const __m128i is_bright = _mm_cmpgt_epi16(a, _mm_set1_epi16(127));
+      const __m128i overlay = _mm_or_si128(_mm_and_si128(is_bright, bright),
+                                           _mm_andnot_si128(is_bright, dark));
+      return _mm_min_epi16(mix_floor_epi16(a, overlay, t), v255);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_lighten_float> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const float *src1, const float *src2, float *dst)
+  {
+    return blend_float_sse2(fac, size, src1, src2, dst, [](__m128 a, __m128 b, float t) {
+      /* Remap the second input to the alpha of the first one. */
+      const __m128 map_alpha = _mm_set1_ps(_mm_cvtss_f32(_mm_shuffle_ps(a, a, 3)) / t);
+      return mix_ps(a, _mm_max_ps(a, _mm_mul_ps(b, map_alpha)), t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_darken_float> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const float *src1, const float *src2, float *dst)
+  {
+    return blend_float_sse2(fac, size, src1, src2, dst, [](__m128 a, __m128 b, float t) {
+      /* Remap the second input to the alpha of the first one. */
+      const __m128 map_alpha = _mm_set1_ps(_mm_cvtss_f32(_mm_shuffle_ps(a, a, 3)) / t);
+      return mix_ps(a, _mm_min_ps(a, _mm_mul_ps(b, map_alpha)), t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_screen_float> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const float *src1, const float *src2, float *dst)
+  {
+    return blend_float_sse2(fac, size, src1, src2, dst, [](__m128 a, __m128 b, float t) {
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 screen = _mm_max_ps(
+          _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(one, a), _mm_sub_ps(one, b))), _mm_setzero_ps());
+      return mix_fac_first_ps(a, screen, t);
+    });
+  }
+};
+
+template<> struct BlendModeSSE2<blend_color_overlay_float> {
+  static constexpr bool is_supported = true;
+  static int64_t apply(
+      const float fac, const int64_t size, const float *src1, const float *src2, float *dst)
+  {
+    return blend_float_sse2(fac, size, src1, src2, dst, [](__m128 a, __m128 b, float t) {
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 half = _mm_set1_ps(0.5f);
+      const __m128 two = _mm_set1_ps(2.0f);
+      const __m128 bright = _mm_sub_ps(
+          one,
+          _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_sub_ps(a, half))), _mm_sub_ps(one, b)));
+      const __m128 dark = _mm_mul_ps(_mm_mul_ps(two, a), b);
+      const __m128 is_bright = _mm_cmpgt_ps(a, half);
+      const __m128 overlay = _mm_or_ps(_mm_and_ps(is_bright, bright),
+                                       _mm_andnot_ps(is_bright, dark));
+      return _mm_min_ps(mix_fac_first_ps(a, overlay, t), one);
+    });
+  }
+};
+#endif
+
+/* The blend function is a template parameter rather than a function pointer argument, so that
+ * it is inlined in the loop of each blend mode instead of being called indirectly per pixel. Modes
+ * that have an SSE2 kernel use it, unless `use_simd` is false. */
+template<typename T, void (*blend_function)(T *dst, const T *src1, const T *src2)>
+static void apply_blend_function(const float fac,
+                                 const int64_t size,
+                                 const T *src1,
+                                 const T *src2,
+                                 T *dst,
+                                 const bool use_simd)
 {
-  for (int64_t i = 0; i < size; i++) {
-    T achannel = src2[3];
-    (static_cast<T *>(const_cast<T *>(src2)))[3] = T(achannel * fac);
-    blend_function(dst, src1, src2);
-    (static_cast<T *>(const_cast<T *>(src2)))[3] = achannel;
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  if constexpr (BlendModeSSE2<blend_function>::is_supported) {
+    if (use_simd) {
+      i = BlendModeSSE2<blend_function>::apply(fac, size, src1, src2, dst);
+      src1 += i * 4;
+      src2 += i * 4;
+      dst += i * 4;
+    }
+  }
+#else
+  UNUSED_VARS(use_simd);
+#endif
+  for (; i < size; i++) {
+    /* The opacity is applied to the alpha of the blended color. */
+    const T faded_src2[4] = {src2[0], src2[1], src2[2], T(src2[3] * fac)};
+    blend_function(dst, src1, faded_src2);
     dst[3] = src1[3];
     src1 += 4;
     src2 += 4;
@@ -165,71 +523,86 @@ static void do_blend_effect_float(float fac,
                                   const float *rect1,
                                   const float *rect2,
                                   StripBlendMode btype,
-                                  float *out)
+                                  float *out,
+                                  const bool use_simd)
 {
   switch (btype) {
     case STRIP_BLEND_ADD:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_add_float);
+      apply_blend_function<float, blend_color_add_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SUB:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_sub_float);
+      apply_blend_function<float, blend_color_sub_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_MUL:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_mul_float);
+      apply_blend_function<float, blend_color_mul_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DARKEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_darken_float);
+      apply_blend_function<float, blend_color_darken_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_COLOR_BURN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_burn_float);
+      apply_blend_function<float, blend_color_burn_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LINEAR_BURN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_linearburn_float);
+      apply_blend_function<float, blend_color_linearburn_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SCREEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_screen_float);
+      apply_blend_function<float, blend_color_screen_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LIGHTEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_lighten_float);
+      apply_blend_function<float, blend_color_lighten_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DODGE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_dodge_float);
+      apply_blend_function<float, blend_color_dodge_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_OVERLAY:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_overlay_float);
+      apply_blend_function<float, blend_color_overlay_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SOFT_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_softlight_float);
+      apply_blend_function<float, blend_color_softlight_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_HARD_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_hardlight_float);
+      apply_blend_function<float, blend_color_hardlight_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_PIN_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_pinlight_float);
+      apply_blend_function<float, blend_color_pinlight_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LIN_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_linearlight_float);
+      apply_blend_function<float, blend_color_linearlight_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_VIVID_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_vividlight_float);
+      apply_blend_function<float, blend_color_vividlight_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_BLEND_COLOR:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_color_float);
+      apply_blend_function<float, blend_color_color_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_HUE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_hue_float);
+      apply_blend_function<float, blend_color_hue_float>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SATURATION:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_saturation_float);
+      apply_blend_function<float, blend_color_saturation_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_VALUE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_luminosity_float);
+      apply_blend_function<float, blend_color_luminosity_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DIFFERENCE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_difference_float);
+      apply_blend_function<float, blend_color_difference_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_EXCLUSION:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_exclusion_float);
+      apply_blend_function<float, blend_color_exclusion_float>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     default:
       break;
@@ -241,71 +614,84 @@ static void do_blend_effect_byte(float fac,
                                  const uchar *rect1,
                                  const uchar *rect2,
                                  StripBlendMode btype,
-                                 uchar *out)
+                                 uchar *out,
+                                 const bool use_simd)
 {
   switch (btype) {
     case STRIP_BLEND_ADD:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_add_byte);
+      apply_blend_function<uchar, blend_color_add_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SUB:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_sub_byte);
+      apply_blend_function<uchar, blend_color_sub_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_MUL:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_mul_byte);
+      apply_blend_function<uchar, blend_color_mul_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DARKEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_darken_byte);
+      apply_blend_function<uchar, blend_color_darken_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_COLOR_BURN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_burn_byte);
+      apply_blend_function<uchar, blend_color_burn_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LINEAR_BURN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_linearburn_byte);
+      apply_blend_function<uchar, blend_color_linearburn_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SCREEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_screen_byte);
+      apply_blend_function<uchar, blend_color_screen_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LIGHTEN:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_lighten_byte);
+      apply_blend_function<uchar, blend_color_lighten_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DODGE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_dodge_byte);
+      apply_blend_function<uchar, blend_color_dodge_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_OVERLAY:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_overlay_byte);
+      apply_blend_function<uchar, blend_color_overlay_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SOFT_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_softlight_byte);
+      apply_blend_function<uchar, blend_color_softlight_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_HARD_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_hardlight_byte);
+      apply_blend_function<uchar, blend_color_hardlight_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_PIN_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_pinlight_byte);
+      apply_blend_function<uchar, blend_color_pinlight_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_LIN_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_linearlight_byte);
+      apply_blend_function<uchar, blend_color_linearlight_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_VIVID_LIGHT:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_vividlight_byte);
+      apply_blend_function<uchar, blend_color_vividlight_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_BLEND_COLOR:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_color_byte);
+      apply_blend_function<uchar, blend_color_color_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_HUE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_hue_byte);
+      apply_blend_function<uchar, blend_color_hue_byte>(fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_SATURATION:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_saturation_byte);
+      apply_blend_function<uchar, blend_color_saturation_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_VALUE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_luminosity_byte);
+      apply_blend_function<uchar, blend_color_luminosity_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_DIFFERENCE:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_difference_byte);
+      apply_blend_function<uchar, blend_color_difference_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     case STRIP_BLEND_EXCLUSION:
-      apply_blend_function(fac, size, rect1, rect2, out, blend_color_exclusion_byte);
+      apply_blend_function<uchar, blend_color_exclusion_byte>(
+          fac, size, rect1, rect2, out, use_simd);
       break;
     default:
       break;
@@ -316,16 +702,39 @@ struct BlendModeEffectOp {
   template<typename T> void apply(const T *src1, const T *src2, T *dst, int64_t size) const
   {
     if constexpr (std::is_same_v<T, float>) {
-      do_blend_effect_float(this->factor, size, src1, src2, this->blend_mode, dst);
+      do_blend_effect_float(this->factor, size, src1, src2, this->blend_mode, dst, this->use_simd);
     }
     else {
-      do_blend_effect_byte(this->factor, size, src1, src2, this->blend_mode, dst);
+      do_blend_effect_byte(this->factor, size, src1, src2, this->blend_mode, dst, this->use_simd);
     }
   }
   StripBlendMode blend_mode;
   float factor;
+  bool use_simd = true;
 };
 
+void blend_mode_effect_byte(const uchar *src1,
+                            const uchar *src2,
+                            uchar *dst,
+                            const int64_t size,
+                            const float fac,
+                            const StripBlendMode blend_mode,
+                            const bool use_simd)
+{
+  do_blend_effect_byte(fac, size, src1, src2, blend_mode, dst, use_simd);
+}
+
+void blend_mode_effect_float(const float *src1,
+                             const float *src2,
+                             float *dst,
+                             const int64_t size,
+                             const float fac,
+                             const StripBlendMode blend_mode,
+                             const bool use_simd)
+{
+  do_blend_effect_float(fac, size, src1, src2, blend_mode, dst, use_simd);
+}
+
 static ImBuf *do_blend_mode_effect(const RenderData *context,
                                    SeqRenderState * /*state*/,
                                    Strip *strip,
@@ -0,0 +1,158 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstdlib>
+
+#include "BLI_array.hh"
+#include "BLI_rand.hh"
+
+#include "effects.hh"
+
+namespace blender::seq::tests {
+
+using EffectByteFn = void (*)(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd);
+
+/* Byte effect of a blend mode, for comparing blend modes like the other effects. */
+template<StripBlendMode blend_mode>
+static void blend_mode_byte(
+    const uchar *src1, const uchar *src2, uchar *dst, int64_t size, float fac, bool use_simd)
+{
+  blend_mode_effect_byte(src1, src2, dst, size, fac, blend_mode, use_simd);
+}
+
+/**
+ * Compare the SIMD and the scalar code for all factors the SIMD kernels support, and for sizes
+ * that are not a multiple of the four pixels the byte kernels process at once. Effects that go
+ * through float colors may differ by `max_difference`, because the scalar code may be compiled
+ * to fused multiply-add instructions.
+ */
+static void test_simd_matches_scalar(const EffectByteFn effect_fn, const int max_difference = 0)
+{
+  const int64_t max_size = 67;
+  RandomNumberGenerator rng(42);
+  Array<uchar> src1(max_size * 4);
+  Array<uchar> src2(max_size * 4);
+  for (const int64_t i : src1.index_range()) {
+    src1[i] = uchar(rng.get_uint32() & 0xFF);
+    src2[i] = uchar(rng.get_uint32() & 0xFF);
+  }
+  /* Include the extreme values, which are the most likely to overflow. */
+  for (const int64_t i : IndexRange(4)) {
+    src1[i] = 255;
+    src2[i] = 255;
+    src1[4 + i] = 0;
+    src2[4 + i] = 255;
+    src1[8 + i] = 255;
+    src2[8 + i] = 0;
+  }
+
+  Array<uchar> simd_result(max_size * 4);
+  Array<uchar> scalar_result(max_size * 4);
+  for (const int64_t size : {int64_t(1), int64_t(2), int64_t(3), int64_t(4), int64_t(7), max_size})
+  {
+    for (const int ifac : IndexRange(257)) {
+      const float fac = ifac / 256.0f;
+      simd_result.fill(0);
+      scalar_result.fill(0);
+      effect_fn(src1.data(), src2.data(), simd_result.data(), size, fac, true);
+      effect_fn(src1.data(), src2.data(), scalar_result.data(), size, fac, false);
+      for (const int64_t i : IndexRange(size * 4)) {
+        ASSERT_LE(std::abs(int(simd_result[i]) - int(scalar_result[i])), max_difference)
+            << "factor " << ifac << "/256, size " << size << ", pixel " << i / 4 << ", channel "
+            << i % 4;
+      }
+    }
+  }
+}
+
+TEST(vse_effect_byte, cross)
+{
+  test_simd_matches_scalar(cross_effect_byte);
+}
+
+TEST(vse_effect_byte, add)
+{
+  test_simd_matches_scalar(add_effect_byte);
+}
+
+TEST(vse_effect_byte, sub)
+{
+  test_simd_matches_scalar(sub_effect_byte);
+}
+
+TEST(vse_effect_byte, mul)
+{
+  test_simd_matches_scalar(mul_effect_byte);
+}
+
+TEST(vse_effect_byte, alpha_over)
+{
+  test_simd_matches_scalar(alpha_over_effect_byte, 1);
+}
+
+TEST(vse_effect_byte, alpha_under)
+{
+  test_simd_matches_scalar(alpha_under_effect_byte, 1);
+}
+
+TEST(vse_effect_byte, blend_mode_screen)
+{
+  test_simd_matches_scalar(blend_mode_byte<STRIP_BLEND_SCREEN>);
+}
+
+TEST(vse_effect_byte, blend_mode_overlay)
+{
+  test_simd_matches_scalar(blend_mode_byte<STRIP_BLEND_OVERLAY>);
+}
+
+TEST(vse_effect_byte, blend_mode_darken)
+{
+  test_simd_matches_scalar(blend_mode_byte<STRIP_BLEND_DARKEN>);
+}
+
+TEST(vse_effect_byte, blend_mode_lighten)
+{
+  test_simd_matches_scalar(blend_mode_byte<STRIP_BLEND_LIGHTEN>);
+}
+
+/* The float kernels of blend modes do the same operations as the scalar code, up to fused
+ * multiply-add instructions the scalar code may be compiled to. Colors outside of the zero to
+ * one range and pixels with zero alpha are included. */
+TEST(vse_effect_float, blend_modes)
+{
+  const int64_t size = 67;
+  RandomNumberGenerator rng(42);
+  Array<float> src1(size * 4);
+  Array<float> src2(size * 4);
+  for (const int64_t i : src1.index_range()) {
+    src1[i] = rng.get_float() * 1.5f - 0.2f;
+    src2[i] = rng.get_float() * 1.5f - 0.2f;
+  }
+  src1[3] = 0.0f;
+  src2[7] = 0.0f;
+
+  Array<float> simd_result(size * 4);
+  Array<float> scalar_result(size * 4);
+  for (const StripBlendMode blend_mode :
+       {STRIP_BLEND_SCREEN, STRIP_BLEND_OVERLAY, STRIP_BLEND_DARKEN, STRIP_BLEND_LIGHTEN})
+  {
+    for (const int ifac : IndexRange(17)) {
+      const float fac = ifac / 16.0f;
+      blend_mode_effect_float(
+          src1.data(), src2.data(), simd_result.data(), size, fac, blend_mode, true);
+      blend_mode_effect_float(
+          src1.data(), src2.data(), scalar_result.data(), size, fac, blend_mode, false);
+      for (const int64_t i : IndexRange(size * 4)) {
+        ASSERT_NEAR(simd_result[i], scalar_result[i], 1e-6f)
+            << "blend mode " << int(blend_mode) << ", factor " << ifac << "/16, pixel " << i / 4
+            << ", channel " << i % 4;
+      }
+    }
+  }
+}
+
+}  // namespace blender::seq::tests
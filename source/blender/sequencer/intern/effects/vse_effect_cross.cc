@@ -6,6 +6,8 @@
  * \ingroup sequencer
  */
 
+#include "BLI_simd.hh"
+
 #include "DNA_sequence_types.h"
 
 #include "IMB_imbuf.hh"
@@ -16,6 +18,49 @@
 
 namespace blender::seq {
 
+#if BLI_HAVE_SSE2
+/* Cross four pixels at a time, returns the number of pixels that were processed. */
+static int64_t cross_sse2(
+    const uchar *src1, const uchar *src2, uchar *dst, const int64_t size, const int ifac)
+{
+  if (ifac < 0 || ifac > 256) {
+    /* The weighted sum does not fit in 16 bits. */
+    return 0;
+  }
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i fac = _mm_set1_epi16(short(ifac));
+  const __m128i mfac = _mm_set1_epi16(short(256 - ifac));
+  int64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx * 4));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + idx * 4));
+    const __m128i lo = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), mfac),
+                      _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), fac)),
+        8);
+    const __m128i hi = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), mfac),
+                      _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), fac)),
+        8);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx * 4), _mm_packus_epi16(lo, hi));
+  }
+  return idx;
+}
+
+static int64_t cross_sse2(
+    const float *src1, const float *src2, float *dst, const int64_t size, const float factor)
+{
+  const __m128 fac = _mm_set1_ps(factor);
+  const __m128 mfac = _mm_set1_ps(1.0f - factor);
+  for (int64_t idx = 0; idx < size; idx++) {
+    const __m128 a = _mm_loadu_ps(src1 + idx * 4);
+    const __m128 b = _mm_loadu_ps(src2 + idx * 4);
+    _mm_storeu_ps(dst + idx * 4, _mm_add_ps(_mm_mul_ps(mfac, a), _mm_mul_ps(fac, b)));
+  }
+  return size;
+}
+#endif
+
 struct CrossEffectOp {
   template<typename T> void apply(const T *src1, const T *src2, T *dst, int64_t size) const
   {
@@ -23,7 +68,21 @@ struct CrossEffectOp {
     const float mfac = 1.0f - fac;
     const int ifac = int(256.0f * fac);
     const int imfac = 256 - ifac;
-    for (int64_t idx = 0; idx < size; idx++) {
+    int64_t idx = 0;
+#if BLI_HAVE_SSE2
+    if (this->use_simd) {
+      if constexpr (std::is_same_v<T, uchar>) {
+        idx = cross_sse2(src1, src2, dst, size, ifac);
+      }
+      else {
+        idx = cross_sse2(src1, src2, dst, size, fac);
+      }
+      src1 += idx * 4;
+      src2 += idx * 4;
+      dst += idx * 4;
+    }
+#endif
+    for (; idx < size; idx++) {
       if constexpr (std::is_same_v<T, uchar>) {
         dst[0] = (imfac * src1[0] + ifac * src2[0]) >> 8;
         dst[1] = (imfac * src1[1] + ifac * src2[1]) >> 8;
@@ -42,8 +101,22 @@ struct CrossEffectOp {
     }
   }
   float factor;
+  bool use_simd = true;
 };
 
+void cross_effect_byte(const uchar *src1,
+                       const uchar *src2,
+                       uchar *dst,
+                       const int64_t size,
+                       const float fac,
+                       const bool use_simd)
+{
+  CrossEffectOp op;
+  op.factor = fac;
+  op.use_simd = use_simd;
+  op.apply(src1, src2, dst, size);
+}
+
 static ImBuf *do_cross_effect(const RenderData *context,
                               SeqRenderState * /*state*/,
                               Strip * /*strip*/,
@@ -6,6 +6,11 @@
  * \ingroup sequencer
  */
 
+#include <cstring>
+
+#include "BLI_bounds.hh"
+#include "BLI_task.hh"
+
 #include "BLT_translation.hh"
 
 #include "COM_context.hh"
@@ -97,6 +102,35 @@ class CompositorContext : public compositor::Context {
     return compositor::Domain(int2(image_buffer_->x, image_buffer_->y));
   }
 
+  /* The strip crop is applied to the image after all modifiers, so the cropped pixels are never
+   * displayed and need not be computed. That is, unless another modifier follows this one, since
+   * it might read them. */
+  Bounds<int2> get_region_of_interest() const override
+  {
+    const Bounds<int2> image_region = compositor::Context::get_region_of_interest();
+    for (const StripModifierData *modifier = modifier_data_->modifier.next; modifier;
+         modifier = modifier->next)
+    {
+      if (!(modifier->flag & STRIP_MODIFIER_FLAG_MUTE)) {
+        return image_region;
+      }
+    }
+
+    /* The crop is scaled down for proxies and preview sizes, using the smallest possible scale
+     * gives the largest region, which is always enough. */
+    const StripCrop &crop = *strip_->data->crop;
+    const float crop_scale = math::min(1.0f, get_render_scale_factor(render_data_));
+    const int2 size = int2(image_buffer_->x, image_buffer_->y);
+    const int2 crop_min = int2(int(crop.left * crop_scale), int(crop.bottom * crop_scale));
+    const int2 crop_max = size - int2(int(crop.right * crop_scale), int(crop.top * crop_scale));
+
+    /* Interpolation of the strip transform reads up to two pixels outside of the crop. */
+    const int filter_margin = 2;
+    const std::optional<Bounds<int2>> crop_region = bounds::intersect(
+        image_region, Bounds<int2>(crop_min - filter_margin, crop_max + filter_margin));
+    return crop_region ? *crop_region : image_region;
+  }
+
   void write_output(const compositor::Result &result)
   {
     /* Do not write the output if the viewer output was already written. */
@@ -110,6 +144,14 @@ class CompositorContext : public compositor::Context {
     }
 
     result_translation_ = result.domain().transformation.location();
+    const int2 image_size = int2(image_buffer_->x, image_buffer_->y);
+    if (result.domain().display_size == image_size &&
+        result.domain().data_size != result.domain().display_size)
+    {
+      this->write_data_window(result);
+      return;
+    }
+
     const int output_size_x = result.domain().data_size.x;
     const int output_size_y = result.domain().data_size.y;
     if (output_size_x != image_buffer_->x || output_size_y != image_buffer_->y) {
@@ -125,6 +167,35 @@ class CompositorContext : public compositor::Context {
                 IMB_get_pixel_count(image_buffer_) * sizeof(float) * 4);
   }
 
+  /* Write a result that was only computed in its data window, typically because of the region of
+   * interest. Pixels outside of the data window are cleared, and parts of the data window outside
+   * of the image, like overscan or a negative data offset, are skipped. */
+  void write_data_window(const compositor::Result &result)
+  {
+    const int2 image_size = int2(image_buffer_->x, image_buffer_->y);
+    const int2 data_offset = result.domain().data_offset;
+    const int2 data_size = result.domain().data_size;
+    const int x_start = math::clamp(data_offset.x, 0, image_size.x);
+    const int x_end = math::clamp(data_offset.x + data_size.x, x_start, image_size.x);
+    const float *data = static_cast<const float *>(result.cpu_data().data());
+    float *image = image_buffer_->float_buffer.data;
+    threading::parallel_for(IndexRange(image_size.y), 64, [&](const IndexRange rows) {
+      for (const int y : rows) {
+        float *image_row = image + size_t(y) * image_size.x * 4;
+        const int data_y = y - data_offset.y;
+        if (data_y < 0 || data_y >= data_size.y || x_start == x_end) {
+          std::memset(image_row, 0, sizeof(float) * 4 * image_size.x);
+          continue;
+        }
+        std::memset(image_row, 0, sizeof(float) * 4 * x_start);
+        std::memcpy(image_row + x_start * 4,
+                    data + (size_t(data_y) * data_size.x + (x_start - data_offset.x)) * 4,
+                    sizeof(float) * 4 * (x_end - x_start));
+        std::memset(image_row + x_end * 4, 0, sizeof(float) * 4 * (image_size.x - x_end));
+      }
+    });
+  }
+
   void write_viewer(compositor::Result &viewer_result) override
   {
     using namespace compositor;
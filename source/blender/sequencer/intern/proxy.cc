@@ -8,6 +8,8 @@
  * \ingroup sequencer
  */
 
+#include <atomic>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -17,6 +19,8 @@
 #include "BLI_math_base.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -49,8 +53,12 @@
 #include "sequencer.hh"
 #include "utils.hh"
 
+#include "CLG_log.h"
+
 namespace blender::seq {
 
+static CLG_LogRef LOG = {"seq.proxy"};
+
 struct ProxyBuildContext {
   MovieProxyBuilder *movie_proxy_builder = nullptr;
 
@@ -521,7 +529,7 @@ static ImBuf *render_image_strip_frame(const ProxyBuildContext &context,
 {
   ImBuf *ibuf = nullptr;
 
-  int flag = IB_byte_data | IB_metadata | IB_multilayer;
+  int flag = IB_byte_data | IB_metadata | IB_multilayer | IB_multilayer_combined_only;
   if (strip.alpha_mode == SEQ_ALPHA_PREMUL) {
     flag |= IB_alphamode_premul;
   }
@@ -547,6 +555,79 @@ static ImBuf *render_image_strip_frame(const ProxyBuildContext &context,
   return ibuf;
 }
 
+/* Load a single image of the strip and save its proxies. */
+static void image_proxy_build_elem(const ProxyBuildContext &context,
+                                   const Strip &strip,
+                                   const int elem_index,
+                                   const char *base_path,
+                                   const int tot_views)
+{
+  const StripElem &s_elem = strip.data->stripdata[elem_index];
+
+  char filepath[FILE_MAX];
+  const char *ext = nullptr;
+  char prefix[FILE_MAX];
+
+  ImBuf *ibuf = nullptr;
+
+  BLI_path_join(filepath, sizeof(filepath), strip.data->dirpath, s_elem.filename);
+  BLI_path_abs(filepath, base_path);
+
+  const int totfiles = seq_num_files(context.scene, strip.views_format, true);
+  bool is_multiview_render = seq_image_strip_is_multiview_render(
+      context.scene, &strip, totfiles, filepath, prefix, ext);
+
+  if (is_multiview_render) {
+    Array<ImBuf *> ibufs_arr(tot_views, nullptr);
+
+    for (int view_id = 0; view_id < totfiles; view_id++) {
+      ibufs_arr[view_id] = render_image_strip_frame(
+          context, strip, filepath, prefix, ext, view_id);
+    }
+
+    if (ibufs_arr[0] != nullptr) {
+      if (strip.views_format == R_IMF_VIEWS_STEREO_3D) {
+        IMB_ImBufFromStereo3d(strip.stereo3d_format, ibufs_arr[0], &ibufs_arr[0], &ibufs_arr[1]);
+      }
+
+      /* Return the requested image; release the others. */
+      ibuf = ibufs_arr[context.view_id];
+      for (ImBuf *ib : ibufs_arr) {
+        if (ib != ibuf) {
+          IMB_freeImBuf(ib);
+        }
+      }
+      if (ibuf) {
+        seq_imbuf_assign_spaces(context.scene, ibuf);
+      }
+    }
+  }
+  else {
+    ibuf = render_image_strip_frame(context, strip, filepath, prefix, ext, context.view_id);
+  }
+
+  if (ibuf != nullptr) {
+    if (context.size_flags & IMB_PROXY_25) {
+      seq_proxy_build_frame(
+          context.scene, context.view_id, ibuf, strip, s_elem, 25, context.overwrite);
+    }
+    if (context.size_flags & IMB_PROXY_50) {
+      seq_proxy_build_frame(
+          context.scene, context.view_id, ibuf, strip, s_elem, 50, context.overwrite);
+    }
+    if (context.size_flags & IMB_PROXY_75) {
+      seq_proxy_build_frame(
+          context.scene, context.view_id, ibuf, strip, s_elem, 75, context.overwrite);
+    }
+    if (context.size_flags & IMB_PROXY_100) {
+      seq_proxy_build_frame(
+          context.scene, context.view_id, ibuf, strip, s_elem, 100, context.overwrite);
+    }
+
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static void image_proxy_builder_process(ProxyBuildContext &context,
                                         const bool *job_stop,
                                         bool *job_update_ui,
@@ -568,83 +649,37 @@ static void image_proxy_builder_process(ProxyBuildContext &context,
 
   const char *base_path = ID_BLEND_PATH_FROM_GLOBAL(&context.scene->id);
   const int tot_views = BKE_scene_multiview_num_views_get(&context.scene->r);
-
-  for (int elem_index = 0; elem_index < strip.len; elem_index++) {
-    const StripElem &s_elem = strip.data->stripdata[elem_index];
-
-    char filepath[FILE_MAX];
-    const char *ext = nullptr;
-    char prefix[FILE_MAX];
-
-    ImBuf *ibuf = nullptr;
-
-    BLI_path_join(filepath, sizeof(filepath), strip.data->dirpath, s_elem.filename);
-    BLI_path_abs(filepath, base_path);
-
-    const int totfiles = seq_num_files(context.scene, strip.views_format, true);
-    bool is_multiview_render = seq_image_strip_is_multiview_render(
-        context.scene, &strip, totfiles, filepath, prefix, ext);
-
-    if (is_multiview_render) {
-      Array<ImBuf *> ibufs_arr(tot_views, nullptr);
-
-      for (int view_id = 0; view_id < totfiles; view_id++) {
-        ibufs_arr[view_id] = render_image_strip_frame(
-            context, strip, filepath, prefix, ext, view_id);
-      }
-
-      if (ibufs_arr[0] != nullptr) {
-        if (strip.views_format == R_IMF_VIEWS_STEREO_3D) {
-          IMB_ImBufFromStereo3d(strip.stereo3d_format, ibufs_arr[0], &ibufs_arr[0], &ibufs_arr[1]);
-        }
-
-        /* Return the requested image; release the others. */
-        ibuf = ibufs_arr[context.view_id];
-        for (ImBuf *ib : ibufs_arr) {
-          if (ib != ibuf) {
-            IMB_freeImBuf(ib);
-          }
-        }
-        if (ibuf) {
-          seq_imbuf_assign_spaces(context.scene, ibuf);
-        }
-      }
-    }
-    else {
-      ibuf = render_image_strip_frame(context, strip, filepath, prefix, ext, context.view_id);
-    }
-
-    if (ibuf != nullptr) {
-      if (context.size_flags & IMB_PROXY_25) {
-        seq_proxy_build_frame(
-            context.scene, context.view_id, ibuf, strip, s_elem, 25, context.overwrite);
-      }
-      if (context.size_flags & IMB_PROXY_50) {
-        seq_proxy_build_frame(
-            context.scene, context.view_id, ibuf, strip, s_elem, 50, context.overwrite);
-      }
-      if (context.size_flags & IMB_PROXY_75) {
-        seq_proxy_build_frame(
-            context.scene, context.view_id, ibuf, strip, s_elem, 75, context.overwrite);
-      }
-      if (context.size_flags & IMB_PROXY_100) {
-        seq_proxy_build_frame(
-            context.scene, context.view_id, ibuf, strip, s_elem, 100, context.overwrite);
+  const double start_time = BLI_time_now_seconds();
+
+  /* Images are independent of each other, so load, scale and save multiple at the same time. */
+  std::atomic<int> frames_done = 0;
+  threading::parallel_for(IndexRange(strip.len), 1, [&](const IndexRange elem_range) {
+    for (const int elem_index : elem_range) {
+      if (*job_stop || G.is_break) {
+        return;
       }
+      image_proxy_build_elem(context, strip, elem_index, base_path, tot_views);
 
+      const int done = frames_done.fetch_add(1) + 1;
       if (set_progress_fn) {
-        float progress = float(elem_index) / float(strip.len);
-        set_progress_fn(progress);
+        set_progress_fn(float(done) / float(strip.len));
       }
-
-      *job_update_ui = true;
-
-      IMB_freeImBuf(ibuf);
     }
+  });
 
-    if (*job_stop || G.is_break) {
-      break;
-    }
+  /* Set from this thread only, the flag is not safe to write from multiple threads. */
+  if (frames_done > 0) {
+    *job_update_ui = true;
+  }
+
+  if (!*job_stop && !G.is_break) {
+    const double duration = BLI_time_now_seconds() - start_time;
+    CLOG_INFO(&LOG,
+              "Built proxies for strip '%s': %d frames in %.2f s (%.1f frames/s)",
+              strip.name + 2,
+              strip.len,
+              duration,
+              duration > 0.0 ? strip.len / duration : 0.0);
   }
 }
 
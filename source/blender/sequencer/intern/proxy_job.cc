@@ -8,12 +8,19 @@
  * \ingroup sequencer
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_threads.h"
+#include "BLI_time.h"
 
 #include "BKE_context.hh"
 
@@ -24,33 +31,119 @@
 #include "WM_api.hh"
 #include "WM_types.hh"
 
+#include "CLG_log.h"
+
 namespace blender::seq {
 
+static CLG_LogRef LOG = {"seq.proxy"};
+
+/**
+ * Maximum number of files to build proxies for at the same time. Decoding and encoding a file
+ * already uses multiple threads, but not enough to keep all cores busy, especially for small
+ * files and image sequences.
+ */
+static constexpr int max_concurrent_files = 8;
+
+/** State shared by the threads that build the proxies of the job's queue. */
+struct ProxyJobWorkers {
+  ProxyJob *pj;
+  wmJobWorkerStatus *worker_status;
+  /** Index of the next queue item to build. */
+  std::atomic<int> next_index = 0;
+
+  std::mutex progress_mutex;
+  Array<float> progress;
+};
+
 static void proxy_freejob(void *pjv)
 {
   ProxyJob *pj = static_cast<ProxyJob *>(pjv);
   MEM_delete(pj);
 }
 
+static void proxy_job_set_progress(ProxyJobWorkers &workers, const int index, const float progress)
+{
+  std::lock_guard lock(workers.progress_mutex);
+  workers.progress[index] = progress;
+
+  /* Remap the progress of all proxies to the total progress. */
+  float total_progress = 0.0f;
+  for (const float item_progress : workers.progress) {
+    total_progress += item_progress;
+  }
+  workers.worker_status->progress = total_progress / workers.progress.size();
+  /* Only set while holding the lock, the workers would race on it otherwise. */
+  workers.worker_status->do_update = true;
+}
+
+static void proxy_job_process_queue(ProxyJobWorkers &workers)
+{
+  ProxyJob *pj = workers.pj;
+  wmJobWorkerStatus *worker_status = workers.worker_status;
+
+  while (!worker_status->stop) {
+    const int i = workers.next_index.fetch_add(1);
+    if (i >= pj->queue.size()) {
+      break;
+    }
+
+    /* The UI is updated through the progress, which is set with the lock held. */
+    bool has_updated = false;
+    proxy_build_process(
+        pj->queue[i],
+        &worker_status->stop,
+        &has_updated,
+        [&](const float new_progress) { proxy_job_set_progress(workers, i, new_progress); });
+    proxy_job_set_progress(workers, i, 1.0f);
+  }
+}
+
+static void *proxy_job_worker_thread(void *workers_v)
+{
+  proxy_job_process_queue(*static_cast<ProxyJobWorkers *>(workers_v));
+  return nullptr;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, wmJobWorkerStatus *worker_status)
 {
   ProxyJob *pj = static_cast<ProxyJob *>(pjv);
-  for (const int i : pj->queue.index_range()) {
-    ProxyBuildContext *context = pj->queue[i];
-    proxy_build_process(
-        context, &worker_status->stop, &worker_status->do_update, [&](const float new_progress) {
-          /* Remap the progress of the current proxy to the total progress. */
-          const float total_progress = (i + new_progress) / pj->queue.size();
-          worker_status->progress = total_progress;
-        });
-
-    if (worker_status->stop) {
-      pj->stop = true;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
-      break;
+  if (pj->queue.is_empty()) {
+    return;
+  }
+
+  const double start_time = BLI_time_now_seconds();
+
+  ProxyJobWorkers workers;
+  workers.pj = pj;
+  workers.worker_status = worker_status;
+  workers.progress = Array<float>(pj->queue.size(), 0.0f);
+
+  /* Build the proxies of multiple files at the same time, using about a quarter of the cores as
+   * budget since every file uses multiple threads. This thread builds proxies as well. */
+  const int threads_num = std::clamp(
+      BLI_system_thread_count() / 4, 1, std::min<int>(pj->queue.size(), max_concurrent_files));
+  ListBaseT<ThreadSlot> threads = {};
+  if (threads_num > 1) {
+    BLI_threadpool_init(&threads, proxy_job_worker_thread, threads_num - 1);
+    for (int i = 1; i < threads_num; i++) {
+      BLI_threadpool_insert(&threads, &workers);
     }
   }
+  proxy_job_process_queue(workers);
+  BLI_threadpool_end(&threads);
+
+  if (worker_status->stop) {
+    pj->stop = true;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
+    return;
+  }
+
+  CLOG_INFO(&LOG,
+            "Built %d proxies in %.2f s, %d at a time",
+            int(pj->queue.size()),
+            BLI_time_now_seconds() - start_time,
+            threads_num);
 }
 
 static void proxy_endjob(void *pjv)
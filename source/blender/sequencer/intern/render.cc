@@ -843,6 +843,15 @@ void convert_multilayer_ibuf(ImBuf *ibuf)
 /**
  * Render individual view for multi-view or single (default view) for mono-view.
  */
+static int seq_image_strip_load_flags(const Strip *strip)
+{
+  int flag = IB_byte_data | IB_metadata | IB_multilayer | IB_multilayer_combined_only;
+  if (strip->alpha_mode == SEQ_ALPHA_PREMUL) {
+    flag |= IB_alphamode_premul;
+  }
+  return flag;
+}
+
 static ImBuf *seq_render_image_strip_view(const RenderData *context,
                                           Strip *strip,
                                           char *filepath,
@@ -852,10 +861,7 @@ static ImBuf *seq_render_image_strip_view(const RenderData *context,
 {
   ImBuf *ibuf = nullptr;
 
-  int flag = IB_byte_data | IB_metadata | IB_multilayer;
-  if (strip->alpha_mode == SEQ_ALPHA_PREMUL) {
-    flag |= IB_alphamode_premul;
-  }
+  const int flag = seq_image_strip_load_flags(strip);
 
   if (prefix[0] == '\0') {
     ibuf = IMB_load_image_from_filepath(filepath, flag, strip->data->colorspace_settings.name);
@@ -921,6 +927,45 @@ static ImBuf *create_missing_media_image(const RenderData *context, int width, i
   return ibuf;
 }
 
+/* Number of upcoming frames of image strips that are loaded in the background during playback. */
+static constexpr int image_strip_prefetch_frames = 4;
+
+/**
+ * Start loading the images of the frames following the given one in the playback direction, so
+ * they are decoded by the time playback reaches them.
+ */
+static void seq_image_strip_prefetch(const RenderData *context,
+                                     const Strip *strip,
+                                     const StripElem *s_elem,
+                                     const int timeline_frame)
+{
+  const int direction = context->is_playing_backwards ? -1 : 1;
+  const int flag = seq_image_strip_load_flags(strip);
+
+  for (int i = 1; i <= image_strip_prefetch_frames; i++) {
+    const int frame = timeline_frame + i * direction;
+    const StripElem *next_elem = render_give_stripelem(context->scene, strip, frame);
+    if (next_elem == nullptr) {
+      break;
+    }
+    /* Slowed down strips and still frames at the ends show the same image for several frames. */
+    if (next_elem == s_elem) {
+      continue;
+    }
+    s_elem = next_elem;
+
+    if (ImBuf *ibuf = source_image_cache_get(context, strip, frame)) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+
+    char filepath[FILE_MAX];
+    BLI_path_join(filepath, sizeof(filepath), strip->data->dirpath, next_elem->filename);
+    BLI_path_abs(filepath, ID_BLEND_PATH_FROM_GLOBAL(&context->scene->id));
+    IMB_prefetch_image_from_filepath(filepath, flag, strip->data->colorspace_settings.name);
+  }
+}
+
 static ImBuf *seq_render_image_strip(const RenderData *context,
                                      SeqRenderState *state,
                                      Strip *strip,
@@ -988,6 +1033,10 @@ static ImBuf *seq_render_image_strip(const RenderData *context,
     }
   }
   else {
+    /* Prefetching here lets the upcoming frames load while this one is being loaded. */
+    if (context->is_playing && !context->is_prefetch_render && prefix[0] == '\0') {
+      seq_image_strip_prefetch(context, strip, s_elem, timeline_frame);
+    }
     ibuf = seq_render_image_strip_view(context, strip, filepath, prefix, ext, context->view_id);
   }
 
@@ -898,6 +898,11 @@ static void print_help(bArgs *ba, bool all)
   PRINT("  $BLENDER_CUSTOM_SPLASH     Full path to an image that replaces the splash screen.\n");
   PRINT(
       "  $BLENDER_CUSTOM_SPLASH_BANNER Full path to an image to overlay on the splash screen.\n");
+  PRINT(
+      "  $BLENDER_COMPOSITOR_TRACE  Path of a file to write a trace of the compositor to for each\n"
+      "                             rendered frame, in the Chrome trace event format.\n"
+      "                             '#' characters are replaced by the frame number,\n"
+      "                             otherwise the frame number is appended.\n");
 
   if (defs.with_opencolorio) {
     PRINT(
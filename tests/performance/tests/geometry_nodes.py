@@ -4,11 +4,163 @@
 
 import api
 
+# Magic debug value that makes geometry nodes log socket values in all compute contexts, which is
+# the worst case for the logging overhead. By default no socket values are logged in background mode.
+DEBUG_VALUE_LOG_ALL_SOCKET_VALUES = 4002
+
+
+def _create_repeat_zone_scene(iterations):
+    import bpy
+
+    tree = bpy.data.node_groups.new("Repeat Zone Benchmark", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+
+    nodes = tree.nodes
+    links = tree.links
+    group_output = nodes.new('NodeGroupOutput')
+    grid = nodes.new('GeometryNodeMeshGrid')
+    grid.inputs["Vertices X"].default_value = 100
+    grid.inputs["Vertices Y"].default_value = 100
+
+    repeat_input = nodes.new('GeometryNodeRepeatInput')
+    repeat_output = nodes.new('GeometryNodeRepeatOutput')
+    repeat_input.pair_with_output(repeat_output)
+    repeat_input.inputs["Iterations"].default_value = iterations
+
+    # A few cheap nodes per iteration, so that the per-node overhead dominates.
+    set_position = nodes.new('GeometryNodeSetPosition')
+    noise = nodes.new('ShaderNodeTexNoise')
+    scale = nodes.new('ShaderNodeVectorMath')
+    scale.operation = 'SCALE'
+    scale.inputs["Scale"].default_value = 0.001
+
+    links.new(grid.outputs["Mesh"], repeat_input.inputs["Geometry"])
+    links.new(repeat_input.outputs["Geometry"], set_position.inputs["Geometry"])
+    links.new(noise.outputs["Color"], scale.inputs[0])
+    links.new(scale.outputs["Vector"], set_position.inputs["Offset"])
+    links.new(set_position.outputs["Geometry"], repeat_output.inputs["Geometry"])
+    links.new(repeat_output.outputs["Geometry"], group_output.inputs["Geometry"])
+
+    _add_object_with_node_group(tree)
+
+
+def _create_repeat_zone_join_scene(iterations):
+    """
+    Repeat zone where most of the work in an iteration does not depend on the previous iteration,
+    and only the result is joined with the geometry of the previous iteration.
+    """
+    import bpy
+
+    tree = bpy.data.node_groups.new("Repeat Zone Join Benchmark", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+
+    nodes = tree.nodes
+    links = tree.links
+    group_output = nodes.new('NodeGroupOutput')
+
+    repeat_input = nodes.new('GeometryNodeRepeatInput')
+    repeat_output = nodes.new('GeometryNodeRepeatOutput')
+    repeat_input.pair_with_output(repeat_output)
+    repeat_input.inputs["Iterations"].default_value = iterations
+
+    sphere = nodes.new('GeometryNodeMeshUVSphere')
+    sphere.inputs["Segments"].default_value = 64
+    sphere.inputs["Rings"].default_value = 32
+    subdivide = nodes.new('GeometryNodeSubdivideMesh')
+    subdivide.inputs["Level"].default_value = 2
+    transform = nodes.new('GeometryNodeTransform')
+    combine = nodes.new('ShaderNodeCombineXYZ')
+    join = nodes.new('GeometryNodeJoinGeometry')
+
+    links.new(sphere.outputs["Mesh"], subdivide.inputs["Mesh"])
+    links.new(subdivide.outputs["Mesh"], transform.inputs["Geometry"])
+    links.new(repeat_input.outputs["Iteration"], combine.inputs["X"])
+    links.new(combine.outputs["Vector"], transform.inputs["Translation"])
+    links.new(repeat_input.outputs["Geometry"], join.inputs["Geometry"])
+    links.new(transform.outputs["Geometry"], join.inputs["Geometry"])
+    links.new(join.outputs["Geometry"], repeat_output.inputs["Geometry"])
+    links.new(repeat_output.outputs["Geometry"], group_output.inputs["Geometry"])
+
+    _add_object_with_node_group(tree)
+
+
+def _create_subdivision_surface_scene(use_modifier):
+    """
+    Deformed mesh subdivided either with the Subdivision Surface node or with the Subdivision
+    Surface modifier, to compare the cost of re-evaluating the subdivision when only positions change.
+    """
+    import bpy
+
+    tree = bpy.data.node_groups.new("Subdivision Surface Benchmark", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+
+    nodes = tree.nodes
+    links = tree.links
+    group_output = nodes.new('NodeGroupOutput')
+
+    sphere = nodes.new('GeometryNodeMeshUVSphere')
+    sphere.inputs["Segments"].default_value = 256
+    sphere.inputs["Rings"].default_value = 128
+    set_position = nodes.new('GeometryNodeSetPosition')
+    noise = nodes.new('ShaderNodeTexNoise')
+    scale = nodes.new('ShaderNodeVectorMath')
+    scale.operation = 'SCALE'
+    scale.inputs["Scale"].default_value = 0.1
+
+    links.new(sphere.outputs["Mesh"], set_position.inputs["Geometry"])
+    links.new(noise.outputs["Color"], scale.inputs[0])
+    links.new(scale.outputs["Vector"], set_position.inputs["Offset"])
+
+    if use_modifier:
+        links.new(set_position.outputs["Geometry"], group_output.inputs["Geometry"])
+    else:
+        subdivide = nodes.new('GeometryNodeSubdivisionSurface')
+        subdivide.inputs["Level"].default_value = 2
+        links.new(set_position.outputs["Geometry"], subdivide.inputs["Mesh"])
+        links.new(subdivide.outputs["Mesh"], group_output.inputs["Geometry"])
+
+    ob = _add_object_with_node_group(tree)
+
+    if use_modifier:
+        subsurf = ob.modifiers.new("Subdivision", 'SUBSURF')
+        subsurf.levels = 2
+        # The modifier delays subdivision to the draw code when it is last in the stack, add a
+        # pass-through modifier after it so that the subdivided mesh is always computed.
+        passthrough = bpy.data.node_groups.new("Pass Through", 'GeometryNodeTree')
+        passthrough.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+        passthrough.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+        passthrough_input = passthrough.nodes.new('NodeGroupInput')
+        passthrough_output = passthrough.nodes.new('NodeGroupOutput')
+        passthrough.links.new(passthrough_input.outputs[0], passthrough_output.inputs[0])
+        modifier = ob.modifiers.new(passthrough.name, 'NODES')
+        modifier.node_group = passthrough
+
+
+def _add_object_with_node_group(tree):
+    import bpy
+
+    mesh = bpy.data.meshes.new(tree.name)
+    ob = bpy.data.objects.new(tree.name, mesh)
+    bpy.context.scene.collection.objects.link(ob)
+    modifier = ob.modifiers.new(tree.name, 'NODES')
+    modifier.node_group = tree
+    return ob
+
 
 def _run(args):
     import bpy
     import time
 
+    bpy.app.debug_value = args['debug_value']
+
+    if 'repeat_zone_iterations' in args:
+        _create_repeat_zone_scene(args['repeat_zone_iterations'])
+    if 'repeat_zone_join_iterations' in args:
+        _create_repeat_zone_join_scene(args['repeat_zone_join_iterations'])
+    if 'subdivision_surface_use_modifier' in args:
+        _create_subdivision_surface_scene(args['subdivision_surface_use_modifier'])
+
     # Evaluate objects once first, to avoid any possible lazy evaluation later.
     bpy.context.view_layer.update()
 
@@ -53,13 +205,108 @@ class GeometryNodesTest(api.Test):
         return "geometry_nodes"
 
     def run(self, env, device_id, gpu_backend):
-        args = {}
+        args = {'debug_value': 0}
 
         result, _ = env.run_in_blender(_run, args, [self.filepath])
 
         return result
 
 
+class GeometryNodesRepeatZoneTest(api.Test):
+    """
+    Procedurally generated tree with a repeat zone with many iterations, used to measure the
+    overhead of logging in geometry nodes.
+    """
+
+    def __init__(self, iterations, log_all_socket_values):
+        self.iterations = iterations
+        self.log_all_socket_values = log_all_socket_values
+
+    def name(self):
+        name = f"repeat_zone_{self.iterations}"
+        if self.log_all_socket_values:
+            return f"{name} (logging)"
+        return name
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id, gpu_backend):
+        args = {
+            'debug_value': DEBUG_VALUE_LOG_ALL_SOCKET_VALUES if self.log_all_socket_values else 0,
+            'repeat_zone_iterations': self.iterations,
+        }
+
+        result, _ = env.run_in_blender(_run, args, ["--factory-startup"])
+
+        return result
+
+
+class GeometryNodesRepeatZoneScalingTest(api.Test):
+    """
+    Repeat zone with mostly independent iterations, evaluated with different numbers of threads to
+    measure how well the iterations are evaluated in parallel.
+    """
+
+    def __init__(self, iterations, threads):
+        self.iterations = iterations
+        self.threads = threads
+
+    def name(self):
+        threads = f"{self.threads} threads" if self.threads else "all threads"
+        return f"repeat_zone_join_{self.iterations} ({threads})"
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id, gpu_backend):
+        args = {
+            'debug_value': 0,
+            'repeat_zone_join_iterations': self.iterations,
+        }
+
+        result, _ = env.run_in_blender(
+            _run, args, ["--factory-startup", "--threads", str(self.threads)])
+
+        return result
+
+
+class GeometryNodesSubdivisionSurfaceTest(api.Test):
+    """
+    Repeated evaluation of a deformed mesh with unchanged topology, subdivided with the node or
+    with the modifier.
+    """
+
+    def __init__(self, use_modifier):
+        self.use_modifier = use_modifier
+
+    def name(self):
+        if self.use_modifier:
+            return "subdivision_surface (modifier)"
+        return "subdivision_surface (node)"
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id, gpu_backend):
+        args = {
+            'debug_value': 0,
+            'subdivision_surface_use_modifier': self.use_modifier,
+        }
+
+        result, _ = env.run_in_blender(_run, args, ["--factory-startup"])
+
+        return result
+
+
 def generate(env):
     filepaths = env.find_blend_files('geometry_nodes/*')
-    return [GeometryNodesTest(filepath) for filepath in filepaths]
+    tests = [GeometryNodesTest(filepath) for filepath in filepaths]
+    # The logging overhead is only compared on the generated repeat zone trees, where the per-node
+    # overhead dominates, to keep the number of tests small.
+    tests += [GeometryNodesRepeatZoneTest(iterations, log_all_socket_values)
+              for iterations in (100, 1000)
+              for log_all_socket_values in (False, True)]
+    tests += [GeometryNodesRepeatZoneScalingTest(100, threads) for threads in (1, 2, 4, 8, 0)]
+    tests += [GeometryNodesSubdivisionSurfaceTest(use_modifier) for use_modifier in (False, True)]
+    return tests
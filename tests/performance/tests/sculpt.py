@@ -40,7 +40,7 @@ def set_view3d_context_override(context_override):
                 context_override["region"] = region
 
 
-def prepare_sculpt_scene(context: any, mode: SculptMode, subdivision_level=3):
+def prepare_sculpt_scene(context: any, mode: SculptMode, subdivision_level=3, size=None):
     """
     Prepare a clean state of the scene suitable for benchmarking
 
@@ -49,7 +49,7 @@ def prepare_sculpt_scene(context: any, mode: SculptMode, subdivision_level=3):
     For dyntopo & normal mesh sculpting, we create a grid with 2.2M vertices.
     For multires sculpting, we create a grid with 22k vertices - with a multires
     modifier set to level 3, this results in an equivalent number of 2.2M vertices
-    inside sculpt mode.
+    inside sculpt mode. The size overrides the number of vertices along each side of the grid.
     """
     import bpy
 
@@ -67,14 +67,15 @@ def prepare_sculpt_scene(context: any, mode: SculptMode, subdivision_level=3):
     group.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
     group_output_node = group.nodes.new('NodeGroupOutput')
 
-    if mode == SculptMode.MESH:
-        size = 1500
-    elif mode == SculptMode.MULTIRES:
-        size = 150
-    elif mode == SculptMode.DYNTOPO:
-        size = 500
-    else:
-        raise NotImplementedError
+    if size is None:
+        if mode == SculptMode.MESH:
+            size = 1500
+        elif mode == SculptMode.MULTIRES:
+            size = 150
+        elif mode == SculptMode.DYNTOPO:
+            size = 500
+        else:
+            raise NotImplementedError
 
     grid_node = group.nodes.new('GeometryNodeMeshGrid')
     grid_node.inputs["Size X"].default_value = 2.0
@@ -114,11 +115,11 @@ def prepare_brush(context: any, brush_type: BrushType):
     context.tool_settings.sculpt.brush.strength = 0.1
 
 
-def generate_stroke(context):
+def generate_stroke(context, num_steps=100, num_passes=1):
     """
     Generate stroke for the bpy.ops.sculpt.brush_stroke operator
 
-    The generated stroke coves the full plane diagonal.
+    The generated stroke coves the full plane diagonal, going back and forth for multiple passes.
     """
     import bpy
     from mathutils import Vector
@@ -140,16 +141,17 @@ def generate_stroke(context):
     if version[0] <= 4 and version[1] <= 3:
         template["pen_flip"] = False
 
-    num_steps = 100
     start = Vector((context['area'].width, context['area'].height))
     end = Vector((0, 0))
-    delta = (end - start) / (num_steps - 1)
 
     stroke = []
-    for i in range(num_steps):
-        step = template.copy()
-        step["mouse_event"] = start + delta * i
-        stroke.append(step)
+    for stroke_pass in range(num_passes):
+        pass_start, pass_end = (start, end) if stroke_pass % 2 == 0 else (end, start)
+        delta = (pass_end - pass_start) / (num_steps - 1)
+        for i in range(num_steps):
+            step = template.copy()
+            step["mouse_event"] = pass_start + delta * i
+            stroke.append(step)
 
     return stroke
 
@@ -191,6 +193,35 @@ def _run_brush_test(args: dict):
     return {'time': sum(measurements) / len(measurements), 'memory': memory_info}
 
 
+def _run_dyntopo_long_stroke_test(args: dict):
+    import bpy
+    import time
+    context = bpy.context
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    prepare_brush(context, BrushType.DRAW)
+
+    # A single long stroke is slow enough on dense meshes, measure a fixed number of strokes.
+    measurements = []
+    for _ in range(3):
+        prepare_sculpt_scene(context, SculptMode.DYNTOPO, size=args['size'])
+        sculpt = context.tool_settings.sculpt
+        sculpt.detail_type_method = 'CONSTANT'
+        sculpt.constant_detail_resolution = args['detail_resolution']
+        context_override = context.copy()
+        set_view3d_context_override(context_override)
+        with context.temp_override(**context_override):
+            start = time.time()
+            bpy.ops.sculpt.brush_stroke(
+                stroke=generate_stroke(context_override, num_steps=200, num_passes=4),
+                override_location=True)
+            measurements.append(time.time() - start)
+
+    return {'time': sum(measurements) / len(measurements)}
+
+
 def _run_bvh_test(args: dict):
     import bpy
     import time
@@ -225,7 +256,7 @@ def _run_bvh_test(args: dict):
     return sum(measurements) / len(measurements)
 
 
-def _run_subdivide_test(_args: dict):
+def _run_subdivide_test(args: dict):
     import bpy
     import time
     context = bpy.context
@@ -242,6 +273,7 @@ def _run_subdivide_test(_args: dict):
     measurements = []
     while True:
         prepare_sculpt_scene(context, SculptMode.MULTIRES, subdivision_level=2)
+        context.object.modifiers["Multires"].use_half_precision_reshape = args['use_half_precision']
         context_override = context.copy()
         set_view3d_context_override(context_override)
         with context.temp_override(**context_override):
@@ -305,6 +337,33 @@ class SculptBrushAfterSpatialReorderingTest(api.Test):
         return result
 
 
+class SculptDyntopoLongStrokeTest(api.Test):
+    """
+    Long dynamic topology strokes on meshes of increasing density, which subdivide and collapse
+    edges along the whole stroke. The remeshing cost grows with the number of faces under the brush.
+    """
+
+    def __init__(self, filepath: pathlib.Path, size: int):
+        self.filepath = filepath
+        self.size = size
+
+    def name(self):
+        return "dyntopo_long_stroke_{}k_vertices".format(self.size * self.size // 1000)
+
+    def category(self):
+        return "sculpt"
+
+    def run(self, env, _device_id, _gpu_backend):
+        args = {
+            'size': self.size,
+            'detail_resolution': 300.0,
+        }
+
+        result, _ = env.run_in_blender(_run_dyntopo_long_stroke_test, args, [self.filepath])
+
+        return result
+
+
 class SculptRebuildBVHTest(api.Test):
     def __init__(self, filepath: pathlib.Path, mode: SculptMode):
         self.filepath = filepath
@@ -350,17 +409,24 @@ class SculptRebuildSpatialBVHTest(api.Test):
 
 
 class SculptMultiresSubdivideTest(api.Test):
-    def __init__(self, filepath: pathlib.Path):
+    def __init__(self, filepath: pathlib.Path, use_half_precision=False):
         self.filepath = filepath
+        self.use_half_precision = use_half_precision
 
     def name(self):
+        if self.use_half_precision:
+            return "multires_subdivide_2_to_3_half_precision"
         return "multires_subdivide_2_to_3"
 
     def category(self):
         return "sculpt"
 
     def run(self, env, _device_id, _gpu_backend):
-        result, _ = env.run_in_blender(_run_subdivide_test, {}, [self.filepath])
+        args = {
+            'use_half_precision': self.use_half_precision,
+        }
+
+        result, _ = env.run_in_blender(_run_subdivide_test, args, [self.filepath])
 
         return {'time': result}
 
@@ -376,7 +442,10 @@ def generate(env):
             filepaths[0],
             SculptMode.MESH,
             brush_type)for brush_type in BrushType]
+    dyntopo_long_stroke_tests = [SculptDyntopoLongStrokeTest(filepaths[0], size) for size in (500, 1000, 1500)]
     bvh_tests = [SculptRebuildBVHTest(filepaths[0], mode) for mode in SculptMode]
     spatial_bvh_tests = [SculptRebuildSpatialBVHTest(filepaths[0], SculptMode.MESH)]
-    subdivision_tests = [SculptMultiresSubdivideTest(filepaths[0])]
-    return brush_tests + brush_tests_after_reordering + bvh_tests + spatial_bvh_tests + subdivision_tests
+    subdivision_tests = [SculptMultiresSubdivideTest(filepaths[0], use_half_precision)
+                         for use_half_precision in (False, True)]
+    return (brush_tests + brush_tests_after_reordering + dyntopo_long_stroke_tests + bvh_tests + spatial_bvh_tests +
+            subdivision_tests)
@@ -0,0 +1,119 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    scene.render.resolution_x = 3840
+    scene.render.resolution_y = 2160
+    scene.render.resolution_percentage = 100
+    scene.render.use_sequencer = True
+
+    editing = scene.sequence_editor_create()
+    # Measure the effects themselves rather than the caches.
+    editing.use_cache_raw = False
+    editing.use_cache_final = False
+    editing.use_prefetch = False
+
+    length = 100
+    colors = ((0.8, 0.3, 0.1), (0.1, 0.4, 0.9), (0.2, 0.9, 0.3), (0.9, 0.9, 0.2))
+
+    def add_color_strip(channel):
+        strip = editing.strips.new_effect(f"Color {channel}", 'COLOR', channel, 1, length=length)
+        strip.color = colors[channel % len(colors)]
+        strip.use_float = args['use_float']
+        return strip
+
+    if args['effect']:
+        input1 = add_color_strip(1)
+        input2 = add_color_strip(2)
+        editing.strips.new_effect(
+            "Effect", args['effect'], 3, 1, length=length, input1=input1, input2=input2)
+    else:
+        # A stack of strips blended on top of each other with partial opacity.
+        for channel in range(1, args['stack_size'] + 1):
+            strip = add_color_strip(channel)
+            if channel > 1:
+                strip.blend_type = args['blend_type']
+                strip.blend_alpha = 0.5
+
+    test_time_start = time.time()
+    measured_times = []
+
+    min_measurements = 5
+    max_measurements = 100
+    timeout = 10
+
+    while True:
+        # Alternate between frames in the middle of the strips, so that cross fades do not early out
+        # and nothing is reused from the previous frame.
+        scene.frame_set(40 + len(measured_times) % 20)
+
+        start_time = time.time()
+        bpy.ops.render.render()
+        elapsed_time = time.time() - start_time
+        measured_times.append(elapsed_time)
+
+        if len(measured_times) >= min_measurements and test_time_start + timeout < time.time():
+            break
+        if len(measured_times) >= max_measurements:
+            break
+
+    average_time = sum(measured_times) / len(measured_times)
+    result = {'time': average_time}
+    return result
+
+
+class SequencerTest(api.Test):
+    def __init__(self, name, use_float, effect=None, blend_type=None, stack_size=10):
+        self.name_ = name
+        self.args = {
+            'use_float': use_float,
+            'effect': effect,
+            'blend_type': blend_type,
+            'stack_size': stack_size,
+        }
+
+    def name(self):
+        return f"{self.name_} ({'Float' if self.args['use_float'] else 'Byte'})"
+
+    def category(self):
+        return "sequencer"
+
+    def run(self, env, device_id, gpu_backend):
+        result, _ = env.run_in_blender(_run, self.args, ["--factory-startup"])
+        return result
+
+
+def generate(env):
+    effects = (
+        ('Cross', 'CROSS'),
+        ('Gamma Cross', 'GAMMA_CROSS'),
+        ('Add', 'ADD'),
+        ('Subtract', 'SUBTRACT'),
+        ('Multiply', 'MULTIPLY'),
+        ('Alpha Over', 'ALPHA_OVER'),
+        ('Alpha Under', 'ALPHA_UNDER'),
+    )
+    blend_types = (
+        ('Alpha Over', 'ALPHA_OVER'),
+        ('Add', 'ADD'),
+        ('Multiply', 'MULTIPLY'),
+        ('Overlay', 'OVERLAY'),
+        ('Screen', 'SCREEN'),
+        ('Hue', 'HUE'),
+    )
+
+    tests = []
+    for use_float in (False, True):
+        for name, effect in effects:
+            tests.append(SequencerTest(f"{name} Effect", use_float, effect=effect))
+        for name, blend_type in blend_types:
+            tests.append(SequencerTest(f"{name} Blend Stack", use_float, blend_type=blend_type))
+    return tests